@@ -27,7 +27,9 @@
 #include <AliLog.h>
 #include "AliCFGridSparse.h"
 #include "AliCFContainer.h"
+#include "AliCFEffGrid.h"
 #include "TAxis.h"
+#include "TObjArray.h"
 //____________________________________________________________________
 ClassImp(AliCFContainer)
 
@@ -123,6 +125,31 @@ void AliCFContainer::Fill(const Double_t *var, Int_t istep, Double_t weight)
   fGrid[istep]->Fill(var,weight);
 }
 
+//____________________________________________________________________
+void AliCFContainer::FillN(Int_t nEntries, const Double_t *var, Int_t istep, const Double_t *weights)
+{
+  //
+  // Fills the grid at selection step istep with nEntries entries,
+  // var holds the GetNVar() input variables of each entry one after the other,
+  // weights the weight of each entry (w=1 for all if not given)
+  //
+  if(istep >= fNStep || istep < 0){
+    AliError("Non-existent selection step, grid was not filled");
+    return;
+  }
+  fGrid[istep]->FillN(nEntries,var,weights);
+}
+
+//____________________________________________________________________
+void AliCFContainer::SetFillCache(Bool_t cache)
+{
+  //
+  // Enable/disable the fill cache of the grids of all the steps
+  // (refused for the grids with SumW2(), see AliCFGridSparse)
+  //
+  for (Int_t istep=0; istep<fNStep; istep++) fGrid[istep]->SetFillCache(cache);
+}
+
 //____________________________________________________________________
 TH1* AliCFContainer::Project(Int_t istep, Int_t ivar1, Int_t ivar2, Int_t ivar3) const
 {
@@ -137,6 +164,96 @@ TH1* AliCFContainer::Project(Int_t istep, Int_t ivar1, Int_t ivar2, Int_t ivar3)
   return fGrid[istep]->Project(ivar1,ivar2,ivar3);
 }
 
+//____________________________________________________________________
+TObjArray* AliCFContainer::ProjectBatch(Int_t nProj, const Int_t* steps, const Int_t* vars1, const Int_t* vars2, const Int_t* vars3, Int_t nThreads) const
+{
+  //
+  // returns the projections along variables vars1[i] (and vars2[i] (and vars3[i]))
+  // at selection steps steps[i], i<nProj, same as Project(steps[i],vars1[i],vars2[i],vars3[i]).
+  // All the projections of a step are made with one pass over its grid.
+  // The histograms are owned by the caller.
+  //
+  TObjArray* projections = new TObjArray(nProj);
+  std::vector<Int_t> index, var1, var2, var3;
+  for (Int_t istep=0; istep<fNStep; istep++) {
+    index.clear(); var1.clear(); var2.clear(); var3.clear();
+    for (Int_t iProj=0; iProj<nProj; iProj++) {
+      if (steps[iProj] != istep) continue;
+      index.push_back(iProj);
+      var1.push_back(vars1[iProj]);
+      var2.push_back(vars2 ? vars2[iProj] : -1);
+      var3.push_back(vars3 ? vars3[iProj] : -1);
+    }
+    if (index.empty()) continue;
+    TObjArray* stepProjections = fGrid[istep]->ProjectBatch(index.size(),&var1[0],&var2[0],&var3[0],nThreads);
+    for (UInt_t i=0; i<index.size(); i++) projections->AddAt(stepProjections->At(i),index[i]);
+    delete stepProjections;
+  }
+  for (Int_t iProj=0; iProj<nProj; iProj++) {
+    if (steps[iProj] >= fNStep || steps[iProj] < 0) AliError(Form("Non-existent selection step %d, projection %d is NULL",steps[iProj],iProj));
+  }
+  return projections;
+}
+
+//____________________________________________________________________
+TObjArray* AliCFContainer::ProjectEfficiencyBatch(Int_t nProj, const Int_t* stepsNum, const Int_t* stepsDen,
+						  const Int_t* vars1, const Int_t* vars2, const Int_t* vars3, Int_t nThreads) const
+{
+  //
+  // returns the efficiencies stepsNum[i]/stepsDen[i] projected along variables vars1[i]
+  // (and vars2[i] (and vars3[i])), i<nProj. The histograms are the same as the ones of
+  // AliCFEffGrid::Project() after AliCFEffGrid::CalculateEfficiency(stepsNum[i],stepsDen[i]),
+  // but the efficiency is not computed on the full grid and the projections of
+  // each step are made with one pass over its grid.
+  // The histograms are owned by the caller.
+  //
+  TObjArray* efficiencies = new TObjArray(nProj);
+  std::vector<Int_t> nVars(nProj), vars(3*nProj);
+  for (Int_t iProj=0; iProj<nProj; iProj++) {
+    if (stepsNum[iProj] >= fNStep || stepsNum[iProj] < 0 || stepsDen[iProj] >= fNStep || stepsDen[iProj] < 0) {
+      AliError(Form("Non-existent selection step, efficiency %d is NULL",iProj));
+      continue;
+    }
+    Int_t ivar2 = vars2 ? vars2[iProj] : -1;
+    Int_t ivar3 = vars3 ? vars3[iProj] : -1;
+    nVars[iProj]     = ivar3<0 ? (ivar2<0 ? 1 : 2) : 3;
+    vars[3*iProj]    = vars1[iProj];
+    vars[3*iProj+1]  = ivar2;
+    vars[3*iProj+2]  = ivar3;
+    // as in AliCFEffGrid::CalculateEfficiency()
+    fGrid[stepsNum[iProj]]->SumW2();
+    fGrid[stepsDen[iProj]]->SumW2();
+  }
+
+  // projections of numerators and denominators, per step
+  std::vector<TObject*> num(nProj,(TObject*)0x0), den(nProj,(TObject*)0x0);
+  std::vector<Int_t> index, stepNVars, stepVars;
+  for (Int_t istep=0; istep<fNStep; istep++) {
+    index.clear(); stepNVars.clear(); stepVars.clear();
+    for (Int_t iProj=0; iProj<2*nProj; iProj++) {
+      Int_t jProj = iProj/2;
+      if ((iProj%2 ? stepsDen[jProj] : stepsNum[jProj]) != istep || !nVars[jProj]) continue;
+      index.push_back(iProj);
+      stepNVars.push_back(nVars[jProj]);
+      for (Int_t iVar=0; iVar<3; iVar++) stepVars.push_back(vars[3*jProj+iVar]);
+    }
+    if (index.empty()) continue;
+    TObjArray* projections = fGrid[istep]->ProjectSparseBatch(index.size(),&stepNVars[0],&stepVars[0],nThreads);
+    for (UInt_t i=0; i<index.size(); i++) {
+      if (index[i]%2) den[index[i]/2] = projections->At(i);
+      else            num[index[i]/2] = projections->At(i);
+    }
+    delete projections;
+  }
+
+  for (Int_t iProj=0; iProj<nProj; iProj++) {
+    if (num[iProj] && den[iProj]) efficiencies->AddAt(AliCFEffGrid::ProjectRatio((THnSparse*)num[iProj],(THnSparse*)den[iProj],nVars[iProj]),iProj);
+    delete num[iProj];
+    delete den[iProj];
+  }
+  return efficiencies;
+}
+
 //____________________________________________________________________
 AliCFContainer* AliCFContainer::MakeSlice(Int_t nVars, const Int_t* vars, const Double_t* varMin, const Double_t* varMax, Bool_t useBins) const
 {
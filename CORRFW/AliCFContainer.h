@@ -62,6 +62,8 @@ class AliCFContainer : public AliCFFrame
   virtual Int_t GetNStep() const {return fNStep;};
   virtual void  SetNStep(Int_t nStep) {fNStep=nStep;}
   virtual void  Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void  FillN(Int_t nEntries, const Double_t *var, Int_t istep, const Double_t *weights=0x0) ;
+  virtual void  SetFillCache(Bool_t cache=kTRUE) ; // fill cache for all the steps, see AliCFGridSparse
 
   virtual Float_t  GetOverFlows (Int_t var,Int_t istep,Bool_t excl=kFALSE) const;
   virtual Float_t  GetUnderFlows(Int_t var,Int_t istep,Bool_t excl=kFALSE) const ;
@@ -74,6 +76,12 @@ class AliCFContainer : public AliCFFrame
   virtual Long64_t Merge(TCollection* list);
 
   virtual TH1* Project (Int_t istep, Int_t ivar1, Int_t ivar2=-1 ,Int_t ivar3=-1) const;
+  // batch projections, one pass over the grid of each step (see AliCFGridSparse::ProjectBatch)
+  virtual TObjArray* ProjectBatch(Int_t nProj, const Int_t* steps, const Int_t* vars1, const Int_t* vars2=0x0, const Int_t* vars3=0x0,
+				  Int_t nThreads=0) const; // same as Project(steps[i],vars1[i],vars2[i],vars3[i])
+  virtual TObjArray* ProjectEfficiencyBatch(Int_t nProj, const Int_t* stepsNum, const Int_t* stepsDen,
+					    const Int_t* vars1, const Int_t* vars2=0x0, const Int_t* vars3=0x0,
+					    Int_t nThreads=0) const; // same as AliCFEffGrid::Project() for steps stepsNum[i]/stepsDen[i]
   virtual AliCFContainer* MakeSlice(Int_t nVars, const Int_t* vars, const Double_t* varMin=0x0, const Double_t* varMax=0x0, Bool_t useBins=0) const ;
   virtual AliCFContainer* MakeSlice(Int_t nStep, const Int_t* steps, 
 				    Int_t nVars, const Int_t* vars, const Double_t* varMin=0x0, const Double_t* varMax=0x0, 
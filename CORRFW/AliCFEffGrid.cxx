@@ -31,6 +31,7 @@
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TH3D.h"
+#include "TObjArray.h"
 
 //____________________________________________________________________
 ClassImp(AliCFEffGrid)
@@ -168,37 +169,57 @@ TH1* AliCFEffGrid::Project(Int_t ivar1, Int_t ivar2, Int_t ivar3) const
   }
   const Int_t nDim = 3 ;
   Int_t dim[nDim] = {ivar1,ivar2,ivar3} ;
-  
-  THnSparse *hNum, *hDen, *ratio;
-  TH1* h ;
+  Int_t nVars = ivar3<0 ? (ivar2<0 ? nDim-2 : nDim-1) : nDim ;
+
+  THnSparse* hNum = ((AliCFGridSparse*)GetNum())->GetGrid()->Projection(nVars,dim);
+  THnSparse* hDen = ((AliCFGridSparse*)GetDen())->GetGrid()->Projection(nVars,dim);
+  TH1* h = ProjectRatio(hNum,hDen,nVars);
 
-  if (ivar3<0) {
-    if (ivar2<0) {
-      hNum = ((AliCFGridSparse*)GetNum())->GetGrid()->Projection(nDim-2,dim);
-      hDen = ((AliCFGridSparse*)GetDen())->GetGrid()->Projection(nDim-2,dim);
-      ratio = (THnSparse*)hNum->Clone();
-      ratio->Divide(hNum,hDen,1.,1.,"B");
-      h = ratio->Projection(0);
-    }
-    else{
-      hNum = ((AliCFGridSparse*)GetNum())->GetGrid()->Projection(nDim-1,dim);
-      hDen = ((AliCFGridSparse*)GetDen())->GetGrid()->Projection(nDim-1,dim);
-      ratio = (THnSparse*)hNum->Clone();
-      ratio->Divide(hNum,hDen,1.,1.,"B");
-      h = ratio->Projection(1,0);
-    }
+  delete hNum; delete hDen;
+  return h ;
+} 
+//___________________________________________________________________
+TObjArray* AliCFEffGrid::ProjectBatch(Int_t nProj, const Int_t* vars1, const Int_t* vars2, const Int_t* vars3, Int_t nThreads) const
+{
+  //
+  // Make the projections along variables vars1[i] (and vars2[i] (and vars3[i])), i<nProj,
+  // same as Project(vars1[i],vars2[i],vars3[i]), with one pass over the numerator
+  // and denominator grids (see AliCFContainer::ProjectEfficiencyBatch)
+  //
+
+  if (fSelNum<0 || fSelDen<0) {
+    AliError("You must call CalculateEfficiency() first !");
+    return 0x0;
   }
-  else {
-    hNum = ((AliCFGridSparse*)GetNum())->GetGrid()->Projection(nDim,dim);
-    hDen = ((AliCFGridSparse*)GetDen())->GetGrid()->Projection(nDim,dim);
-    ratio = (THnSparse*)hNum->Clone();
-    ratio->Divide(hNum,hDen,1.,1.,"B");
-    h = ratio->Projection(0,1,2);
+  Int_t* stepsNum = new Int_t[nProj];
+  Int_t* stepsDen = new Int_t[nProj];
+  for (Int_t iProj=0; iProj<nProj; iProj++) {
+    stepsNum[iProj] = fSelNum;
+    stepsDen[iProj] = fSelDen;
   }
+  TObjArray* projections = fContainer->ProjectEfficiencyBatch(nProj,stepsNum,stepsDen,vars1,vars2,vars3,nThreads);
+  delete [] stepsNum;
+  delete [] stepsDen;
+  return projections;
+}
+//___________________________________________________________________
+TH1* AliCFEffGrid::ProjectRatio(THnSparse* hNum, THnSparse* hDen, Int_t nVars)
+{
+  //
+  // Binomial ratio of the projections hNum and hDen (on nVars variables),
+  // returned as a histogram
+  //
+
+  THnSparse* ratio = (THnSparse*)hNum->Clone();
+  ratio->Divide(hNum,hDen,1.,1.,"B");
+  TH1* h ;
+  if      (nVars == 1) h = ratio->Projection(0);
+  else if (nVars == 2) h = ratio->Projection(1,0);
+  else                 h = ratio->Projection(0,1,2);
 
-  delete hNum; delete hDen; delete ratio;
+  delete ratio;
   return h ;
-} 
+}
 //___________________________________________________________________
 AliCFEffGrid* AliCFEffGrid::MakeSlice(Int_t nVars, const Int_t* vars, const Double_t* varMin, const Double_t* varMax, Bool_t useBins) const {
   //
@@ -30,6 +30,8 @@ class AliCFEffGrid : public AliCFGridSparse
   virtual Int_t GetSelNumStep() const {return fSelNum;};
   virtual Int_t GetSelDenStep() const {return fSelDen;};
   virtual TH1*  Project(Int_t ivar1, Int_t ivar2=-1,Int_t ivar3=-1) const;
+  virtual TObjArray* ProjectBatch(Int_t nProj, const Int_t* vars1, const Int_t* vars2=0x0, const Int_t* vars3=0x0, Int_t nThreads=0) const;
+  static  TH1*  ProjectRatio(THnSparse* hNum, THnSparse* hDen, Int_t nVars); // efficiency from numerator and denominator projections
   virtual AliCFGridSparse*  Project(Int_t, const Int_t*, const Double_t*, const Double_t*, Bool_t) const {AliWarning("should not be used"); return 0x0;}
   virtual AliCFEffGrid* MakeSlice(Int_t nVars, const Int_t* vars, const Double_t* varMin, const Double_t* varMax, Bool_t useBins=0) const;
 
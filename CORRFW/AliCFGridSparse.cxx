@@ -24,6 +24,9 @@
 //--------------------------------------------------------------------//
 //
 //
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
 #include "AliCFGridSparse.h"
 #include "THnSparse.h"
 #include "AliLog.h"
@@ -33,6 +36,8 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TAxis.h"
+#include "TBuffer.h"
+#include "TObjArray.h"
 #include "AliCFUnfolding.h"
 
 //____________________________________________________________________
@@ -42,7 +47,12 @@ ClassImp(AliCFGridSparse)
 AliCFGridSparse::AliCFGridSparse() : 
   AliCFFrame(),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fFillCache(kFALSE),
+  fCacheStrides(),
+  fCacheChunks(),
+  fCacheNChunks(0),
+  fCacheNFills(0)
 {
   // default constructor
 }
@@ -50,7 +60,12 @@ AliCFGridSparse::AliCFGridSparse() :
 AliCFGridSparse::AliCFGridSparse(const Char_t* name, const Char_t* title) : 
   AliCFFrame(name,title),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fFillCache(kFALSE),
+  fCacheStrides(),
+  fCacheChunks(),
+  fCacheNChunks(0),
+  fCacheNFills(0)
 {
   // default constructor
 }
@@ -58,7 +73,12 @@ AliCFGridSparse::AliCFGridSparse(const Char_t* name, const Char_t* title) :
 AliCFGridSparse::AliCFGridSparse(const Char_t* name, const Char_t* title, Int_t nVarIn, const Int_t * nBinIn) :  
   AliCFFrame(name,title),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fFillCache(kFALSE),
+  fCacheStrides(),
+  fCacheChunks(),
+  fCacheNChunks(0),
+  fCacheNFills(0)
 {
   //
   // main constructor
@@ -80,7 +100,12 @@ AliCFGridSparse::~AliCFGridSparse()
 AliCFGridSparse::AliCFGridSparse(const AliCFGridSparse& c) :
   AliCFFrame(c),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fFillCache(kFALSE),
+  fCacheStrides(),
+  fCacheChunks(),
+  fCacheNChunks(0),
+  fCacheNFills(0)
 {
   //
   // copy constructor
@@ -104,6 +129,7 @@ void AliCFGridSparse::SetBinLimits(Int_t ivar, Double_t min, Double_t max)
   //
   // set a uniform binning for variable ivar
   //
+  FlushFillCache();
   Int_t nBins = GetNBins(ivar);
   Double_t * array = new Double_t[nBins+1];
   for (Int_t iEdge=0; iEdge<=nBins; iEdge++) array[iEdge] = min + iEdge * (max-min)/nBins ;
@@ -117,6 +143,7 @@ void AliCFGridSparse::SetBinLimits(Int_t ivar, const Double_t *array)
   //
   // setting the arrays containing the bin limits 
   //
+  FlushFillCache();
   fData->SetBinEdges(ivar, array);
 } 
 
@@ -128,7 +155,140 @@ void AliCFGridSparse::Fill(const Double_t *var, Double_t weight)
   // given a set of values of the input variable, 
   // with weight (by default w=1)
   //
-  fData->Fill(var,weight);
+  if (fFillCache) FillCached(var,weight);
+  else fData->Fill(var,weight);
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::FillN(Int_t nEntries, const Double_t *var, const Double_t *weights)
+{
+  //
+  // Fill the grid with nEntries entries at once,
+  // var holds the GetNVar() values of each entry one after the other,
+  // weights the weight of each entry (w=1 for all if not given).
+  // With the fill cache the block is flushed before returning.
+  //
+  const Int_t nVar = GetNVar();
+  if (fFillCache) {
+    for (Int_t iEntry=0; iEntry<nEntries; iEntry++) FillCached(var+iEntry*nVar, weights ? weights[iEntry] : 1.);
+    FlushFillCache();
+  }
+  else {
+    for (Int_t iEntry=0; iEntry<nEntries; iEntry++) fData->Fill(var+iEntry*nVar, weights ? weights[iEntry] : 1.);
+  }
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::SetFillCache(Bool_t cache)
+{
+  //
+  // Enable/disable the fill cache. Meant for grids densely populated
+  // in their core region, where the THnSparse hashing dominates the
+  // filling time. The THnSparse sums of weights cannot be set from
+  // outside, so the cache is refused for grids with SumW2().
+  //
+  FlushFillCache();
+  ResetFillCache();
+  fFillCache = kFALSE;
+  if (!cache || !fData) return;
+  if (fData->GetCalculateErrors()) {
+    AliWarning("the fill cache is not available with SumW2(), filling the THnSparse directly");
+    return;
+  }
+  fCacheStrides.resize(GetNVar());
+  Double_t stride = 1.;
+  for (Int_t iVar=0; iVar<GetNVar(); iVar++) {
+    fCacheStrides[iVar] = (Long64_t)stride;
+    stride *= GetNBins(iVar)+2;
+  }
+  if (stride > (Double_t)kCacheMaxChunks * (1LL << kCacheChunkBits)) {
+    AliWarning(Form("%.3g bins are too many for the fill cache, filling the THnSparse directly",stride));
+    return;
+  }
+  fFillCache = kTRUE;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::FillCached(const Double_t *var, Double_t weight)
+{
+  //
+  // accumulate one entry in the fill cache
+  //
+  Long64_t index = 0;
+  for (Int_t iVar=0; iVar<GetNVar(); iVar++) {
+    index += fData->GetAxis(iVar)->FindBin(var[iVar]) * fCacheStrides[iVar];
+  }
+  const Long64_t chunkSize = 1LL << kCacheChunkBits;
+  const UInt_t iChunk = index >> kCacheChunkBits;
+  const Long64_t offset = index & (chunkSize-1);
+  if (iChunk >= fCacheChunks.size()) fCacheChunks.resize(iChunk+1);
+  std::vector<Double_t> &chunk = fCacheChunks[iChunk];
+  if (chunk.empty()) {
+    // bound the memory of the cache: move it to the THnSparse when too many chunks are in use
+    if (fCacheNChunks >= kCacheMaxFilledChunks) FlushFillCacheContent();
+    chunk.assign(2*chunkSize,0.);
+    fCacheNChunks++;
+  }
+  chunk[offset]           += weight;
+  chunk[chunkSize+offset] += 1.;
+  fCacheNFills++;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::FlushFillCacheContent() const
+{
+  //
+  // move the content of the fill cache to the THnSparse:
+  // one bin lookup per filled bin instead of one per entry
+  //
+  const Int_t nVar = GetNVar();
+  const Long64_t chunkSize = 1LL << kCacheChunkBits;
+  Int_t* coord = new Int_t[nVar];
+  for (UInt_t iChunk=0; iChunk<fCacheChunks.size(); iChunk++) {
+    std::vector<Double_t> &chunk = fCacheChunks[iChunk];
+    if (chunk.empty()) continue;
+    for (Long64_t offset=0; offset<chunkSize; offset++) {
+      if (chunk[chunkSize+offset] == 0.) continue;
+      Long64_t index = ((Long64_t)iChunk << kCacheChunkBits) + offset;
+      for (Int_t iVar=nVar-1; iVar>=0; iVar--) {
+	coord[iVar] = index / fCacheStrides[iVar];
+	index      -= coord[iVar] * fCacheStrides[iVar];
+      }
+      fData->AddBinContent(fData->GetBin(coord,kTRUE),chunk[offset]);
+    }
+    std::vector<Double_t>().swap(chunk); // the cache only holds memory between two flushes
+  }
+  delete [] coord;
+  fCacheNChunks = 0;
+  // without errors the THnSparse statistics are only the number of entries
+  fData->SetEntries(fData->GetEntries()+fCacheNFills);
+  fCacheNFills = 0;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::Streamer(TBuffer &R__b)
+{
+  //
+  // stream the grid, with the content of the fill cache moved to the THnSparse first
+  //
+  if (R__b.IsReading()) {
+    R__b.ReadClassBuffer(AliCFGridSparse::Class(),this);
+  }
+  else {
+    FlushFillCache();
+    R__b.WriteClassBuffer(AliCFGridSparse::Class(),this);
+  }
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::ResetFillCache()
+{
+  //
+  // drop the fill cache (without flushing it)
+  //
+  fCacheChunks.clear();
+  fCacheNChunks = 0;
+  fCacheNFills = 0;
 }
 
 //___________________________________________________________________
@@ -139,6 +299,7 @@ AliCFGridSparse* AliCFGridSparse::MakeSlice(Int_t nVars, const Int_t* vars, cons
   // axis ranges can be defined in arrays varMin, varMax
   // If useBins=true, varMin and varMax are taken as bin numbers
   //
+  FlushFillCache();
 
   // binning for new grid
   Int_t* bins = new Int_t[nVars];
@@ -191,6 +352,7 @@ Float_t AliCFGridSparse::GetEntries() const
   //
   // total entries (including overflows and underflows)
   //
+  FlushFillCache();
 
   return fData->GetEntries();
 }
@@ -201,6 +363,7 @@ Float_t AliCFGridSparse::GetElement(Long_t index) const
   //
   // Returns content of grid element index 
   //
+  FlushFillCache();
   
   return fData->GetBinContent(index);
 }
@@ -210,6 +373,7 @@ Float_t AliCFGridSparse::GetElement(const Int_t *bin) const
   //
   // Get the content in a bin corresponding to a set of bin indexes
   //
+  FlushFillCache();
   return fData->GetBinContent(bin);
 
 }  
@@ -219,6 +383,7 @@ Float_t AliCFGridSparse::GetElement(const Double_t *var) const
   //
   // Get the content in a bin corresponding to a set of input variables
   //
+  FlushFillCache();
 
   Long_t index = fData->GetBin(var,kFALSE);
   if (index<0) return 0.;
@@ -231,6 +396,7 @@ Float_t AliCFGridSparse::GetElementError(Long_t index) const
   //
   // Returns the error on the content 
   //
+  FlushFillCache();
 
   return fData->GetBinError(index);
 }
@@ -240,6 +406,7 @@ Float_t AliCFGridSparse::GetElementError(const Int_t *bin) const
  //
   // Get the error in a bin corresponding to a set of bin indexes
   //
+  FlushFillCache();
   return fData->GetBinError(bin);
 
 }  
@@ -249,6 +416,7 @@ Float_t AliCFGridSparse::GetElementError(const Double_t *var) const
   //
   // Get the error in a bin corresponding to a set of input variables
   //
+  FlushFillCache();
 
   Long_t index=fData->GetBin(var,kFALSE); //this is the THnSparse index (do not allocate new cells if content is empy)
   if (index<0) return 0.;
@@ -261,6 +429,7 @@ void AliCFGridSparse::SetElement(Long_t index, Float_t val)
   //
   // Sets grid element value
   //
+  FlushFillCache();
   Int_t* bin = new Int_t[GetNVar()];
   fData->GetBinContent(index,bin); //affects the bin coordinates
   SetElement(bin,val);
@@ -273,6 +442,7 @@ void AliCFGridSparse::SetElement(const Int_t *bin, Float_t val)
   //
   // Sets grid element of bin indeces bin to val
   //
+  FlushFillCache();
   fData->SetBinContent(bin,val);
 }
 //____________________________________________________________________
@@ -281,6 +451,7 @@ void AliCFGridSparse::SetElement(const Double_t *var, Float_t val)
   //
   // Set the content in a bin to value val corresponding to a set of input variables
   //
+  FlushFillCache();
   Long_t index=fData->GetBin(var,kTRUE); //THnSparse index: allocate the cell
   Int_t *bin = new Int_t[GetNVar()];
   fData->GetBinContent(index,bin); //trick to access the array of bins
@@ -294,6 +465,7 @@ void AliCFGridSparse::SetElementError(Long_t index, Float_t val)
   //
   // Sets grid element iel error to val (linear indexing) in AliCFFrame
   //
+  FlushFillCache();
   Int_t *bin = new Int_t[GetNVar()];
   fData->GetBinContent(index,bin);
   SetElementError(bin,val);
@@ -306,6 +478,7 @@ void AliCFGridSparse::SetElementError(const Int_t *bin, Float_t val)
   //
   // Sets grid element error of bin indeces bin to val
   //
+  FlushFillCache();
   fData->SetBinError(bin,val);
 }
 //____________________________________________________________________
@@ -314,6 +487,7 @@ void AliCFGridSparse::SetElementError(const Double_t *var, Float_t val)
   //
   // Set the error in a bin to value val corresponding to a set of input variables
   //
+  FlushFillCache();
   Long_t index=fData->GetBin(var); //THnSparse index
   Int_t *bin = new Int_t[GetNVar()];
   fData->GetBinContent(index,bin); //trick to access the array of bins
@@ -327,6 +501,10 @@ void AliCFGridSparse::SumW2()
   //
   //set calculation of the squared sum of the weighted entries
   //
+  if (fFillCache) {
+    AliWarning("SumW2() disables the fill cache");
+    SetFillCache(kFALSE);
+  }
   if(!fSumW2){
     fData->CalculateErrors(kTRUE); 
   }
@@ -339,6 +517,7 @@ void AliCFGridSparse::Add(const AliCFGridSparse* aGrid, Double_t c)
   //
   //add aGrid to the current one
   //
+  FlushFillCache();
 
   if (aGrid->GetNVar() != GetNVar()){
     AliError("Different number of variables, cannot add the grids");
@@ -355,6 +534,7 @@ void AliCFGridSparse::Add(const AliCFGridSparse* aGrid1, const AliCFGridSparse*
   //
   //Add aGrid1 and aGrid2 and deposit the result into the current one
   //
+  FlushFillCache();
 
   if (GetNVar() != aGrid1->GetNVar() || GetNVar() != aGrid2->GetNVar()) {
     AliInfo("Different number of variables, cannot add the grids");
@@ -374,6 +554,7 @@ void AliCFGridSparse::Multiply(const AliCFGridSparse* aGrid, Double_t c)
   //
   // Multiply aGrid to the current one
   //
+  FlushFillCache();
 
   if (aGrid->GetNVar() != GetNVar()) {
     AliError("Different number of variables, cannot multiply the grids");
@@ -392,6 +573,7 @@ void AliCFGridSparse::Multiply(const AliCFGridSparse* aGrid1, const AliCFGridSpa
   //
   //Multiply aGrid1 and aGrid2 and deposit the result into the current one
   //
+  FlushFillCache();
 
   if (GetNVar() != aGrid1->GetNVar() || GetNVar() != aGrid2->GetNVar()) {
     AliError("Different number of variables, cannot multiply the grids");
@@ -414,6 +596,7 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid, Double_t c)
   //
   // Divide aGrid to the current one
   //
+  FlushFillCache();
 
   if (aGrid->GetNVar() != GetNVar()) {
     AliError("Different number of variables, cannot divide the grids");
@@ -435,6 +618,7 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid1, const AliCFGridSpars
   //Divide aGrid1 and aGrid2 and deposit the result into the current one
   //binomial errors are supported
   //
+  FlushFillCache();
 
   if (GetNVar() != aGrid1->GetNVar() || GetNVar() != aGrid2->GetNVar()) {
     AliError("Different number of variables, cannot divide the grids");
@@ -457,6 +641,7 @@ void AliCFGridSparse::Rebin(const Int_t* group)
   // Please notice that the original number of bins on
   // a given axis has to be divisible by the rebin group.
   //
+  FlushFillCache();
 
   for(Int_t i=0;i<GetNVar();i++){
     if (group[i]!=1) AliInfo(Form(" merging bins along dimension %i in groups of %i bins", i,group[i]));
@@ -465,6 +650,7 @@ void AliCFGridSparse::Rebin(const Int_t* group)
   THnSparse *rebinned =fData->Rebin(group);
   fData->Reset();
   fData = rebinned;
+  if (fFillCache) SetFillCache(kTRUE); // strides of the new binning
 }
 //____________________________________________________________________
 void AliCFGridSparse::Scale(Long_t index, const Double_t *fact)
@@ -553,6 +739,7 @@ Double_t AliCFGridSparse::GetIntegral() const
   //
   // Get full Integral
   //
+  FlushFillCache();
   return fData->ComputeIntegral();  
 } 
 
@@ -603,6 +790,7 @@ void AliCFGridSparse::Copy(TObject& c) const
   //
   // copy function
   //
+  FlushFillCache();
   AliCFFrame::Copy(c);
   AliCFGridSparse& target = (AliCFGridSparse &) c;
   target.fSumW2 = fSumW2 ;
@@ -620,6 +808,7 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   // therefore varMin and varMax must have their dimensions equal to GetNVar()
   // If useBins=true, varMin and varMax are taken as bin numbers
   // if varmin or varmax point to null, all the range is taken, including over- and underflows
+  FlushFillCache();
 
   THnSparse* clone = (THnSparse*)fData->Clone();
   if (varMin != 0x0 && varMax != 0x0) {
@@ -696,6 +885,238 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   return projection ;
 }
 
+//____________________________________________________________________
+TObjArray* AliCFGridSparse::ProjectBatch(Int_t nProj, const Int_t* vars1, const Int_t* vars2, const Int_t* vars3, Int_t nThreads) const
+{
+  //
+  // returns the projections along variables vars1[i] (and vars2[i] (and vars3[i])), i<nProj,
+  // with -1 (or null arrays) for the unused variables. The histograms are the same as
+  // the ones of Project(vars1[i],vars2[i],vars3[i]), but the grid is neither cloned nor
+  // looped over for each of them: see FillProjections.
+  // The histograms are owned by the caller.
+  //
+  FlushFillCache();
+
+  TObjArray* projections = new TObjArray(nProj);
+  if (HasAxisRange()) { // the grid is restricted by SetRangeUser: the batch loop does not handle the reduced axes
+    for (Int_t iProj=0; iProj<nProj; iProj++) {
+      projections->AddAt(Project(vars1[iProj], vars2 ? vars2[iProj] : -1, vars3 ? vars3[iProj] : -1), iProj);
+    }
+    return projections;
+  }
+
+  // the histograms are booked by the usual projection code on an empty grid with the same axes,
+  // so that binning, names, titles and labels are the same
+  AliCFGridSparse shell(GetName(),GetTitle());
+  shell.SetGrid(CreateEmptyGrid());
+
+  TObject** targets = new TObject*[nProj];
+  Int_t*    vars    = new Int_t[3*nProj];
+  Int_t     nTargets = 0;
+  for (Int_t iProj=0; iProj<nProj; iProj++) {
+    vars[3*nTargets]   = vars1[iProj];
+    vars[3*nTargets+1] = vars2 ? vars2[iProj] : -1;
+    vars[3*nTargets+2] = vars3 ? vars3[iProj] : -1;
+    TH1* projection = shell.Project(vars[3*nTargets],vars[3*nTargets+1],vars[3*nTargets+2]);
+    projections->AddAt(projection,iProj);
+    if (!projection) continue;
+    targets[nTargets++] = projection; // Slice() projects with ivar1 on the x axis, as FillProjections
+  }
+  FillProjections(fData,nTargets,targets,vars,nThreads);
+
+  delete [] targets;
+  delete [] vars;
+  return projections;
+}
+
+//____________________________________________________________________
+TObjArray* AliCFGridSparse::ProjectSparseBatch(Int_t nProj, const Int_t* nVars, const Int_t* vars, Int_t nThreads) const
+{
+  //
+  // returns the n-dimensional projections of the THnSparse on the nVars[i] variables
+  // vars[3*i],...,vars[3*i+nVars[i]-1], i<nProj (at most 3 variables per projection).
+  // The THnSparse are the same as the ones of GetGrid()->Projection(nVars[i],&vars[3*i]).
+  // The projections are owned by the caller.
+  //
+  FlushFillCache();
+
+  TObjArray* projections = new TObjArray(nProj);
+  THnSparse* empty = HasAxisRange() ? 0x0 : CreateEmptyGrid();
+  TObject**  targets = new TObject*[nProj];
+  Int_t*     targetVars = new Int_t[3*nProj];
+  Int_t      nTargets = 0;
+  for (Int_t iProj=0; iProj<nProj; iProj++) {
+    if (nVars[iProj] < 1 || nVars[iProj] > 3) {
+      AliError(Form("Projection %d: only projections on 1 to 3 variables are supported",iProj));
+      continue;
+    }
+    if (!empty) {
+      projections->AddAt(fData->Projection(nVars[iProj],&vars[3*iProj]),iProj);
+      continue;
+    }
+    THnSparse* projection = empty->Projection(nVars[iProj],&vars[3*iProj]);
+    projections->AddAt(projection,iProj);
+    for (Int_t iVar=0; iVar<3; iVar++) targetVars[3*nTargets+iVar] = iVar<nVars[iProj] ? vars[3*iProj+iVar] : -1;
+    targets[nTargets++] = projection;
+  }
+  if (empty) FillProjections(fData,nTargets,targets,targetVars,nThreads);
+
+  delete empty;
+  delete [] targets;
+  delete [] targetVars;
+  return projections;
+}
+
+namespace {
+  //
+  // filled bins of the grid decoded by FillProjections
+  //
+  struct AliCFProjectionBlock {
+    Long64_t               fNBins;   // number of bins of the block
+    std::vector<Int_t>     fCoord;   // bin coordinates, nVar per bin
+    std::vector<Double_t>  fContent; // bin contents
+    std::vector<Double_t>  fError2;  // squared bin errors
+  };
+
+  //
+  // fills the targets first, first+step, ... with the bins of the block
+  // as in the loop of THnBase::ProjectionAny
+  //
+  void FillProjectionBlock(const AliCFProjectionBlock* block, Int_t nVar, Bool_t haveErrors,
+			   Int_t nTargets, TObject** targets, const Bool_t* isHist, const Int_t* vars,
+			   Int_t first, Int_t step)
+  {
+    Int_t bins[3];
+    for (Int_t iTarget=first; iTarget<nTargets; iTarget+=step) {
+      const Int_t* dim = &vars[3*iTarget];
+      Int_t ndim = dim[1]<0 ? 1 : (dim[2]<0 ? 2 : 3);
+      TH1*       hist = isHist[iTarget] ? (TH1*)targets[iTarget] : 0x0;
+      THnSparse* hn   = isHist[iTarget] ? 0x0 : (THnSparse*)targets[iTarget];
+      for (Long64_t iBin=0; iBin<block->fNBins; iBin++) {
+	const Int_t* coord = &block->fCoord[iBin*nVar];
+	Double_t v = block->fContent[iBin];
+	for (Int_t d=0; d<ndim; d++) bins[d] = coord[dim[d]];
+	Long64_t targetBin = -1;
+	if (hist) {
+	  if      (ndim == 1) targetBin = bins[0];
+	  else if (ndim == 2) targetBin = hist->GetBin(bins[0],bins[1]);
+	  else                targetBin = hist->GetBin(bins[0],bins[1],bins[2]);
+	}
+	else targetBin = hn->GetBin(bins,kTRUE);
+	if (haveErrors) {
+	  Double_t err2 = block->fError2[iBin];
+	  if (hist) {
+	    Double_t preverr = hist->GetBinError(targetBin);
+	    hist->SetBinError(targetBin,TMath::Sqrt(preverr*preverr+err2));
+	  }
+	  else hn->AddBinError2(targetBin,err2);
+	}
+	if (hist) hist->AddBinContent(targetBin,v);
+	else      hn  ->AddBinContent(targetBin,v);
+      }
+    }
+  }
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::FillProjections(const THnSparse* grid, Int_t nTargets, TObject** targets, const Int_t* vars, Int_t nThreads)
+{
+  //
+  // Fills the empty projections targets[i] (histograms or THnSparse booked as the
+  // projections of grid on variables vars[3*i], vars[3*i+1], vars[3*i+2], -1 if unused)
+  // with one pass over the filled bins of grid.
+  // The bins are decoded by blocks in the calling thread (the THnSparse coordinate
+  // decoding is not thread safe), then the targets are shared among nThreads threads.
+  // Every target is filled by a single thread, in the bin order and with the same
+  // operations as THnBase::ProjectionAny: the results are identical to grid->Projection(),
+  // provided that no axis range is set on the grid.
+  //
+  if (nTargets <= 0) return;
+  const Int_t    nVar       = grid->GetNdimensions();
+  const Long64_t nBins      = grid->GetNbins();
+  const Bool_t   haveErrors = grid->GetCalculateErrors();
+  const Long64_t kBlockSize = 1 << 16;
+
+  Bool_t* isHist = new Bool_t[nTargets];
+  for (Int_t iTarget=0; iTarget<nTargets; iTarget++) {
+    isHist[iTarget] = targets[iTarget]->InheritsFrom(TH1::Class());
+    // SetBinError() calls TH1::Sumw2() at the first bin: done here, before the threads start
+    if (isHist[iTarget] && haveErrors && nBins>0 && ((TH1*)targets[iTarget])->GetSumw2N()==0) ((TH1*)targets[iTarget])->Sumw2();
+  }
+
+#if __cplusplus >= 201103L
+  if (nThreads <= 0) nThreads = std::thread::hardware_concurrency();
+#else
+  nThreads = 1;
+#endif
+  if (nThreads > nTargets) nThreads = nTargets;
+  if (nThreads < 1) nThreads = 1;
+
+  AliCFProjectionBlock block;
+  block.fCoord  .resize(kBlockSize*nVar);
+  block.fContent.resize(kBlockSize);
+  if (haveErrors) block.fError2.resize(kBlockSize);
+
+  for (Long64_t firstBin=0; firstBin<nBins; firstBin+=kBlockSize) {
+    block.fNBins = TMath::Min(kBlockSize,nBins-firstBin);
+    for (Long64_t iBin=0; iBin<block.fNBins; iBin++) {
+      block.fContent[iBin] = grid->GetBinContent(firstBin+iBin,&block.fCoord[iBin*nVar]);
+      if (haveErrors) block.fError2[iBin] = grid->GetBinError2(firstBin+iBin);
+    }
+#if __cplusplus >= 201103L
+    std::vector<std::thread> threads;
+    for (Int_t iThread=1; iThread<nThreads; iThread++) {
+      threads.push_back(std::thread(FillProjectionBlock,&block,nVar,haveErrors,nTargets,targets,isHist,vars,iThread,nThreads));
+    }
+    FillProjectionBlock(&block,nVar,haveErrors,nTargets,targets,isHist,vars,0,nThreads);
+    for (UInt_t iThread=0; iThread<threads.size(); iThread++) threads[iThread].join();
+#else
+    FillProjectionBlock(&block,nVar,haveErrors,nTargets,targets,isHist,vars,0,1);
+#endif
+  }
+
+  for (Int_t iTarget=0; iTarget<nTargets; iTarget++) {
+    if (isHist[iTarget]) ((TH1*)      targets[iTarget])->SetEntries(grid->GetEntries());
+    else                 ((THnSparse*)targets[iTarget])->SetEntries(grid->GetEntries());
+  }
+  delete [] isHist;
+}
+
+//____________________________________________________________________
+THnSparse* AliCFGridSparse::CreateEmptyGrid() const
+{
+  //
+  // returns an empty THnSparse of the same type, with the same axes as the grid
+  //
+  THnSparse* empty = 0x0;
+  const Int_t nVar = GetNVar();
+  Int_t* nBins = GetNBins();
+  if      (fData->IsA() == THnSparseF::Class()) empty = new THnSparseF(fData->GetName(),fData->GetTitle(),nVar,nBins,0x0,0x0,fData->GetChunkSize());
+  else if (fData->IsA() == THnSparseD::Class()) empty = new THnSparseD(fData->GetName(),fData->GetTitle(),nVar,nBins,0x0,0x0,fData->GetChunkSize());
+  delete [] nBins;
+  if (!empty) { // other storage types: slower but generic
+    empty = (THnSparse*)fData->Clone();
+    empty->Reset();
+  }
+  else {
+    for (Int_t iVar=0; iVar<nVar; iVar++) *(empty->GetAxis(iVar)) = *(fData->GetAxis(iVar));
+  }
+  empty->CalculateErrors(fData->GetCalculateErrors());
+  return empty;
+}
+
+//____________________________________________________________________
+Bool_t AliCFGridSparse::HasAxisRange() const
+{
+  //
+  // true if a range is set on one of the axes (see SetRangeUser)
+  //
+  for (Int_t iVar=0; iVar<GetNVar(); iVar++) {
+    if (fData->GetAxis(iVar)->TestBit(TAxis::kAxisRange)) return kTRUE;
+  }
+  return kFALSE;
+}
+
 //____________________________________________________________________
 void AliCFGridSparse::SetAxisRange(TAxis* axis, Double_t min, Double_t max, Bool_t useBins) const {
   //
@@ -746,6 +1167,7 @@ Float_t AliCFGridSparse::GetOverFlows(Int_t ivar, Bool_t exclusive) const
   // Returns overflows in variable ivar
   // Set 'exclusive' to true for an exclusive check on variable ivar
   //
+  FlushFillCache();
   Int_t* bin = new Int_t[GetNVar()];
   memset(bin, 0, sizeof(Int_t) * GetNVar());
   Float_t ovfl=0.;
@@ -772,6 +1194,7 @@ Float_t AliCFGridSparse::GetUnderFlows(Int_t ivar, Bool_t exclusive) const
   // Returns exclusive overflows in variable ivar
   // Set 'exclusive' to true for an exclusive check on variable ivar
   //
+  FlushFillCache();
   Int_t* bin = new Int_t[GetNVar()];
   memset(bin, 0, sizeof(Int_t) * GetNVar());
   Float_t unfl=0.;
@@ -797,6 +1220,7 @@ void AliCFGridSparse::Smooth() {
   //
   // smoothing function: TO USE WITH CARE
   //
+  FlushFillCache();
 
   AliInfo("Your GridSparse is going to be smoothed");
   AliInfo(Form("N TOTAL  BINS : %li",GetNBinsTotal()));
@@ -8,6 +8,7 @@
 // Author:S.Arcelli, silvia.arcelli@cern.ch
 //--------------------------------------------------------------------//
 
+#include <vector>
 #include "AliCFFrame.h"
 #include "THnSparse.h"
 #include "AliLog.h"
@@ -16,6 +17,7 @@
 class TH1D;
 class TH2D;
 class TH3D;
+class TObjArray;
 
 class AliCFGridSparse : public AliCFFrame
 {
@@ -37,7 +39,7 @@ class AliCFGridSparse : public AliCFFrame
   virtual void       GetBinLimits(Int_t ivar, Double_t * array) const ;
   virtual Double_t * GetBinLimits(Int_t ivar) const ;
   virtual Long_t     GetNBinsTotal() const ;
-  virtual Long_t     GetNFilledBins() const {return fData->GetNbins();}
+  virtual Long_t     GetNFilledBins() const {FlushFillCache(); return fData->GetNbins();}
   virtual Int_t      GetNBins(Int_t ivar) const {return fData->GetAxis(ivar)->GetNbins();}
   virtual Int_t *    GetNBins() const ;
   virtual Float_t    GetBinCenter(Int_t ivar,Int_t ibin) const ;
@@ -56,6 +58,7 @@ class AliCFGridSparse : public AliCFFrame
   //virtual Int_t      GetBinIndex(Int_t ivar, Int_t ind) const ;
 
   virtual void    Fill(const Double_t *var, Double_t weight=1.);
+  virtual void    FillN(Int_t nEntries, const Double_t *var, const Double_t *weights=0x0);
   virtual Float_t GetEntries()const;
   virtual Float_t GetElement(Long_t iel)               const; 
   virtual Float_t GetElement(const Int_t *bin)         const; 
@@ -76,6 +79,14 @@ class AliCFGridSparse : public AliCFFrame
   virtual AliCFGridSparse* MakeSlice(Int_t nVars, const Int_t* vars,
 				   const Double_t* varMin, const Double_t* varMax, Bool_t useBins=0) const ;
 
+  // batch projections: nProj projections computed with one pass over the grid, shared among nThreads
+  // threads (0: one per core). The results are identical to the ones of the single projections
+  virtual TObjArray*       ProjectBatch(Int_t nProj, const Int_t* vars1, const Int_t* vars2=0x0, const Int_t* vars3=0x0,
+					Int_t nThreads=0) const ; // same as Project(vars1[i],vars2[i],vars3[i])
+  virtual TObjArray*       ProjectSparseBatch(Int_t nProj, const Int_t* nVars, const Int_t* vars,
+					      Int_t nThreads=0) const ; // same as GetGrid()->Projection(nVars[i],&vars[3*i])
+  static  void             FillProjections(const THnSparse* grid, Int_t nTargets, TObject** targets, const Int_t* vars, Int_t nThreads=0);
+
   virtual void             SetRangeUser(Int_t iVar, Double_t varMin, Double_t varMax, Bool_t useBins=kFALSE) const ;
   virtual void             SetRangeUser(const Double_t* varMin, const Double_t* varMax, Bool_t useBins=kFALSE) const ;
   virtual void             Smooth() ;
@@ -99,8 +110,16 @@ class AliCFGridSparse : public AliCFFrame
   //virtual Double_t GetIntegral(const Double_t *varMin, const Double_t *varMax) const;
   virtual Long64_t Merge(TCollection* list);
 
-  virtual void     SetGrid(THnSparse* grid) {if (fData) delete fData ; fData=grid;}
-  THnSparse   *    GetGrid() const {return fData;}
+  virtual void     SetGrid(THnSparse* grid) {ResetFillCache(); fFillCache=kFALSE; if (fData) delete fData ; fData=grid;}
+  THnSparse   *    GetGrid() const {FlushFillCache(); return fData;}
+
+  // fill cache, disabled by default: Fill() accumulates the entries in chunks of an array covering all
+  // the bins (allocated only where filled), which are added to the THnSparse when any content is accessed
+  // or when too many chunks are in use. Only for grids without SumW2(). FillN() never leaves entries in
+  // the cache. A THnSparse obtained with GetGrid() misses the later Fill() calls until the next access.
+  virtual void     SetFillCache(Bool_t cache=kTRUE);
+  Bool_t           GetFillCache() const {return fFillCache;}
+  void             FlushFillCache() const {if (fCacheNFills) FlushFillCacheContent();}
 
   virtual Float_t GetOverFlows (Int_t var, Bool_t excl=kFALSE) const;
   virtual Float_t GetUnderFlows(Int_t var, Bool_t excl=kFALSE) const;
@@ -118,11 +137,26 @@ class AliCFGridSparse : public AliCFFrame
   void     SetAxisRange(TAxis* axis, Double_t min, Double_t max, Bool_t useBins) const;
   void     GetProjectionName (TString& s,Int_t var0, Int_t var1=-1, Int_t var2=-1) const;
   void     GetProjectionTitle(TString& s,Int_t var0, Int_t var1=-1, Int_t var2=-1) const;
+  THnSparse* CreateEmptyGrid() const;
+  Bool_t   HasAxisRange() const;
+  void     FillCached(const Double_t *var, Double_t weight);
+  void     FlushFillCacheContent() const;
+  void     ResetFillCache();
+
+  static const Int_t kCacheChunkBits = 12;      // 4096 bins per chunk of the fill cache
+  static const Int_t kCacheMaxChunks  = 1 << 20; // largest grid (in chunks) handled by the fill cache
+  static const Int_t kCacheMaxFilledChunks = 512; // chunks in use (~32 MB) above which the fill cache is flushed
 
   // data members:
   Bool_t      fSumW2    ; // Flag to check if calculation of squared weights enabled
   THnSparse  *fData     ; // The data Container: a THnSparse  
 
+  Bool_t      fFillCache; //! Flag to fill through the fill cache
+  std::vector<Long64_t> fCacheStrides; //! Strides of the cache bin index (bins including under/overflows)
+  mutable std::vector<std::vector<Double_t> > fCacheChunks; //! Chunks of sums of weights and numbers of fills
+  mutable Int_t    fCacheNChunks; //! Number of chunks of the fill cache in use
+  mutable Long64_t fCacheNFills; //! Number of fills waiting in the fill cache
+
   ClassDef(AliCFGridSparse,3);
 };
 
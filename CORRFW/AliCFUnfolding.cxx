@@ -92,6 +92,11 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TRandom3.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
 
 
 ClassImp(AliCFUnfolding)
@@ -130,7 +135,13 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fNThreads(-1),
+  fCheckpointFile(""),
+  fCheckpointEvery(1),
+  fMaxStepsPerCall(0),
+  fNIterationsDone(0),
+  fNReplicasDone(0)
 {
   //
   // default constructor
@@ -174,7 +185,13 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fNThreads(-1),
+  fCheckpointFile(""),
+  fCheckpointEvery(1),
+  fMaxStepsPerCall(0),
+  fNIterationsDone(0),
+  fNReplicasDone(0)
 {
   //
   // named constructor
@@ -350,6 +367,11 @@ void AliCFUnfolding::Unfold() {
   // several iterations are performed until a reasonable chi2 or convergence criterion is reached
   //
 
+  if (fNThreads >= 0) {
+    UnfoldParallel();
+    return;
+  }
+
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
@@ -862,3 +884,525 @@ void AliCFUnfolding::CreateFlatPrior() {
   delete [] bin;
   delete [] bins;
 }
+
+//______________________________________________________________
+//
+// Parallel unfolding
+// ------------------
+// Enabled with SetNThreads(). The conditional matrix is turned once into flat
+// arrays (bins grouped by measured cell and by true cell) and the spectra are
+// dense arrays over the cells (including under/overflows) of the measured and
+// true spaces, so that an iteration consists of two loops over the cells:
+//   - measured cells : estimated measured spectrum and inverse response
+//   - true cells     : unfolded spectrum
+// which are shared among the threads. Every cell sums its bins in the THnSparse
+// order, the results do not depend on the number of threads.
+// The error replicas of CalculateCorrelatedErrors() are unfolded in parallel,
+// each one with its own random generator seeded from the random seed and the
+// replica index : they are reproducible and do not depend on the number of threads
+// (the values differ from the serial unfolding, which uses a single generator).
+// The computation is done in double precision, the results can differ from the
+// serial unfolding with THnSparseF at the float rounding level.
+// The smoothing uses the THnSparse and TF1 objects : with smoothing, the error
+// replicas are unfolded one after the other (the iterations are still parallel).
+//
+// The state of the unfolding (iterations and replicas done, current prior,
+// delta-unfolded profile) is streamed with the object : with SetCheckpoint()
+// the unfolder is written to a file during the unfolding, and Unfold() resumes
+// the unfolding where it stopped, giving the same result as an uninterrupted one.
+//______________________________________________________________
+
+struct AliCFUnfolding::FlatWork {
+  std::vector<Double_t> fPrior;      // prior (true cells)
+  std::vector<Char_t>   fPriorMask;  // filled cells of the prior
+  std::vector<Double_t> fUnfolded;   // unfolded (true cells)
+  std::vector<Char_t>   fUnfoldedMask; // filled cells of the unfolded
+  std::vector<Double_t> fPriorTimesEff; // prior * efficiency (true cells)
+  std::vector<Double_t> fEfficiency; // efficiency (true cells)
+  std::vector<Double_t> fMeasured;   // measured (measured cells)
+  std::vector<Double_t> fEstMeasured;// estimated measured (measured cells)
+  std::vector<Double_t> fInverse;    // inverse response (bins of the conditional matrix)
+};
+
+namespace {
+  //
+  // runs function(first,last) on nThreads consecutive ranges of [0,n)
+  //
+  template <typename F> void AliCFParallelFor(Int_t n, Int_t nThreads, F function) {
+    if (nThreads <= 1 || n < 2*nThreads) {
+      function(0,n);
+      return;
+    }
+    std::vector<std::thread> threads;
+    for (Int_t iThread=1; iThread<nThreads; iThread++) {
+      threads.push_back(std::thread(function,(Int_t)((Long64_t)n*iThread/nThreads),(Int_t)((Long64_t)n*(iThread+1)/nThreads)));
+    }
+    function(0,n/nThreads);
+    for (UInt_t iThread=0; iThread<threads.size(); iThread++) threads[iThread].join();
+  }
+
+  //
+  // groups the bins 0..n-1 by cell (stable) : start[c]..start[c+1] in bins
+  //
+  void AliCFGroupByCell(const std::vector<Int_t>& cells, Int_t nCells, std::vector<Int_t>& start, std::vector<Int_t>& bins) {
+    start.assign(nCells+1,0);
+    for (UInt_t iBin=0; iBin<cells.size(); iBin++) start[cells[iBin]+1]++;
+    for (Int_t iCell=0; iCell<nCells; iCell++) start[iCell+1] += start[iCell];
+    bins.resize(cells.size());
+    std::vector<Int_t> next(start.begin(),start.end()-1);
+    for (UInt_t iBin=0; iBin<cells.size(); iBin++) bins[next[cells[iBin]]++] = iBin;
+  }
+
+  const Long64_t kMaxFlatCells = 1 << 26; // largest measured or true space handled by the parallel unfolding
+}
+
+//______________________________________________________________
+
+Bool_t AliCFUnfolding::BuildFlatMatrices() {
+  //
+  // builds the flat form of the conditional matrix and of the inputs
+  //
+
+  if (!fCoordinates2N) { // object read from a file
+    fCoordinates2N  = new Int_t[2*fNVariables];
+    fCoordinatesN_M = new Int_t[fNVariables];
+    fCoordinatesN_T = new Int_t[fNVariables];
+  }
+
+  fFlatStrideM.resize(fNVariables);
+  fFlatStrideT.resize(fNVariables);
+  Long64_t nCellsM = 1, nCellsT = 1;
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    fFlatStrideM[iVar] = nCellsM;
+    fFlatStrideT[iVar] = nCellsT;
+    nCellsM *= fMeasured->GetAxis(iVar)->GetNbins()+2;
+    nCellsT *= fPrior   ->GetAxis(iVar)->GetNbins()+2;
+  }
+  if (nCellsM > kMaxFlatCells || nCellsT > kMaxFlatCells || fConditional->GetNbins() > kMaxInt) {
+    AliError(Form("%lld measured and %lld true cells are too many for the parallel unfolding",nCellsM,nCellsT));
+    return kFALSE;
+  }
+
+  const Int_t nBins = fConditional->GetNbins();
+  fFlatCellM.resize(nBins);
+  fFlatCellT.resize(nBins);
+  fFlatConditional.resize(nBins);
+  for (Int_t iBin=0; iBin<nBins; iBin++) {
+    fFlatConditional[iBin] = fConditional->GetBinContent(iBin,fCoordinates2N);
+    GetCoordinates();
+    Long64_t cellM = 0, cellT = 0;
+    for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+      cellM += fCoordinatesN_M[iVar]*fFlatStrideM[iVar];
+      cellT += fCoordinatesN_T[iVar]*fFlatStrideT[iVar];
+    }
+    fFlatCellM[iBin] = cellM;
+    fFlatCellT[iBin] = cellT;
+  }
+  AliCFGroupByCell(fFlatCellM,nCellsM,fFlatRowStart,fFlatRowBins);
+  AliCFGroupByCell(fFlatCellT,nCellsT,fFlatColStart,fFlatColBins);
+
+  std::vector<Char_t> mask;
+  SparseToFlat(fEfficiency,fFlatEfficiency,mask);
+  fFlatMeasured.assign(nCellsM,0.);
+  for (Long64_t iBin=0; iBin<fMeasured->GetNbins(); iBin++) {
+    Double_t value = fMeasured->GetBinContent(iBin,fCoordinatesN_M);
+    Long64_t cellM = 0;
+    for (Int_t iVar=0; iVar<fNVariables; iVar++) cellM += fCoordinatesN_M[iVar]*fFlatStrideM[iVar];
+    fFlatMeasured[cellM] = value;
+  }
+  SparseToFlat(fPriorOrig,fFlatPriorOrig,fFlatPriorOrigMask);
+
+  // original efficiency and measured spectrum, in bin order, for the error replicas
+  fFlatEffOrigCell.resize(fEfficiencyOrig->GetNbins());
+  fFlatEffOrigVal .resize(fEfficiencyOrig->GetNbins());
+  fFlatEffOrigErr .resize(fEfficiencyOrig->GetNbins());
+  for (Long64_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+    fFlatEffOrigVal[iBin] = fEfficiencyOrig->GetBinContent(iBin,fCoordinatesN_T);
+    fFlatEffOrigErr[iBin] = fEfficiencyOrig->GetBinError(fCoordinatesN_T);
+    Long64_t cellT = 0;
+    for (Int_t iVar=0; iVar<fNVariables; iVar++) cellT += fCoordinatesN_T[iVar]*fFlatStrideT[iVar];
+    fFlatEffOrigCell[iBin] = cellT;
+  }
+  fFlatMeasOrigCell.resize(fMeasuredOrig->GetNbins());
+  fFlatMeasOrigVal .resize(fMeasuredOrig->GetNbins());
+  fFlatMeasOrigErr .resize(fMeasuredOrig->GetNbins());
+  for (Long64_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+    fFlatMeasOrigVal[iBin] = fMeasuredOrig->GetBinContent(iBin,fCoordinatesN_M);
+    fFlatMeasOrigErr[iBin] = fMeasuredOrig->GetBinError(fCoordinatesN_M);
+    Long64_t cellM = 0;
+    for (Int_t iVar=0; iVar<fNVariables; iVar++) cellM += fCoordinatesN_M[iVar]*fFlatStrideM[iVar];
+    fFlatMeasOrigCell[iBin] = cellM;
+  }
+  return kTRUE;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::FlatIteration(FlatWork& w, Int_t nThreads) const {
+  //
+  // one bayes iteration (CreateEstMeasured, CreateInvResponse, CreateUnfolded)
+  // from w.fPrior, w.fEfficiency and w.fMeasured to w.fUnfolded
+  //
+
+  const Int_t nCellsM = fFlatRowStart.size()-1;
+  const Int_t nCellsT = fFlatColStart.size()-1;
+  for (Int_t iCell=0; iCell<nCellsT; iCell++) w.fPriorTimesEff[iCell] = w.fPrior[iCell]*w.fEfficiency[iCell];
+
+  // M(i) = SUM_k { COND(i,k) * T(k) * E (k)} and INV(i,j) = COND(i,j) * T(j) * E(j) / M(i)
+  AliCFParallelFor(nCellsM,nThreads,[&](Int_t first, Int_t last) {
+      for (Int_t iCell=first; iCell<last; iCell++) {
+	Double_t estMeasured = 0.;
+	for (Int_t i=fFlatRowStart[iCell]; i<fFlatRowStart[iCell+1]; i++) {
+	  Int_t iBin = fFlatRowBins[i];
+	  Double_t fill = fFlatConditional[iBin] * w.fPriorTimesEff[fFlatCellT[iBin]];
+	  if (fill>0.) estMeasured += fill;
+	}
+	w.fEstMeasured[iCell] = estMeasured;
+	for (Int_t i=fFlatRowStart[iCell]; i<fFlatRowStart[iCell+1]; i++) {
+	  Int_t iBin = fFlatRowBins[i];
+	  w.fInverse[iBin] = (estMeasured>0. ? fFlatConditional[iBin] * w.fPriorTimesEff[fFlatCellT[iBin]] / estMeasured : 0.);
+	}
+      }
+    });
+
+  // T(i) = SUM_k { INV(i,k) * M(k) } / E(i)
+  AliCFParallelFor(nCellsT,nThreads,[&](Int_t first, Int_t last) {
+      for (Int_t iCell=first; iCell<last; iCell++) {
+	Double_t effValue = w.fEfficiency[iCell];
+	Double_t unfolded = 0.;
+	Char_t   filled   = 0;
+	for (Int_t i=fFlatColStart[iCell]; i<fFlatColStart[iCell+1]; i++) {
+	  Int_t iBin = fFlatColBins[i];
+	  Double_t fill = (effValue>0. ? w.fInverse[iBin] * w.fMeasured[fFlatCellM[iBin]] / effValue : 0.);
+	  if (fill>0.) {
+	    unfolded += fill;
+	    filled = 1;
+	  }
+	}
+	w.fUnfolded[iCell]     = unfolded;
+	w.fUnfoldedMask[iCell] = filled;
+      }
+    });
+}
+
+//______________________________________________________________
+
+Double_t AliCFUnfolding::FlatConvergence(const FlatWork& w) const {
+  //
+  // as GetConvergence()
+  //
+  Double_t convergence = 0.;
+  for (UInt_t iCell=0; iCell<w.fPrior.size(); iCell++) {
+    if (!w.fPriorMask[iCell]) continue;
+    Double_t priorValue   = w.fPrior[iCell];
+    Double_t currentValue = w.fUnfolded[iCell];
+    if (priorValue > 0.)
+      convergence += ((priorValue-currentValue)/priorValue)*((priorValue-currentValue)/priorValue);
+    else 
+      AliWarning(Form("priorValue = %f. Adding 0 to convergence criterion.",priorValue)); 
+  }
+  return convergence;
+}
+
+//______________________________________________________________
+
+Short_t AliCFUnfolding::FlatSmooth(FlatWork& w) {
+  //
+  // smoothes w.fUnfolded with Smooth(), through fUnfolded
+  //
+  FlatToSparse(w.fUnfolded,w.fUnfoldedMask,fUnfolded);
+  Short_t status = Smooth();
+  SparseToFlat(fUnfolded,w.fUnfolded,w.fUnfoldedMask);
+  return status;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::FlatReplica(Int_t iReplica, FlatWork& w, Int_t nThreads) {
+  //
+  // unfolds error replica iReplica (see CalculateCorrelatedErrors) : randomized efficiency
+  // and measured spectrum, original prior, fMaxNumIterations iterations.
+  // The randomized response matrix of the serial unfolding is not generated : the
+  // conditional matrix is computed once from the original response in both cases.
+  // Thread safe if no smoothing is used.
+  //
+
+  UInt_t seed = fRandomSeed ? fRandomSeed ^ (0x9E3779B9u * (UInt_t)(iReplica+1)) : 0; // 0 : not reproducible, as TRandom3(0)
+  if (fRandomSeed && !seed) seed = 1;
+  TRandom3 random(seed);
+
+  std::fill(w.fEfficiency.begin(),w.fEfficiency.end(),0.);
+  for (UInt_t iBin=0; iBin<fFlatEffOrigCell.size(); iBin++) {
+    w.fEfficiency[fFlatEffOrigCell[iBin]] = random.Gaus(fFlatEffOrigVal[iBin],fFlatEffOrigErr[iBin]);
+  }
+  std::fill(w.fMeasured.begin(),w.fMeasured.end(),0.);
+  for (UInt_t iBin=0; iBin<fFlatMeasOrigCell.size(); iBin++) {
+    w.fMeasured[fFlatMeasOrigCell[iBin]] = random.Gaus(fFlatMeasOrigVal[iBin],fFlatMeasOrigErr[iBin]);
+  }
+  w.fPrior        = fFlatPriorOrig;
+  w.fPriorMask    = fFlatPriorOrigMask;
+  w.fUnfolded     = w.fPrior;
+  w.fUnfoldedMask = w.fPriorMask;
+
+  for (Int_t iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) {
+    FlatIteration(w,nThreads);
+    if (fUseSmoothing && FlatSmooth(w)) {
+      AliError("Couldn't smooth the unfolded spectrum!!");
+      return;
+    }
+    w.fPrior     = w.fUnfolded;
+    w.fPriorMask = w.fUnfoldedMask;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::FlatFillDelta(const FlatWork& w) {
+  //
+  // as FillDeltaUnfoldedProfile()
+  //
+  for (UInt_t iCell=0; iCell<fFlatFinal.size(); iCell++) {
+    if (!fFlatFinalMask[iCell]) continue;
+    Double_t deltaInBin   = fFlatFinal[iCell] - w.fUnfolded[iCell];
+    Double_t entriesInBin = fFlatDeltaN[iCell];
+
+    Double_t mean_nplus1 = fFlatDeltaMean[iCell] ;
+    mean_nplus1 *= entriesInBin ;
+    mean_nplus1 += deltaInBin ;
+    mean_nplus1 /= (entriesInBin+1) ;
+
+    Double_t meanx2_nplus1 = fFlatDeltaMeanX2[iCell] ;
+    meanx2_nplus1 *= entriesInBin ;
+    meanx2_nplus1 += (deltaInBin*deltaInBin) ;
+    meanx2_nplus1 /= (entriesInBin+1) ;
+
+    fFlatDeltaMean  [iCell] = mean_nplus1;
+    fFlatDeltaMeanX2[iCell] = meanx2_nplus1;
+    fFlatDeltaN     [iCell] = entriesInBin+1;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::FlatToSparse(const std::vector<Double_t>& values, const std::vector<Char_t>& mask, THnSparse* hist) {
+  //
+  // fills hist (true space) with the filled cells of values, with errors set to 0
+  //
+  hist->Reset();
+  for (UInt_t iCell=0; iCell<values.size(); iCell++) {
+    if (!mask[iCell]) continue;
+    Long64_t cell = iCell;
+    for (Int_t iVar=fNVariables-1; iVar>=0; iVar--) {
+      fCoordinatesN_T[iVar] = cell / fFlatStrideT[iVar];
+      cell -= fCoordinatesN_T[iVar] * fFlatStrideT[iVar];
+    }
+    hist->SetBinError  (fCoordinatesN_T,0.);
+    hist->SetBinContent(fCoordinatesN_T,values[iCell]);
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SparseToFlat(const THnSparse* hist, std::vector<Double_t>& values, std::vector<Char_t>& mask) {
+  //
+  // dense copy of hist (true space) and of its filled cells
+  //
+  const Long64_t nCells = fFlatColStart.empty() ? 0 : fFlatColStart.size()-1;
+  values.assign(nCells,0.);
+  mask  .assign(nCells,0);
+  for (Long64_t iBin=0; iBin<hist->GetNbins(); iBin++) {
+    Double_t value = hist->GetBinContent(iBin,fCoordinatesN_T);
+    Long64_t cell = 0;
+    for (Int_t iVar=0; iVar<fNVariables; iVar++) cell += fCoordinatesN_T[iVar]*fFlatStrideT[iVar];
+    values[cell] = value;
+    mask  [cell] = 1;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::WriteCheckpoint() {
+  //
+  // writes the unfolder to fCheckpointFile (through a temporary file, so that
+  // an interrupted job leaves the previous checkpoint)
+  //
+  TString tmpName = fCheckpointFile + ".tmp";
+  TDirectory* currentDir = gDirectory;
+  TFile* file = TFile::Open(tmpName,"RECREATE");
+  if (!file || file->IsZombie()) {
+    AliError(Form("Cannot write checkpoint file %s",tmpName.Data()));
+    delete file;
+    currentDir->cd();
+    return;
+  }
+  Write(GetName());
+  file->Close();
+  delete file;
+  currentDir->cd();
+  if (gSystem->Rename(tmpName,fCheckpointFile)) AliError(Form("Cannot rename %s to %s",tmpName.Data(),fCheckpointFile.Data()));
+  AliDebug(0,Form("checkpoint written after %d iterations and %d replicas",fNIterationsDone,fNReplicasDone));
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::UnfoldParallel() {
+  //
+  // parallel version of Unfold() (see the description above) :
+  // bayes iterations until convergence, then correlated errors
+  //
+
+  if (fNCalcCorrErrors >= 2) {
+    AliInfo("Unfolding already finished");
+    return;
+  }
+  if (!BuildFlatMatrices()) {
+    AliError("Using the serial unfolding");
+    fNThreads = -1;
+    Unfold();
+    return;
+  }
+  Int_t nThreads = fNThreads > 0 ? fNThreads : (Int_t)std::thread::hardware_concurrency();
+  if (nThreads < 1) nThreads = 1;
+
+  const Int_t nCellsM = fFlatRowStart.size()-1;
+  const Int_t nCellsT = fFlatColStart.size()-1;
+  Int_t nSteps = 0;           // iterations/replicas done in this call
+  Int_t nSinceCheckpoint = 0; // iterations/replicas done since the last checkpoint
+  Bool_t checkpoint = fCheckpointFile.Length() > 0;
+
+  FlatWork work;
+  work.fPriorTimesEff.resize(nCellsT);
+  work.fUnfolded     .resize(nCellsT);
+  work.fUnfoldedMask .resize(nCellsT);
+  work.fEstMeasured  .resize(nCellsM);
+  work.fInverse      .resize(fFlatConditional.size());
+
+  if (fNCalcCorrErrors == 0) {
+    if (fNIterationsDone == 0) {
+      fFlatPrior     = fFlatPriorOrig;
+      fFlatPriorMask = fFlatPriorOrigMask;
+    }
+    work.fPrior        = fFlatPrior;
+    work.fPriorMask    = fFlatPriorMask;
+    work.fUnfolded     = work.fPrior;
+    work.fUnfoldedMask = work.fPriorMask;
+    work.fEfficiency   = fFlatEfficiency;
+    work.fMeasured     = fFlatMeasured;
+
+    Double_t convergence = 0.;
+    Int_t iIterBayes = 0;
+    for (iIterBayes=fNIterationsDone; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+      FlatIteration(work,nThreads);
+
+      convergence = FlatConvergence(work);
+      AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+
+      if (fMaxConvergence>0. && convergence<fMaxConvergence) {
+	fNRandomIterations = iIterBayes;
+	AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+	break;
+      }
+
+      if (fUseSmoothing && FlatSmooth(work)) {
+	AliError("Couldn't smooth the unfolded spectrum!!");
+	AliInfo(Form("\n\n=======================\nFinish at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+	return;
+      }
+
+      // update the prior distribution
+      work.fPrior     = work.fUnfolded;
+      work.fPriorMask = work.fUnfoldedMask;
+      fFlatPrior      = work.fPrior;
+      fFlatPriorMask  = work.fPriorMask;
+      fNIterationsDone = iIterBayes+1;
+      nSteps++;
+      if (checkpoint && ++nSinceCheckpoint >= fCheckpointEvery) {
+	WriteCheckpoint();
+	nSinceCheckpoint = 0;
+      }
+      if (fMaxStepsPerCall > 0 && nSteps >= fMaxStepsPerCall && iIterBayes+1 < fMaxNumIterations) {
+	if (checkpoint && nSinceCheckpoint) WriteCheckpoint();
+	AliInfo(Form("Stopping after %d iterations, call Unfold() again to continue",fNIterationsDone));
+	return;
+      }
+    } // end bayes iteration
+
+    fFlatFinal     = work.fUnfolded;
+    fFlatFinalMask = work.fUnfoldedMask;
+    FlatToSparse(fFlatFinal,fFlatFinalMask,fUnfolded);
+    FlatToSparse(fFlatPrior,fFlatPriorMask,fPrior);
+    if (fUnfoldedFinal) delete fUnfoldedFinal;
+    fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
+
+    AliInfo(Form("\n================================================\nFinished bayes iteration %d with convergence %e, now calculating errors...\n================================================\n",iIterBayes,convergence));
+    fNCalcCorrErrors = 1;
+    fNReplicasDone   = 0;
+    fFlatDeltaMean  .assign(nCellsT,0.);
+    fFlatDeltaMeanX2.assign(nCellsT,0.);
+    fFlatDeltaN     .assign(nCellsT,0.);
+    if (checkpoint) {
+      WriteCheckpoint();
+      nSinceCheckpoint = 0;
+    }
+  }
+
+  // correlated errors : error replicas unfolded in parallel (one after the other with smoothing),
+  // and accumulated in the replica order
+  Int_t nParallel = fUseSmoothing ? 1 : nThreads;
+  std::vector<FlatWork> works(nParallel,work);
+  for (Int_t iWork=0; iWork<nParallel; iWork++) {
+    works[iWork].fEfficiency.resize(nCellsT);
+    works[iWork].fMeasured  .resize(nCellsM);
+  }
+  while (fNReplicasDone < fNRandomIterations) {
+    Int_t nReplicas = TMath::Min(nParallel,fNRandomIterations-fNReplicasDone);
+    if (fMaxStepsPerCall > 0) nReplicas = TMath::Min(nReplicas,fMaxStepsPerCall-nSteps);
+    if (nReplicas <= 0) {
+      if (checkpoint && nSinceCheckpoint) WriteCheckpoint();
+      AliInfo(Form("Stopping after %d error replicas, call Unfold() again to continue",fNReplicasDone));
+      return;
+    }
+    if (nReplicas == 1) FlatReplica(fNReplicasDone,works[0],nThreads);
+    else {
+      std::vector<std::thread> threads;
+      for (Int_t iReplica=1; iReplica<nReplicas; iReplica++) {
+	threads.push_back(std::thread(&AliCFUnfolding::FlatReplica,this,fNReplicasDone+iReplica,std::ref(works[iReplica]),1));
+      }
+      FlatReplica(fNReplicasDone,works[0],1);
+      for (UInt_t iThread=0; iThread<threads.size(); iThread++) threads[iThread].join();
+    }
+    for (Int_t iReplica=0; iReplica<nReplicas; iReplica++) FlatFillDelta(works[iReplica]);
+    fNReplicasDone += nReplicas;
+    nSteps         += nReplicas;
+    nSinceCheckpoint += nReplicas;
+    if (checkpoint && nSinceCheckpoint >= fCheckpointEvery && fNReplicasDone < fNRandomIterations) {
+      WriteCheckpoint();
+      nSinceCheckpoint = 0;
+    }
+  }
+
+  // errors of the final unfolded spectrum : spread of the delta-unfolded distribution
+  fDeltaUnfoldedP->Reset();
+  fDeltaUnfoldedN->Reset();
+  for (Int_t iCell=0; iCell<nCellsT; iCell++) {
+    if (!fFlatFinalMask[iCell]) continue;
+    Long64_t cell = iCell;
+    for (Int_t iVar=fNVariables-1; iVar>=0; iVar--) {
+      fCoordinatesN_T[iVar] = cell / fFlatStrideT[iVar];
+      cell -= fCoordinatesN_T[iVar] * fFlatStrideT[iVar];
+    }
+    Double_t mean         = fFlatDeltaMean[iCell];
+    Double_t meanx2       = fFlatDeltaMeanX2[iCell];
+    Double_t entriesInBin = fFlatDeltaN[iCell];
+    fDeltaUnfoldedP->SetBinError  (fCoordinatesN_T,meanx2);
+    fDeltaUnfoldedP->SetBinContent(fCoordinatesN_T,mean);
+    fDeltaUnfoldedN->SetBinContent(fCoordinatesN_T,entriesInBin);
+    Double_t sigma = (entriesInBin > 1. ? TMath::Sqrt((entriesInBin/(entriesInBin-1.))*TMath::Abs(meanx2-mean*mean)) : 0.);
+    fUnfoldedFinal->SetBinError(fCoordinatesN_T,sigma);
+  }
+
+  // now errors are calculated
+  fNCalcCorrErrors = 2;
+  if (checkpoint) WriteCheckpoint();
+  AliInfo(Form("\n\n=======================\nFinished : %d iterations and %d error replicas\n=======================\n\n",fNIterationsDone,fNReplicasDone));
+}
@@ -10,7 +10,9 @@
 // Author : renaud.vernet@cern.ch                                     //
 //--------------------------------------------------------------------//
 
+#include <vector>
 #include "TNamed.h"
+#include "TString.h"
 #include "THnSparse.h"
 #include "AliLog.h"
 
@@ -37,6 +39,20 @@ class AliCFUnfolding : public TNamed {
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
 
+  // parallel unfolding (see UnfoldParallel) with n threads, n=0 : one thread per core
+  void SetNThreads(Int_t n = 0) {fNThreads = n;}
+  // write the unfolder to fileName every "every" iterations/error replicas (parallel unfolding only)
+  // if maxStepsPerCall>0, Unfold() returns after maxStepsPerCall iterations/replicas
+  // the unfolding is resumed calling Unfold() again, also on the object read back from fileName
+  void SetCheckpoint(const Char_t* fileName, Int_t every = 1, Int_t maxStepsPerCall = 0) {
+    fCheckpointFile=fileName;
+    fCheckpointEvery=every;
+    fMaxStepsPerCall=maxStepsPerCall;
+  }
+  Int_t  GetNIterationsDone() const {return fNIterationsDone;}
+  Int_t  GetNReplicasDone()   const {return fNReplicasDone;}
+  Bool_t IsFinished()         const {return fNCalcCorrErrors == 2;}
+
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
     fSmoothFunction=fcn;                                   // the option "opt" is used if "fcn" is specified
@@ -97,9 +113,9 @@ class AliCFUnfolding : public TNamed {
 	THnSparse     *fConditional;       // Matrix holding the conditional probabilities P(M|T)
         THnSparse     *fUnfolded;          // Unfolded spectrum (modified before and during error calculation)
 	THnSparse     *fUnfoldedFinal;     // Final unfolded spectrum
-        Int_t         *fCoordinates2N;     // Coordinates in 2N (measured,true) space
-	Int_t         *fCoordinatesN_M;    // Coordinates in measured space
-	Int_t         *fCoordinatesN_T;    // Coordinates in true space
+        Int_t         *fCoordinates2N;     //! Coordinates in 2N (measured,true) space
+	Int_t         *fCoordinatesN_M;    //! Coordinates in measured space
+	Int_t         *fCoordinatesN_T;    //! Coordinates in true space
 
 
   /* correlated error calculation */
@@ -112,6 +128,42 @@ class AliCFUnfolding : public TNamed {
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
 
+  /* parallel unfolding */
+  Int_t          fNThreads;          // Number of threads, <0 : serial unfolding with THnSparse
+  TString        fCheckpointFile;    // File where the unfolder is written during the unfolding
+  Int_t          fCheckpointEvery;   // Number of iterations/replicas between two checkpoints
+  Int_t          fMaxStepsPerCall;   // Number of iterations/replicas after which Unfold() returns, 0 : no limit
+  Int_t          fNIterationsDone;   // Number of bayes iterations done
+  Int_t          fNReplicasDone;     // Number of error replicas done
+  std::vector<Double_t> fFlatPrior;       // Current prior, dense over the true cells (including under/overflows)
+  std::vector<Char_t>   fFlatPriorMask;   // Filled cells of the current prior
+  std::vector<Double_t> fFlatFinal;       // Final unfolded spectrum, dense
+  std::vector<Char_t>   fFlatFinalMask;   // Filled cells of the final unfolded spectrum
+  std::vector<Double_t> fFlatDeltaMean;   // Mean of the delta-unfolded distribution
+  std::vector<Double_t> fFlatDeltaMeanX2; // Mean of the squared delta-unfolded distribution
+  std::vector<Double_t> fFlatDeltaN;      // Entries of the delta-unfolded distribution
+
+  // conditional matrix and inputs in flat form, built from the THnSparse (not streamed)
+  std::vector<Long64_t> fFlatStrideM;     //! Strides of the measured cells
+  std::vector<Long64_t> fFlatStrideT;     //! Strides of the true cells
+  std::vector<Int_t>    fFlatCellM;       //! Measured cell of each bin of the conditional matrix
+  std::vector<Int_t>    fFlatCellT;       //! True cell of each bin of the conditional matrix
+  std::vector<Double_t> fFlatConditional; //! Content of each bin of the conditional matrix
+  std::vector<Int_t>    fFlatRowStart;    //! Bins of the conditional matrix grouped by measured cell : start of each cell
+  std::vector<Int_t>    fFlatRowBins;     //! and bins, in the THnSparse order
+  std::vector<Int_t>    fFlatColStart;    //! Bins of the conditional matrix grouped by true cell : start of each cell
+  std::vector<Int_t>    fFlatColBins;     //! and bins, in the THnSparse order
+  std::vector<Double_t> fFlatEfficiency;  //! Efficiency, dense
+  std::vector<Double_t> fFlatMeasured;    //! Measured spectrum, dense
+  std::vector<Double_t> fFlatPriorOrig;   //! Original prior, dense
+  std::vector<Char_t>   fFlatPriorOrigMask; //! Filled cells of the original prior
+  std::vector<Int_t>    fFlatEffOrigCell; //! Cell, content and error of the bins of the original efficiency
+  std::vector<Double_t> fFlatEffOrigVal;  //!
+  std::vector<Double_t> fFlatEffOrigErr;  //!
+  std::vector<Int_t>    fFlatMeasOrigCell;//! Cell, content and error of the bins of the original measured spectrum
+  std::vector<Double_t> fFlatMeasOrigVal; //!
+  std::vector<Double_t> fFlatMeasOrigErr; //!
+
 
   // functions
   void     Init();                  // initialisation of the internal settings
@@ -132,7 +184,20 @@ class AliCFUnfolding : public TNamed {
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  /* parallel unfolding */
+  struct FlatWork;                      // buffers of one unfolding (nominal or error replica)
+  void     UnfoldParallel();            // unfolding with the flat conditional matrix, across threads
+  Bool_t   BuildFlatMatrices();         // flat form of the conditional matrix and of the inputs
+  void     FlatIteration(FlatWork& w, Int_t nThreads) const; // one bayes iteration
+  Double_t FlatConvergence(const FlatWork& w) const;          // convergence criterion
+  Short_t  FlatSmooth(FlatWork& w);     // smoothing through fUnfolded (not thread safe)
+  void     FlatReplica(Int_t iReplica, FlatWork& w, Int_t nThreads); // unfolding of one error replica
+  void     FlatFillDelta(const FlatWork& w);                 // as FillDeltaUnfoldedProfile
+  void     FlatToSparse(const std::vector<Double_t>& values, const std::vector<Char_t>& mask, THnSparse* hist);
+  void     SparseToFlat(const THnSparse* hist, std::vector<Double_t>& values, std::vector<Char_t>& mask);
+  void     WriteCheckpoint();
+
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
@@ -27,7 +27,9 @@ AliMixEventCutObj::AliMixEventCutObj(AliMixEventCutObj::EEPAxis_t type, Float_t
    fCutMax(max),
    fCutStep(step),
    fCutSmallVal(0),
-   fCurrentVal(min)
+   fCurrentVal(min),
+   fBinMin(),
+   fBinMax()
 {
    //
    // Default constructor
@@ -45,7 +47,9 @@ AliMixEventCutObj::AliMixEventCutObj(const AliMixEventCutObj &obj) : TObject(obj
    fCutMax(obj.fCutMax),
    fCutStep(obj.fCutStep),
    fCutSmallVal(obj.fCutSmallVal),
-   fCurrentVal(obj.fCurrentVal)
+   fCurrentVal(obj.fCurrentVal),
+   fBinMin(obj.fBinMin),
+   fBinMax(obj.fBinMax)
 {
    //
    // Copy constructor
@@ -69,6 +73,8 @@ AliMixEventCutObj &AliMixEventCutObj::operator=(const AliMixEventCutObj &obj)
       fCutStep = obj.fCutStep;
       fCutSmallVal = obj.fCutSmallVal;
       fCurrentVal = obj.fCurrentVal;
+      fBinMin = obj.fBinMin;
+      fBinMax = obj.fBinMax;
 //       fNoMore = obj.fNoMore;
    }
    return *this;
@@ -131,19 +137,40 @@ Int_t AliMixEventCutObj::GetNumberOfBins() const
 }
 
 //_________________________________________________________________________________________________
-Int_t AliMixEventCutObj::GetBinNumber(Float_t num) const
+void AliMixEventCutObj::BuildBins() const
 {
    //
-   // Returns bin (index) number in current cut.
-   // Returns -1 in case of out of range
+   // Fills the bin edges, stepping through the cut range
+   // exactly as it was done for each value before
    //
-   Int_t binNum = 0;
+   fBinMin.clear();
+   fBinMax.clear();
+   if (fCutStep <= 0) return;
    for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) {
-      binNum++;
-      if ((num >= iCurrent) && (num < iCurrent + fCutStep - fCutSmallVal)) {
-         return binNum;
-      }
+      fBinMin.push_back(iCurrent);
+      fBinMax.push_back(iCurrent + fCutStep - fCutSmallVal);
    }
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventCutObj::GetBinNumber(Float_t num) const
+{
+   //
+   // Returns bin (index) number in current cut.
+   // Returns -1 in case of out of range
+   // The bin is guessed from the uniform step and corrected with the bin edges
+   //
+   if (fBinMin.empty()) BuildBins();
+   Int_t nBins = fBinMin.size();
+   if (!nBins || !(num >= fBinMin[0])) return -1;
+
+   Double_t guess = (num - fCutMin) / fCutStep;
+   Int_t iBin = (guess < nBins - 1) ? (Int_t)guess : nBins - 1;
+   while (iBin > 0 && num < fBinMin[iBin]) iBin--;
+   while (iBin + 1 < nBins && num >= fBinMin[iBin + 1]) iBin++;
+   // first bin containing num, as the bins can overlap for a negative small value
+   while (iBin > 0 && num < fBinMax[iBin - 1]) iBin--;
+   if (num < fBinMax[iBin]) return iBin + 1;
    return -1;
 }
 
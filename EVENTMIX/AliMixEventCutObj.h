@@ -11,6 +11,8 @@
 #ifndef ALIMIXEVENTCUTOBJ_H
 #define ALIMIXEVENTCUTOBJ_H
 
+#include <vector>
+
 #include <TObject.h>
 #include <TString.h>
 
@@ -64,6 +66,11 @@ private:
 
    Float_t     fCurrentVal;    // current value
 
+   mutable std::vector<Float_t> fBinMin; //! lower edges of the bins (built on first use by GetBinNumber)
+   mutable std::vector<Float_t> fBinMax; //! upper edges of the bins
+
+   void        BuildBins() const;
+
    ClassDef(AliMixEventCutObj, 3)
 };
 
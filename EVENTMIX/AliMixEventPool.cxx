@@ -21,6 +21,8 @@ ClassImp(AliMixEventPool)
 AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(name, title),
    fListOfEntryList(),
    fListOfEventCuts(),
+   fCutNumberOfBins(),
+   fCutStrides(),
    fBinNumber(0),
    fBufferSize(0),
    fMixNumber(0)
@@ -35,6 +37,8 @@ AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(n
 AliMixEventPool::AliMixEventPool(const AliMixEventPool &obj) : TNamed(obj),
    fListOfEntryList(obj.fListOfEntryList),
    fListOfEventCuts(obj.fListOfEventCuts),
+   fCutNumberOfBins(obj.fCutNumberOfBins),
+   fCutStrides(obj.fCutStrides),
    fBinNumber(obj.fBinNumber),
    fBufferSize(obj.fBufferSize),
    fMixNumber(obj.fMixNumber)
@@ -56,6 +60,8 @@ AliMixEventPool &AliMixEventPool::operator=(const AliMixEventPool &obj)
       TNamed::operator=(obj);
       fListOfEntryList = obj.fListOfEntryList;
       fListOfEventCuts = obj.fListOfEventCuts;
+      fCutNumberOfBins = obj.fCutNumberOfBins;
+      fCutStrides = obj.fCutStrides;
       fBinNumber = obj.fBinNumber;
       fBufferSize = obj.fBufferSize;
       fMixNumber = obj.fMixNumber;
@@ -80,6 +86,7 @@ void AliMixEventPool::AddCut(AliMixEventCutObj *cut)
    // Adds cut
    //
    if (cut && cut->IsValid()) fListOfEventCuts.Add(new AliMixEventCutObj(*cut));
+   fCutStrides.clear();
 }
 //_________________________________________________________________________________________________
 void AliMixEventPool::Print(const Option_t *option) const
@@ -105,16 +112,52 @@ Int_t AliMixEventPool::Init()
 {
    //
    // Init event pool
+   // One entry list is created for each combination of cut bins, the first
+   // cut running fastest (same number and order of entry lists as
+   // CreateEntryListsRecursivly, in a time linear in the number of bins)
    //
    AliDebug(AliLog::kDebug + 5, "<-");
-   CreateEntryListsRecursivly(fListOfEventCuts.GetEntries() - 1);
-   fBinNumber++;
+   Long64_t numEntryLists = 1;
+   TObjArrayIter next(&fListOfEventCuts);
+   AliMixEventCutObj *cut;
+   while ((cut = (AliMixEventCutObj *) next())) {
+      Int_t numSteps = 0;
+      cut->Reset();
+      while (cut->HasMore()) {
+         cut->AddStep();
+         numSteps++;
+      }
+      if (numSteps > 0) numEntryLists *= numSteps;
+   }
+   fListOfEntryList.Expand(fListOfEntryList.GetEntriesFast() + numEntryLists);
+   for (Long64_t i = 0; i < numEntryLists; i++) {
+      fListOfEntryList.Add(new TEntryList);
+      fBinNumber++;
+   }
    AliDebug(AliLog::kDebug, Form("fBinnumber = %d", fBinNumber));
-   AddEntryList();
+   ComputeStrides();
    AliDebug(AliLog::kDebug + 5, "->");
    return 0;
 }
 
+//_________________________________________________________________________________________________
+void AliMixEventPool::ComputeStrides()
+{
+   //
+   // Computes the stride of each cut in the flat index of entry lists
+   //
+   Int_t num = fListOfEventCuts.GetEntriesFast();
+   fCutNumberOfBins.resize(num);
+   fCutStrides.resize(num);
+   Long64_t stride = 1;
+   for (Int_t i = 0; i < num; i++) {
+      AliMixEventCutObj *cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
+      fCutNumberOfBins[i] = cut->GetNumberOfBins();
+      fCutStrides[i] = stride;
+      stride *= fCutNumberOfBins[i];
+   }
+}
+
 //_________________________________________________________________________________________________
 void AliMixEventPool::CreateEntryListsRecursivly(Int_t index)
 {
@@ -190,35 +233,31 @@ TEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
 {
    //
    // Find entrlist in list of entrlist
+   // idEntryList = 1 + sum over cuts of (bin - 1) * stride, strides being
+   // the products of the numbers of bins of the previous cuts
+   // (same index as used by SetCutValuesFromBinIndex)
    //
    AliDebug(AliLog::kDebug + 5, "<-");
    Int_t num = fListOfEventCuts.GetEntriesFast();
    if (num < 1) return 0;
-   Int_t *indexes = new Int_t[num] ;
-   Int_t *lenght = new Int_t[num];
-   Int_t i = 0;
-   TObjArrayIter next(&fListOfEventCuts);
-   AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      indexes[i] = cut->GetIndex(ev);
-      if (indexes[i] < 0) {
+   if ((Int_t) fCutStrides.size() != num) ComputeStrides();
+   Long64_t index = 0;
+   for (Int_t i = 0; i < num; i++) {
+      AliMixEventCutObj *cut = (AliMixEventCutObj *) fListOfEventCuts.UncheckedAt(i);
+      Int_t bin = cut->GetIndex(ev);
+      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, bin));
+      if (bin < 1 || bin > fCutNumberOfBins[i]) {
          AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
-         delete [] indexes;
-         delete [] lenght;
          return 0;
       }
-      lenght[i] = cut->GetNumberOfBins();
-      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, indexes[i]));
-      i++;
+      index += (bin - 1) * fCutStrides[i];
    }
-   idEntryList = 0;
-   SearchIndexRecursive(fListOfEventCuts.GetEntries() - 1, &indexes[0], &lenght[0], idEntryList);
+   if (index >= fListOfEntryList.GetEntriesFast()) return 0;
+   idEntryList = index + 1;
    AliDebug(AliLog::kDebug, Form("idEntryList %d", idEntryList - 1));
    // index which start with 0 (idEntryList-1)
-   delete [] indexes;
-   delete [] lenght;
    AliDebug(AliLog::kDebug + 5, "->");
-   return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
+   return (TEntryList *) fListOfEntryList.UncheckedAt(idEntryList - 1);
 }
 
 //_________________________________________________________________________________________________
@@ -11,6 +11,8 @@
 #ifndef ALIMIXEVENTPOOL_H
 #define ALIMIXEVENTPOOL_H
 
+#include <vector>
+
 #include <TObjArray.h>
 #include <TNamed.h>
 
@@ -30,6 +32,7 @@ public:
    // inits correctly object
    Int_t       Init();
 
+   // former recursive creation and search of entry lists (not used anymore by Init and FindEntryList)
    void        CreateEntryListsRecursivly(Int_t index);
    void        SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index);
    TEntryList *AddEntryList();
@@ -54,6 +57,11 @@ private:
    TObjArray   fListOfEntryList;       // list of entry lists
    TObjArray   fListOfEventCuts;       // list of entry lists
 
+   std::vector<Int_t> fCutNumberOfBins; //! number of bins of each cut
+   std::vector<Long64_t> fCutStrides;   //! stride of each cut in the flat entry list index
+
+   void        ComputeStrides();
+
    Int_t       fBinNumber;             // bin number
    Int_t       fBufferSize;            // buffer size
    Int_t       fMixNumber;             // mixing number
@@ -0,0 +1,87 @@
+//
+// Class AliMixEventReducer
+//
+// AliMixEventReducer creates the reduced event (AliMixReducedEvent) stored
+// in the in-memory mixing buffer of AliMixInputEventHandler.
+//
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliVVertex.h"
+#include "AliVParticle.h"
+#include "AliAODEvent.h"
+#include "AliAODTrack.h"
+#include "AliCentrality.h"
+#include "AliEventplane.h"
+
+#include "AliMixReducedEvent.h"
+#include "AliMixEventReducer.h"
+
+ClassImp(AliMixEventReducer)
+
+//_________________________________________________________________________________________________
+AliMixEventReducer::AliMixEventReducer(const char *name, const char *title) : TNamed(name, title),
+   fPtMin(0),
+   fPtMax(1e10),
+   fEtaMin(-1e10),
+   fEtaMax(1e10),
+   fFilterMask(0),
+   fCentralityEstimator(),
+   fEventPlaneMethod(),
+   fEventPlaneHarmonic(2),
+   fFilterMaskWarned(kFALSE)
+{
+   //
+   // Default constructor
+   //
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventReducer::Reduce(AliVEvent *ev, AliMixReducedEvent &reduced)
+{
+   //
+   // Fills reduced event
+   //
+   if (!ev) return kFALSE;
+   const AliVVertex *vertex = ev->GetPrimaryVertex();
+   if (vertex) reduced.SetZVertex(vertex->GetZ());
+   reduced.SetMultiplicity(ev->GetNumberOfTracks());
+   if (!fCentralityEstimator.IsNull()) {
+      AliCentrality *c = ev->GetCentrality();
+      if (!c) {
+         AliError("GetCentrality() is null");
+         return kFALSE;
+      }
+      reduced.SetCentrality(c->GetCentralityPercentile(fCentralityEstimator.Data()));
+   }
+   if (!fEventPlaneMethod.IsNull()) {
+      // as in AliMixEventCutObj, the V0 event planes can be computed without the event plane object
+      AliEventplane *evtPlane = ev->GetEventplane();
+      if (!evtPlane) evtPlane = new AliEventplane();
+      reduced.SetEventPlane(evtPlane->GetEventplane(fEventPlaneMethod.Data(), ev, fEventPlaneHarmonic));
+      if (!ev->GetEventplane()) delete evtPlane;
+   }
+
+   // the filter bits only exist for AOD tracks
+   Bool_t useFilterMask = fFilterMask && dynamic_cast<AliAODEvent *>(ev);
+   if (fFilterMask && !useFilterMask && !fFilterMaskWarned) {
+      AliWarning(Form("Filter mask %u can only be applied to AOD tracks, it is ignored for this input", fFilterMask));
+      fFilterMaskWarned = kTRUE;
+   }
+
+   for (Int_t i = 0; i < ev->GetNumberOfTracks(); i++) {
+      AliVParticle *track = ev->GetTrack(i);
+      if (!track) continue;
+      if (track->Pt() < fPtMin || track->Pt() >= fPtMax) continue;
+      if (track->Eta() < fEtaMin || track->Eta() >= fEtaMax) continue;
+      UInt_t filterMap = 0;
+      if (useFilterMask) {
+         AliAODTrack *aodTrack = dynamic_cast<AliAODTrack *>(track);
+         if (!aodTrack) continue;
+         filterMap = aodTrack->GetFilterMap();
+         if ((filterMap & fFilterMask) != fFilterMask) continue;
+      }
+      reduced.AddTrack(track->Pt(), track->Eta(), track->Phi(), track->Charge(), filterMap, i);
+   }
+   return kTRUE;
+}
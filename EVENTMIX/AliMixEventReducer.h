@@ -0,0 +1,49 @@
+//
+// Class AliMixEventReducer
+//
+// AliMixEventReducer creates the reduced event (AliMixReducedEvent) stored
+// in the in-memory mixing buffer of AliMixInputEventHandler.
+// The default implementation keeps the primary vertex, the multiplicity,
+// the centrality (if an estimator is set), the event plane (if a method is
+// set) and the tracks in the pt and eta ranges (passing the filter mask for
+// AOD events; the mask is ignored, with a warning, for other input).
+// Derive from it and override Reduce() for other selections.
+//
+
+#ifndef ALIMIXEVENTREDUCER_H
+#define ALIMIXEVENTREDUCER_H
+
+#include <TNamed.h>
+#include <TString.h>
+
+class AliVEvent;
+class AliMixReducedEvent;
+class AliMixEventReducer : public TNamed {
+public:
+   AliMixEventReducer(const char *name = "mixEventReducer", const char *title = "Mix event reducer");
+   virtual ~AliMixEventReducer() {}
+
+   // fills reduced from ev, returns kFALSE if the event should not be used for mixing
+   virtual Bool_t    Reduce(AliVEvent *ev, AliMixReducedEvent &reduced);
+
+   void        SetPtRange(Float_t min, Float_t max) { fPtMin = min; fPtMax = max; }
+   void        SetEtaRange(Float_t min, Float_t max) { fEtaMin = min; fEtaMax = max; }
+   void        SetFilterMask(UInt_t mask) { fFilterMask = mask; }
+   void        SetCentralityEstimator(const char *estimator) { fCentralityEstimator = estimator; }
+   void        SetEventPlaneMethod(const char *method, Int_t harmonic = 2) { fEventPlaneMethod = method; fEventPlaneHarmonic = harmonic; }
+
+private:
+   Float_t     fPtMin;               // minimum pt
+   Float_t     fPtMax;               // maximum pt
+   Float_t     fEtaMin;              // minimum eta
+   Float_t     fEtaMax;              // maximum eta
+   UInt_t      fFilterMask;          // filter mask required for AOD tracks (0 : no requirement, ignored for ESD)
+   TString     fCentralityEstimator; // centrality estimator (empty : no centrality)
+   TString     fEventPlaneMethod;    // AliEventplane method ("Q", "V0", "V0A", "V0C"; empty : no event plane)
+   Int_t       fEventPlaneHarmonic;  // harmonic of the event plane
+   Bool_t      fFilterMaskWarned;    //! whether the filter mask was reported as ignored for non-AOD input
+
+   ClassDef(AliMixEventReducer, 1)
+};
+
+#endif
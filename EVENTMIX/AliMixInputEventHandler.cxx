@@ -11,12 +11,14 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TMath.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventReducer.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -43,7 +45,14 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fEventReducer(0),
+   fReducedBufferSize(0),
+   fReducedBuffer(),
+   fReducedBufferNext(),
+   fReducedBufferN(),
+   fReducedMain(),
+   fReducedMixed(0)
 {
    //
    // Default constructor.
@@ -192,7 +201,10 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
-   if (!fEventPool) {
+   if (fEventReducer) {
+      MixReduced();
+   }
+   else if (!fEventPool) {
       MixStd();
    }
    // if buffer size is higher then 1
@@ -495,6 +507,92 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
    return kFALSE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::MixReduced()
+{
+   //
+   // Mix with reduced events kept in memory
+   // The main event is mixed with the last events of its pool bin (newest first,
+   // one UserExecMix per mixed event) and then added to the ring buffer of the bin
+   //
+   AliDebug(AliLog::kDebug + 5, Form("<-"));
+   AliDebug(AliLog::kDebug + 1, "Mix method");
+   // get correct handler
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain) return kFALSE;
+
+   // check for PhysSelection
+   if (!IsEventCurrentSelected()) return kFALSE;
+
+   fReducedMixed = 0;
+   fNumberMixed = 0;
+
+   // find out zero chain entries
+   Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
+   Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
+
+   // reduce main event
+   fReducedMain.Clear();
+   fReducedMain.SetEntry(currentMainEntry);
+   if (!fEventReducer->Reduce(inEvHMain->GetEvent(), fReducedMain)) {
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (not reduced) +++++++++++++++++++", fEntryCounter));
+      UserExecMixAllTasks(fEntryCounter, -1, currentMainEntry, -1, 0);
+      return kTRUE;
+   }
+
+   // find pool bin
+   Int_t idEntryList = 1;
+   Int_t numBins = 1;
+   if (fEventPool) {
+      if (!fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList)) {
+         AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (el null) +++++++++++++++++++", fEntryCounter));
+         UserExecMixAllTasks(fEntryCounter, -1, currentMainEntry, -1, 0);
+         return kTRUE;
+      }
+      numBins = fEventPool->GetListOfEntryLists()->GetEntriesFast();
+   }
+   if ((Int_t) fReducedBuffer.size() < numBins) {
+      Int_t bufferSize = fReducedBufferSize;
+      if (bufferSize <= 0) bufferSize = TMath::Max(fMixNumber, fBufferSize);
+      if (bufferSize <= 0) bufferSize = 1;
+      fReducedBuffer.resize(numBins, std::vector<AliMixReducedEvent>(bufferSize));
+      fReducedBufferNext.resize(numBins, 0);
+      fReducedBufferN.resize(numBins, 0);
+   }
+   Int_t bin = idEntryList - 1;
+   std::vector<AliMixReducedEvent> &ring = fReducedBuffer[bin];
+   Int_t ringSize = ring.size();
+   Int_t numStored = fReducedBufferN[bin];
+
+   // mix with the stored events of the bin
+   Int_t mixNum = TMath::Max(fMixNumber, fBufferSize);
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld (bin %d, stored %d) +++++++++++++++++++", fEntryCounter, bin, numStored));
+   if (!numStored || (!fDoMixIfNotEnoughEvents && numStored < mixNum)) {
+      UserExecMixAllTasks(fEntryCounter, (numStored || fDoMixIfNotEnoughEvents) ? idEntryList : -1, currentMainEntry, -1, 0);
+   } else {
+      for (Int_t counter = 0; counter < TMath::Min(mixNum, numStored); counter++) {
+         fReducedMixed = &ring[(fReducedBufferNext[bin] - 1 - counter + ringSize) % ringSize];
+         fNumberMixed++;
+         UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, fReducedMixed->GetEntry(), fNumberMixed);
+      }
+      fReducedMixed = 0;
+   }
+
+   // add main event to the buffer (memory of the overwritten event is reused)
+   ring[fReducedBufferNext[bin]] = fReducedMain;
+   fReducedBufferNext[bin] = (fReducedBufferNext[bin] + 1) % ringSize;
+   if (numStored < ringSize) fReducedBufferN[bin]++;
+
+   AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   AliDebug(AliLog::kDebug + 5, Form("->"));
+   return kTRUE;
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::FinishEvent()
 {
@@ -10,6 +10,8 @@
 #ifndef ALIMIXINPUTEVENTHANDLER_H
 #define ALIMIXINPUTEVENTHANDLER_H
 
+#include <vector>
+
 #include <TObjArray.h>
 #include <TEntryList.h>
 #include <TArrayI.h>
@@ -17,10 +19,12 @@
 #include <AliVEvent.h>
 
 #include "AliMultiInputEventHandler.h"
+#include "AliMixReducedEvent.h"
 
 class TChain;
 class TChainElement;
 class AliMixEventPool;
+class AliMixEventReducer;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
@@ -73,6 +77,16 @@ public:
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+
+   // in-memory mixing with reduced events : every event is reduced by reducer and kept
+   // in a ring buffer of bufferSize events per pool bin (0 : max(mix number, buffer size)),
+   // mixed events are taken from the buffer without reading the input chain
+   void                    SetEventReducer(AliMixEventReducer *const reducer, Int_t bufferSize = 0) { fEventReducer = reducer; fReducedBufferSize = bufferSize; }
+   AliMixEventReducer     *GetEventReducer() const { return fEventReducer; }
+   Bool_t                  IsUsingReducedEvents() const { return (fEventReducer != 0); }
+   // reduced main and mixed events (should be used in UserExecMix() only)
+   const AliMixReducedEvent *GetReducedMainEvent() const { return &fReducedMain; }
+   const AliMixReducedEvent *GetReducedMixedEvent() const { return fReducedMixed; }
 protected:
 
    TObjArray               fMixTrees;              // buffer of input handlers
@@ -100,17 +114,26 @@ private:
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
 
+   AliMixEventReducer     *fEventReducer;          // reducer of events for the in-memory mixing (0 : mixing from input chain)
+   Int_t                   fReducedBufferSize;     // number of reduced events kept per pool bin
+   std::vector<std::vector<AliMixReducedEvent> > fReducedBuffer; //! ring buffer of reduced events for every pool bin
+   std::vector<Int_t>      fReducedBufferNext;     //! next slot of the ring buffer for every pool bin
+   std::vector<Int_t>      fReducedBufferN;        //! number of events in the ring buffer for every pool bin
+   AliMixReducedEvent      fReducedMain;           //! reduced main event
+   const AliMixReducedEvent *fReducedMixed;        //! current reduced mixed event
+
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
+   virtual Bool_t          MixReduced();
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
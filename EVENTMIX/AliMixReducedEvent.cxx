@@ -0,0 +1,55 @@
+//
+// Class AliMixReducedEvent
+//
+// AliMixReducedEvent is a reduced copy of an event (event properties and
+// selected tracks as plain structures) kept in memory by
+// AliMixInputEventHandler for mixing without reading the input chain
+//
+
+#include "AliMixReducedEvent.h"
+
+ClassImp(AliMixReducedEvent)
+
+//_________________________________________________________________________________________________
+AliMixReducedEvent::AliMixReducedEvent() : TObject(),
+   fEntry(-1),
+   fZVertex(0),
+   fMultiplicity(0),
+   fCentrality(-1),
+   fEventPlane(0),
+   fTracks()
+{
+   //
+   // Default constructor
+   //
+}
+
+//_________________________________________________________________________________________________
+void AliMixReducedEvent::Clear(Option_t *)
+{
+   //
+   // Clears the event (memory of the tracks is kept for the next event)
+   //
+   fEntry = -1;
+   fZVertex = 0;
+   fMultiplicity = 0;
+   fCentrality = -1;
+   fEventPlane = 0;
+   fTracks.clear();
+}
+
+//_________________________________________________________________________________________________
+void AliMixReducedEvent::AddTrack(Float_t pt, Float_t eta, Float_t phi, Char_t charge, UInt_t filterMap, Int_t id)
+{
+   //
+   // Adds track
+   //
+   AliMixReducedTrack track;
+   track.fPt = pt;
+   track.fEta = eta;
+   track.fPhi = phi;
+   track.fCharge = charge;
+   track.fFilterMap = filterMap;
+   track.fID = id;
+   fTracks.push_back(track);
+}
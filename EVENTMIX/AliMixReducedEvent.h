@@ -0,0 +1,63 @@
+//
+// Class AliMixReducedEvent
+//
+// AliMixReducedEvent is a reduced copy of an event (event properties and
+// selected tracks as plain structures) kept in memory by
+// AliMixInputEventHandler for mixing without reading the input chain
+//
+
+#ifndef ALIMIXREDUCEDEVENT_H
+#define ALIMIXREDUCEDEVENT_H
+
+#include <vector>
+
+#include <TObject.h>
+
+struct AliMixReducedTrack {
+   Float_t     fPt;            // transverse momentum
+   Float_t     fEta;           // pseudorapidity
+   Float_t     fPhi;           // azimuthal angle
+   Char_t      fCharge;        // charge
+   UInt_t      fFilterMap;     // filter map (AOD) or user flags
+   Int_t       fID;            // track id in the original event
+};
+
+class AliMixReducedEvent : public TObject {
+public:
+   AliMixReducedEvent();
+   virtual ~AliMixReducedEvent() {}
+
+   // clears the event, keeping the memory for the tracks
+   virtual void      Clear(Option_t *option = "");
+
+   void        AddTrack(Float_t pt, Float_t eta, Float_t phi, Char_t charge, UInt_t filterMap = 0, Int_t id = -1);
+
+   void        SetEntry(Long64_t entry) { fEntry = entry; }
+   void        SetZVertex(Float_t z) { fZVertex = z; }
+   void        SetMultiplicity(Int_t mult) { fMultiplicity = mult; }
+   void        SetCentrality(Float_t cent) { fCentrality = cent; }
+   void        SetEventPlane(Float_t psi) { fEventPlane = psi; }
+
+   Long64_t    GetEntry() const { return fEntry; }
+   Float_t     GetZVertex() const { return fZVertex; }
+   Int_t       GetMultiplicity() const { return fMultiplicity; }
+   Float_t     GetCentrality() const { return fCentrality; }
+   Float_t     GetEventPlane() const { return fEventPlane; }
+
+   Int_t       GetNumberOfTracks() const { return fTracks.size(); }
+   const AliMixReducedTrack &GetTrack(Int_t i) const { return fTracks[i]; }
+   const std::vector<AliMixReducedTrack> &GetTracks() const { return fTracks; }
+
+private:
+   Long64_t    fEntry;         // entry of the event in the input chain
+   Float_t     fZVertex;       // z of the primary vertex
+   Int_t       fMultiplicity;  // multiplicity
+   Float_t     fCentrality;    // centrality percentile
+   Float_t     fEventPlane;    // event plane angle
+
+   std::vector<AliMixReducedTrack> fTracks; // selected tracks
+
+   ClassDef(AliMixReducedEvent, 1)
+};
+
+#endif
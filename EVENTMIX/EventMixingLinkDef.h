@@ -2,6 +2,9 @@
 
 #pragma link C++ class AliMixEventCutObj+;
 #pragma link C++ class AliMixEventPool+;
+#pragma link C++ class AliMixEventReducer+;
+#pragma link C++ struct AliMixReducedTrack+;
+#pragma link C++ class AliMixReducedEvent+;
 
 #pragma link C++ class AliMixInfo+;
 #pragma link C++ class AliMixInputHandlerInfo+;
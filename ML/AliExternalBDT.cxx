@@ -13,9 +13,19 @@
 #include "AliExternalBDT.h"
 
 #include <cassert>
+#include <cstdint>
+#include <fcntl.h>
 #include <iostream>
+#include <limits>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef TREELITE_BUILD_TAG
+#define TREELITE_BUILD_TAG "unknown"
+#endif
 
 namespace {
   inline bool checkFile (const std::string name) {
@@ -27,8 +37,54 @@ namespace {
       return false;
     }
   }
+
+  /// 64 bit FNV-1a, enough to address the cached libraries
+  inline void hashBytes(std::uint64_t &hash, const char *data, std::size_t size) {
+    for (std::size_t iByte = 0; iByte < size; ++iByte) {
+      hash ^= static_cast<unsigned char>(data[iByte]);
+      hash *= 1099511628211ull;
+    }
+  }
+
+  inline bool hashFile(std::uint64_t &hash, const std::string &name) {
+    FILE *file = fopen(name.c_str(), "rb");
+    if (file == NULL)
+      return false;
+    char buffer[65536];
+    std::size_t nRead = 0;
+    while ((nRead = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      hashBytes(hash, buffer, nRead);
+    }
+    fclose(file);
+    return true;
+  }
+
+  inline std::string compilerVersion() {
+    static std::string version;
+    if (!version.empty())
+      return version;
+    FILE *pipe = popen("gcc -dumpfullversion -dumpversion 2>/dev/null", "r");
+    if (pipe != NULL) {
+      char buffer[128];
+      while (fgets(buffer, sizeof(buffer), pipe) != NULL)
+        version += buffer;
+      pclose(pipe);
+    }
+    if (version.empty())
+      version = "unknown";
+    return version;
+  }
+
+  inline std::string getEnv(const char *name) {
+    const char *value = getenv(name);
+    return value ? std::string(value) : std::string();
+  }
+
+  const std::string kCompileFlags = "-O1 -fPIC";
 }
 
+std::string AliExternalBDT::fgModelCacheDir = getEnv("ALIML_MODEL_CACHE_DIR");
+
 AliExternalBDT::AliExternalBDT(std::string name) :
   fBDTname{name},
   fModel{},
@@ -37,7 +93,10 @@ AliExternalBDT::AliExternalBDT(std::string name) :
   fCompiler{},
   fPredictor{},
   fOutSize{0u},
-  fNumFeatures{0u}
+  fNumFeatures{0u},
+  fEntries{},
+  fBatchFeatures{},
+  fBatchOutput{}
 {
 }
 
@@ -48,7 +107,7 @@ bool AliExternalBDT::CompileAndLoadModelLibrary() {
     std::cout << "Library found: " << path.data() << "/main.so . Loading it!" << std::endl;
   } else {
     std::cout << "Starting the model compilation, depending on the model size it can take a while..." << std::endl;
-    system((std::string("gcc -c -O1 -fPIC ") + path + "/main.c -o " + path + "/main.o && gcc -shared " + path + \
+    system((std::string("gcc -c ") + kCompileFlags + " " + path + "/main.c -o " + path + "/main.o && gcc -shared " + path + \
           "/main.o -o " + path + "/main.so").data());
   }
   return LoadModelLibrary(path + "/main.so");
@@ -82,13 +141,7 @@ std::string AliExternalBDT::GetUniquePath() {
   }
 }
 
-bool AliExternalBDT::LoadModel(const std::string &path, int type) {
-  if (path.empty()) {
-    std::cout << "Invalid empty model path string" << std::endl;
-    return false;
-  }
-  fModelPath = path;
-  fModelName = fModelPath.substr(fModelPath.find_last_of("\\/")+1,fModelPath.size());
+bool AliExternalBDT::ReadModel(int type) {
   int status = 0;
   switch (type) {
     case 0:
@@ -105,6 +158,78 @@ bool AliExternalBDT::LoadModel(const std::string &path, int type) {
     std::cerr << "Model loading failed" << std::endl;
     return false;
   }
+  return true;
+}
+
+bool AliExternalBDT::LoadModelFromCache(int type) {
+  std::uint64_t hash = 14695981039346656037ull;
+  if (!hashFile(hash, fModelPath)) {
+    std::cerr << "Cannot read model file " << fModelPath << std::endl;
+    return false;
+  }
+  const std::string tag = std::to_string(type) + TREELITE_BUILD_TAG + compilerVersion() + kCompileFlags;
+  hashBytes(hash, tag.data(), tag.size());
+  char key[17];
+  snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+
+  mkdir(fgModelCacheDir.data(), 0755);
+  const std::string library = fgModelCacheDir + "/" + key + ".so";
+  if (checkFile(library)) {
+    std::cout << "Cached library found: " << library << " . Loading it!" << std::endl;
+    return LoadModelLibrary(library);
+  }
+
+  /// concurrent jobs on the same node wait for the one compiling the model
+  const std::string lockName = fgModelCacheDir + "/" + key + ".lock";
+  int lock = open(lockName.data(), O_CREAT | O_RDWR, 0644);
+  if (lock < 0 || flock(lock, LOCK_EX) != 0) {
+    std::cerr << "Cannot lock " << lockName << " , compiling the model without cache" << std::endl;
+    if (lock >= 0)
+      close(lock);
+    if (!ReadModel(type)) return false;
+    if (!CreateModelCode()) return false;
+    return CompileAndLoadModelLibrary();
+  }
+
+  bool status = true;
+  if (!checkFile(library)) {
+    /// build in a private directory and publish the library with an atomic rename
+    const std::string build = fgModelCacheDir + "/" + key + "_" + std::to_string(getpid());
+    status = ReadModel(type);
+    if (status) {
+      std::cout << "Starting the model compilation, depending on the model size it can take a while..." << std::endl;
+      status = (TreeliteCompilerCreate("ast_native", &fCompiler) == 0) &&
+               (TreeliteCompilerGenerateCode(fCompiler, fModel, 1, build.data()) == 0);
+      if (!status)
+        std::cerr << "Code generation failed." << std::endl;
+    }
+    if (status) {
+      status = system((std::string("gcc -c ") + kCompileFlags + " " + build + "/main.c -o " + build +
+                       "/main.o && gcc -shared " + build + "/main.o -o " + build + "/main.so").data()) == 0 &&
+               rename((build + "/main.so").data(), library.data()) == 0;
+      if (!status)
+        std::cerr << "Model compilation failed." << std::endl;
+    }
+    system((std::string("rm -rf ") + build).data());
+  }
+
+  flock(lock, LOCK_UN);
+  close(lock);
+  if (!status)
+    return false;
+  return LoadModelLibrary(library);
+}
+
+bool AliExternalBDT::LoadModel(const std::string &path, int type) {
+  if (path.empty()) {
+    std::cout << "Invalid empty model path string" << std::endl;
+    return false;
+  }
+  fModelPath = path;
+  fModelName = fModelPath.substr(fModelPath.find_last_of("\\/")+1,fModelPath.size());
+  if (!fgModelCacheDir.empty())
+    return LoadModelFromCache(type);
+  if (!ReadModel(type)) return false;
   if (!CreateModelCode()) return false;
   if (!CompileAndLoadModelLibrary()) return false;
   return true;
@@ -133,21 +258,62 @@ bool AliExternalBDT::LoadModelLibrary(std::string path) {
   return true;
 }
 
-bool AliExternalBDT::Predict(double *features, int size, std::vector<double> &outputScores, bool useRawScore) {
-  std::vector<TreelitePredictorEntry> entries(size);
-  for (std::size_t iEntry = 0; iEntry < entries.size(); ++iEntry) {
-    entries[iEntry].fvalue = static_cast<float>(features[iEntry]);
+bool AliExternalBDT::Predict(const double *features, int size, std::vector<double> &outputScores, bool useRawScore) {
+  fEntries.resize(size);
+  for (std::size_t iEntry = 0; iEntry < fEntries.size(); ++iEntry) {
+    fEntries[iEntry].fvalue = static_cast<float>(features[iEntry]);
   }
 
-  std::vector<float> output(fOutSize);
-  int predict = TreelitePredictorPredictInst(fPredictor, entries.data(),
-      static_cast<int>(useRawScore), &output[0],
-      &fOutSize);
+  fBatchOutput.resize(fOutSize);
+  std::size_t outSize = fOutSize;
+  int predict = TreelitePredictorPredictInst(fPredictor, fEntries.data(),
+      static_cast<int>(useRawScore), fBatchOutput.data(),
+      &outSize);
   if(predict<0)
     return false;
 
   for (std::size_t iEntry = 0; iEntry < fOutSize; ++iEntry) {
-    outputScores.push_back(static_cast<double>(output[iEntry]));
+    outputScores.push_back(static_cast<double>(fBatchOutput[iEntry]));
+  }
+
+  return true;
+}
+
+bool AliExternalBDT::PredictBatch(const double *features, int nRows, int nCols, std::vector<double> &outputScores,
+                                  bool useRawScore) {
+  if (nRows <= 0)
+    return true;
+  if (static_cast<std::size_t>(nCols) != fNumFeatures) {
+    std::cerr << "Number of columns (" << nCols << ") different from the number of model features ("
+              << fNumFeatures << ")" << std::endl;
+    return false;
+  }
+
+  /// the dense batch only keeps a pointer to the data, the buffer has to outlive the prediction
+  const std::size_t nValues = static_cast<std::size_t>(nRows) * nCols;
+  fBatchFeatures.resize(nValues);
+  for (std::size_t iValue = 0; iValue < nValues; ++iValue) {
+    fBatchFeatures[iValue] = static_cast<float>(features[iValue]);
+  }
+
+  DenseBatchHandle batch;
+  if (TreeliteAssembleDenseBatch(fBatchFeatures.data(), std::numeric_limits<float>::quiet_NaN(),
+                                 static_cast<std::size_t>(nRows), static_cast<std::size_t>(nCols), &batch) != 0) {
+    std::cerr << "Batch assembly failed" << std::endl;
+    return false;
+  }
+
+  std::size_t outSize = static_cast<std::size_t>(nRows) * fOutSize;
+  fBatchOutput.resize(outSize);
+  int predict = TreelitePredictorPredictBatch(fPredictor, batch, 0, 0, static_cast<int>(useRawScore),
+                                              fBatchOutput.data(), &outSize);
+  TreeliteDeleteDenseBatch(batch);
+  if (predict != 0)
+    return false;
+
+  outputScores.reserve(outputScores.size() + outSize);
+  for (std::size_t iOut = 0; iOut < outSize; ++iOut) {
+    outputScores.push_back(static_cast<double>(fBatchOutput[iOut]));
   }
 
   return true;
@@ -29,7 +29,16 @@ public:
   bool LoadModelLibrary(std::string path);
   bool LoadXGBoostModel(std::string path);
 
-  bool Predict(double *features, int size, std::vector<double> &outputScores, bool useRaw = false);
+  bool Predict(const double *features, int size, std::vector<double> &outputScores, bool useRaw = false);
+  /// predict a row-major matrix of nRows candidates with nCols features each in a single treelite call,
+  /// the nRows * GetOutputSize() scores are appended to outputScores
+  bool PredictBatch(const double *features, int nRows, int nCols, std::vector<double> &outputScores,
+                    bool useRaw = false);
+
+  /// directory where compiled model libraries are cached across jobs, keyed by model-file hash, treelite build
+  /// and compiler version. Empty disables the cache. Defaults to $ALIML_MODEL_CACHE_DIR
+  static void SetModelCacheDir(std::string dir) { fgModelCacheDir = dir; }
+  static std::string GetModelCacheDir() { return fgModelCacheDir; }
 
   std::size_t GetOutputSize() const {return fOutSize;}
   std::size_t GetNumberOfFeatures() const {return fNumFeatures;}
@@ -39,6 +48,8 @@ private:
   bool CreateModelCode();
   std::string GetUniquePath();
   bool LoadModel(const std::string &path, int type);
+  bool LoadModelFromCache(int type);
+  bool ReadModel(int type);
 
   std::string fBDTname;       /// Unique name of this external BDT handler
   ModelHandle fModel;
@@ -48,6 +59,12 @@ private:
   PredictorHandle fPredictor;
   std::size_t fOutSize;
   std::size_t fNumFeatures;
+
+  std::vector<TreelitePredictorEntry> fEntries; /// reused single candidate input buffer
+  std::vector<float> fBatchFeatures;            /// reused batch input buffer (row-major)
+  std::vector<float> fBatchOutput;              /// reused output buffer
+
+  static std::string fgModelCacheDir;           /// directory of the compiled model cache
 };
 
 #endif
@@ -29,7 +29,8 @@ ClassImp(AliMLResponse);
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse()
     : TNamed(), fConfigFilePath{}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{}, fNVariables{},
-      fBinsBegin{}, fRaw{} {
+      fBinsBegin{}, fRaw{}, fFeatureSlots{}, fFeatureBuffer{}, fScoreBuffer{}, fBatchBins{}, fBatchOffsets{},
+      fBatchOrder{}, fBatchFeatures{}, fBatchScores{} {
   //
   // Default constructor
   //
@@ -38,7 +39,8 @@ AliMLResponse::AliMLResponse()
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse(const Char_t *name, const Char_t *title)
     : TNamed(name, title), fConfigFilePath{""}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{},
-      fNVariables{}, fBinsBegin{}, fRaw{} {
+      fNVariables{}, fBinsBegin{}, fRaw{}, fFeatureSlots{}, fFeatureBuffer{}, fScoreBuffer{}, fBatchBins{},
+      fBatchOffsets{}, fBatchOrder{}, fBatchFeatures{}, fBatchScores{} {
   //
   // Standard constructor
   //
@@ -55,7 +57,9 @@ AliMLResponse::~AliMLResponse() {
 AliMLResponse::AliMLResponse(const AliMLResponse &source)
     : TNamed(source.GetName(), source.GetTitle()), fConfigFilePath{source.fConfigFilePath}, fModels{source.fModels},
       fCentClasses{source.fCentClasses}, fBins{source.fBins}, fVariableNames{source.fVariableNames},
-      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{source.fBinsBegin}, fRaw{source.fRaw} {
+      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{source.fBinsBegin}, fRaw{source.fRaw},
+      fFeatureSlots{source.fFeatureSlots}, fFeatureBuffer(source.fFeatureBuffer.size()), fScoreBuffer{},
+      fBatchBins{}, fBatchOffsets{}, fBatchOrder{}, fBatchFeatures{}, fBatchScores{} {
   //
   // Copy constructor
   //
@@ -78,6 +82,8 @@ AliMLResponse &AliMLResponse::operator=(const AliMLResponse &source) {
   fNVariables     = source.fNVariables;
   fBinsBegin      = source.fBinsBegin;
   fRaw            = source.fRaw;
+  fFeatureSlots   = source.fFeatureSlots;
+  fFeatureBuffer.assign(source.fFeatureBuffer.size(), 0.);
 
   return *this;
 }
@@ -120,6 +126,13 @@ void AliMLResponse::CompileModels(std::string configLocalPath) {
 
   fBinsBegin = fBins.begin();
 
+  /// bind each feature name to its slot once, the per-candidate path only works with indices
+  fFeatureSlots.clear();
+  for (int iVar = 0; iVar < (int)fVariableNames.size(); ++iVar) {
+    fFeatureSlots[fVariableNames[iVar]] = iVar;
+  }
+  fFeatureBuffer.assign(fNVariables, 0.);
+
   for (const auto &model : nodeList["MODELS"]) {
     fModels.push_back(AliMLModelHandler{model});
   }
@@ -157,33 +170,60 @@ int AliMLResponse::FindBin(double binvar) {
 }
 
 //_______________________________________________________________________________
-double AliMLResponse::Predict(double binvar, map<string, double> varmap) {
-  if ((int)varmap.size() < fNVariables) {
-    AliFatal("The variable map you provided to the predictor has a size smaller than the variable list size! Exit");
-  }
+int AliMLResponse::GetFeatureIndex(const std::string &name) const {
+  auto slot = fFeatureSlots.find(name);
+  if (slot == fFeatureSlots.end())
+    return -1;
+  return slot->second;
+}
 
-  vector<double> features;
-  for (const auto &varname : fVariableNames) {
-    if (varmap.find(varname) == varmap.end()) {
-      AliFatal(Form("Variable |%s| not found in variable list provided in config! Exit", varname.data()));
+//_______________________________________________________________________________
+void AliMLResponse::FillFeatureBuffer(const map<string, double> &varmap) {
+  for (const auto &slot : fFeatureSlots) {
+    auto var = varmap.find(slot.first);
+    if (var == varmap.end()) {
+      AliFatal(Form("Variable |%s| not found in variable list provided in config! Exit", slot.first.data()));
     }
-    features.push_back(varmap[varname]);
+    fFeatureBuffer[slot.second] = var->second;
   }
+}
 
+//_______________________________________________________________________________
+double AliMLResponse::PredictFromBuffer(double binvar) {
   int bin = FindBin(binvar);
   if (bin < 0)
     return -999.;
 
-  vector<double> scores;
-  bool predict = fModels.at(bin - 1).GetModel()->Predict(&features[0], fNVariables, scores, fRaw);
+  fScoreBuffer.clear();
+  bool predict = fModels.at(bin - 1).GetModel()->Predict(fFeatureBuffer.data(), fNVariables, fScoreBuffer, fRaw);
   if(!predict)
     return -999.;
 
-  return scores[0];
+  return fScoreBuffer[0];
+}
+
+//_______________________________________________________________________________
+bool AliMLResponse::PredictMultiClassFromBuffer(double binvar, vector<double> &outScores) {
+  int bin = FindBin(binvar);
+  if (bin < 0)
+    return false;
+
+  return fModels.at(bin - 1).GetModel()->Predict(fFeatureBuffer.data(), fNVariables, outScores, fRaw);
+}
+
+//_______________________________________________________________________________
+double AliMLResponse::Predict(double binvar, const map<string, double> &varmap) {
+  if ((int)varmap.size() < fNVariables) {
+    AliFatal("The variable map you provided to the predictor has a size smaller than the variable list size! Exit");
+  }
+
+  FillFeatureBuffer(varmap);
+
+  return PredictFromBuffer(binvar);
 }
 
 //_______________________________________________________________________________
-double AliMLResponse::Predict(double binvar, vector<double> variables) {
+double AliMLResponse::Predict(double binvar, const vector<double> &variables) {
   if ((int)variables.size() != fNVariables) {
     AliFatal(Form("Number of variables passed (%d) different from the one used in the model (%d)! Exit",
                   (int)variables.size(), fNVariables));
@@ -193,37 +233,84 @@ double AliMLResponse::Predict(double binvar, vector<double> variables) {
   if (bin < 0)
     return -999.;
 
-  vector<double> scores;
-  bool predict = fModels.at(bin - 1).GetModel()->Predict(&variables[0], fNVariables, scores, fRaw);
+  fScoreBuffer.clear();
+  bool predict = fModels.at(bin - 1).GetModel()->Predict(variables.data(), fNVariables, fScoreBuffer, fRaw);
   if(!predict)
     return -999.;
 
-  return scores[0];
+  return fScoreBuffer[0];
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::PredictMultiClass(double binvar, map<string, double> varmap, vector<double> &outScores) {
-  if ((int)varmap.size() < fNVariables) {
-    AliFatal("The variable map you provided to the predictor has a size smaller than the variable list size! Exit");
+bool AliMLResponse::PredictBatch(const double *binvars, const double *features, int nCandidates,
+                                 vector<double> &outScores) {
+  outScores.assign(nCandidates, -999.);
+  if (nCandidates <= 0)
+    return true;
+
+  /// group the candidates by bin (counting sort), so that each model is called once per batch
+  const int nModels = fModels.size();
+  fBatchBins.resize(nCandidates);
+  fBatchOffsets.assign(nModels + 1, 0);
+  for (int iCand = 0; iCand < nCandidates; ++iCand) {
+    int bin = FindBin(binvars[iCand]);
+    fBatchBins[iCand] = bin;
+    if (bin > 0)
+      ++fBatchOffsets[bin - 1];
+  }
+  for (int iModel = 1; iModel < nModels; ++iModel)
+    fBatchOffsets[iModel] += fBatchOffsets[iModel - 1];
+  fBatchOffsets[nModels] = nModels > 0 ? fBatchOffsets[nModels - 1] : 0;
+
+  /// after this loop fBatchOffsets[iModel] points to the first candidate of model iModel
+  fBatchOrder.resize(fBatchOffsets[nModels]);
+  for (int iCand = nCandidates - 1; iCand >= 0; --iCand) {
+    if (fBatchBins[iCand] > 0)
+      fBatchOrder[--fBatchOffsets[fBatchBins[iCand] - 1]] = iCand;
   }
 
-  vector<double> features;
-  for (const auto &varname : fVariableNames) {
-    if (varmap.find(varname) == varmap.end()) {
-      AliFatal(Form("Variable |%s| not found in variable list provided in config! Exit", varname.data()));
+  bool status = true;
+  for (int iModel = 0; iModel < nModels; ++iModel) {
+    const int first = fBatchOffsets[iModel];
+    const int nRows = fBatchOffsets[iModel + 1] - first;
+    if (nRows == 0)
+      continue;
+
+    fBatchFeatures.resize(nRows * fNVariables);
+    for (int iRow = 0; iRow < nRows; ++iRow) {
+      const double *row = features + (std::size_t)fBatchOrder[first + iRow] * fNVariables;
+      std::copy(row, row + fNVariables, fBatchFeatures.begin() + iRow * fNVariables);
+    }
+
+    AliExternalBDT *model = fModels[iModel].GetModel();
+    fBatchScores.clear();
+    if (!model->PredictBatch(fBatchFeatures.data(), nRows, fNVariables, fBatchScores, fRaw)) {
+      status = false;
+      continue;
+    }
+
+    const std::size_t outSize = model->GetOutputSize();
+    for (int iRow = 0; iRow < nRows; ++iRow) {
+      outScores[fBatchOrder[first + iRow]] = fBatchScores[iRow * outSize];
     }
-    features.push_back(varmap[varname]);
   }
 
-  int bin = FindBin(binvar);
-  if (bin < 0)
-    return false;
+  return status;
+}
+
+//_______________________________________________________________________________
+bool AliMLResponse::PredictMultiClass(double binvar, const map<string, double> &varmap, vector<double> &outScores) {
+  if ((int)varmap.size() < fNVariables) {
+    AliFatal("The variable map you provided to the predictor has a size smaller than the variable list size! Exit");
+  }
 
-  return fModels.at(bin - 1).GetModel()->Predict(&features[0], fNVariables, outScores, fRaw);
+  FillFeatureBuffer(varmap);
+
+  return PredictMultiClassFromBuffer(binvar, outScores);
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::PredictMultiClass(double binvar, vector<double> variables, vector<double> &outScores) {
+bool AliMLResponse::PredictMultiClass(double binvar, const vector<double> &variables, vector<double> &outScores) {
   if ((int)variables.size() != fNVariables) {
     AliFatal(Form("Number of variables passed (%d) different from the one used in the model (%d)! Exit",
                   (int)variables.size(), fNVariables));
@@ -233,29 +320,35 @@ bool AliMLResponse::PredictMultiClass(double binvar, vector<double> variables, v
   if (bin < 0)
     return false;
 
-  return fModels.at(bin - 1).GetModel()->Predict(&variables[0], fNVariables, outScores, fRaw);
+  return fModels.at(bin - 1).GetModel()->Predict(variables.data(), fNVariables, outScores, fRaw);
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelected(double binvar, map<std::string, double> varmap) {
+bool AliMLResponse::IsSelected(double binvar, const map<std::string, double> &varmap) {
   double score{0.};
   return IsSelected(binvar, varmap, score);
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelected(double binvar, vector<double> variables) {
+bool AliMLResponse::IsSelectedFromBuffer(double binvar) {
+  double score{0.};
+  return IsSelectedFromBuffer(binvar, score);
+}
+
+//_______________________________________________________________________________
+bool AliMLResponse::IsSelected(double binvar, const vector<double> &variables) {
   double score{0.};
   return IsSelected(binvar, variables, score);
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelectedMultiClass(double binvar, map<std::string, double> varmap) {
+bool AliMLResponse::IsSelectedMultiClass(double binvar, const map<std::string, double> &varmap) {
   vector<double> score;
   return IsSelectedMultiClass(binvar, varmap, score);
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelectedMultiClass(double binvar, vector<double> variables) {
+bool AliMLResponse::IsSelectedMultiClass(double binvar, const vector<double> &variables) {
   vector<double> score;
   return IsSelectedMultiClass(binvar, variables, score);
 }
\ No newline at end of file
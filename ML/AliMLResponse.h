@@ -48,32 +48,56 @@ public:
 
   /// return the bin index
   int FindBin(double binvar);
+
+  /// feature binding: the slot of each feature is resolved once when the models are compiled, the features of a
+  /// candidate are then written by index in a reusable buffer and evaluated without any string lookup
+  /// return the slot of the feature in the buffer (-1 if the feature is not used by the models)
+  int GetFeatureIndex(const std::string &name) const;
+  /// set the value of the feature in slot index for the next candidate
+  void SetFeature(int index, double value) { fFeatureBuffer[index] = value; }
+  /// direct access to the feature buffer (fNVariables values)
+  double *GetFeatureBuffer() { return fFeatureBuffer.data(); }
+  /// return the ML model predicted score for the features stored in the buffer
+  double PredictFromBuffer(double binvar);
+  /// return true if predicted score for the features stored in the buffer is above the threshold
+  bool IsSelectedFromBuffer(double binvar);
+  /// overload for getting the model score too
+  template <typename F> bool IsSelectedFromBuffer(double binvar, F &score);
+  /// return the ML model predicted scores for the features stored in the buffer
+  bool PredictMultiClassFromBuffer(double binvar, std::vector<double> &outScores);
+
   /// return the ML model predicted score (raw or proba, depending on useraw)
-  double Predict(double binvar, std::map<std::string, double> varmap);
+  double Predict(double binvar, const std::map<std::string, double> &varmap);
   /// overload to pass directly a vector of variables
-  double Predict(double binvar, std::vector<double> variables);
+  double Predict(double binvar, const std::vector<double> &variables);
+  /// batch prediction: features is a row-major nCandidates x fNVariables matrix, binvars holds the binned
+  /// variable of each candidate. outScores gets one score per candidate (-999 if outside the bin range)
+  bool PredictBatch(const double *binvars, const double *features, int nCandidates, std::vector<double> &outScores);
   /// return true if predicted score for map is above the threshold given in the config
-  bool IsSelected(double binvar, std::map<std::string, double> varmap);
+  bool IsSelected(double binvar, const std::map<std::string, double> &varmap);
   /// overload for getting the model score too
-  template <typename F> bool IsSelected(double binvar, std::map<std::string, double> varmap, F &score);
+  template <typename F> bool IsSelected(double binvar, const std::map<std::string, double> &varmap, F &score);
   /// overload to pass directly a vector of variables
-  bool IsSelected(double binvar, std::vector<double> variables);
+  bool IsSelected(double binvar, const std::vector<double> &variables);
   /// overload for getting the model score too
-  template <typename F> bool IsSelected(double binvar, std::vector<double> variables, F &score);
+  template <typename F> bool IsSelected(double binvar, const std::vector<double> &variables, F &score);
   /// return the ML model predicted scores (raw or proba, depending on useraw)
-  bool PredictMultiClass(double binvar, std::map<std::string, double> varmap, std::vector<double> &outScores);
+  bool PredictMultiClass(double binvar, const std::map<std::string, double> &varmap, std::vector<double> &outScores);
   /// overload to pass directly a vector of variables
-  bool PredictMultiClass(double binvar, std::vector<double> variables, std::vector<double> &outScores);
+  bool PredictMultiClass(double binvar, const std::vector<double> &variables, std::vector<double> &outScores);
   /// return true if predicted score for map is above the threshold given in the config
-  bool IsSelectedMultiClass(double binvar, std::map<std::string, double> varmap);
+  bool IsSelectedMultiClass(double binvar, const std::map<std::string, double> &varmap);
   /// overload for getting the model score too
-  template <typename F> bool IsSelectedMultiClass(double binvar, std::map<std::string, double> varmap, std::vector<F> &outScores);
+  template <typename F> bool IsSelectedMultiClass(double binvar, const std::map<std::string, double> &varmap, std::vector<F> &outScores);
   /// overload to pass directly a vector of variables
-  bool IsSelectedMultiClass(double binvar, std::vector<double> variables);
+  bool IsSelectedMultiClass(double binvar, const std::vector<double> &variables);
   /// overload for getting the model score too
-  template <typename F> bool IsSelectedMultiClass(double binvar, std::vector<double> variables, std::vector<F> &outScores);
+  template <typename F> bool IsSelectedMultiClass(double binvar, const std::vector<double> &variables, std::vector<F> &outScores);
 
 protected:
+  /// copy the features of a name <-> value map in the feature buffer
+  void FillFeatureBuffer(const std::map<std::string, double> &varmap);
+
   std::string fConfigFilePath;    /// path of the config file
 
   std::vector<AliMLModelHandler> fModels;     //!<! vector of models
@@ -88,12 +112,22 @@ protected:
 
   bool fRaw;    /// set to true to use raw score instead of probability
 
+  std::map<std::string, int> fFeatureSlots;   //!<! slot of each feature in fFeatureBuffer
+  std::vector<double> fFeatureBuffer;         //!<! features of the current candidate, ordered as fVariableNames
+  std::vector<double> fScoreBuffer;           //!<! reused buffer for the model output
+
+  std::vector<int> fBatchBins;          //!<! bin of each candidate in the current batch
+  std::vector<int> fBatchOffsets;       //!<! first sorted candidate of each bin in the current batch
+  std::vector<int> fBatchOrder;         //!<! candidate indices sorted by bin
+  std::vector<double> fBatchFeatures;   //!<! features of the candidates of one bin (row-major)
+  std::vector<double> fBatchScores;     //!<! scores of the candidates of one bin
+
   /// \cond CLASSIMP
   ClassDef(AliMLResponse, 2);    ///
   /// \endcond
 };
 
-template <typename F> bool AliMLResponse::IsSelected(double binvar, std::map<std::string, double> varmap, F &score) {
+template <typename F> bool AliMLResponse::IsSelected(double binvar, const std::map<std::string, double> &varmap, F &score) {
   int bin = FindBin(binvar);
   if (bin < 0)
     return false;
@@ -101,7 +135,15 @@ template <typename F> bool AliMLResponse::IsSelected(double binvar, std::map<std
   return score >= fModels.at(bin - 1).GetScoreCut()[0];
 }
 
-template <typename F> bool AliMLResponse::IsSelected(double binvar, std::vector<double> variables, F &score) {
+template <typename F> bool AliMLResponse::IsSelectedFromBuffer(double binvar, F &score) {
+  int bin = FindBin(binvar);
+  if (bin < 0)
+    return false;
+  score = PredictFromBuffer(binvar);
+  return score >= fModels.at(bin - 1).GetScoreCut()[0];
+}
+
+template <typename F> bool AliMLResponse::IsSelected(double binvar, const std::vector<double> &variables, F &score) {
   int bin = FindBin(binvar);
   if (bin < 0)
     return false;
@@ -109,7 +151,7 @@ template <typename F> bool AliMLResponse::IsSelected(double binvar, std::vector<
   return score >= fModels.at(bin - 1).GetScoreCut()[0];
 }
 
-template <typename F> bool AliMLResponse::IsSelectedMultiClass(double binvar, std::map<std::string, double> varmap, std::vector<F> &outScores) {
+template <typename F> bool AliMLResponse::IsSelectedMultiClass(double binvar, const std::map<std::string, double> &varmap, std::vector<F> &outScores) {
   int bin = FindBin(binvar);
   if (bin < 0)
     return false;
@@ -128,7 +170,7 @@ template <typename F> bool AliMLResponse::IsSelectedMultiClass(double binvar, st
   return true;
 }
 
-template <typename F> bool AliMLResponse::IsSelectedMultiClass(double binvar, std::vector<double> variables, std::vector<F> &outScores) {
+template <typename F> bool AliMLResponse::IsSelectedMultiClass(double binvar, const std::vector<double> &variables, std::vector<F> &outScores) {
   int bin = FindBin(binvar);
   if (bin < 0)
     return false;
@@ -0,0 +1,306 @@
+// Copyright CERN. This software is distributed under the terms of the GNU
+// General Public License v3 (GPL Version 3).
+//
+// See http://www.gnu.org/licenses/ for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_prediction.cxx
+/// \brief Inference micro-benchmark for AliExternalBDT and AliMLResponse.
+///
+/// Synthetic LightGBM forests with the feature counts and depths of the HF
+/// configurations are written and compiled with treelite, real XGBoost /
+/// LightGBM models can be added from the command line. For every model the
+/// single candidate and the batch paths are timed, and the candidates/s and
+/// heap allocations per call are printed. The allocations are counted with the
+/// glibc malloc hook installed only around one untimed call, and are reported
+/// as n/a where the hook is not available (glibc >= 2.34, macOS). With --reference the throughput is
+/// compared to a previous run and the program fails if it dropped by more
+/// than --threshold.
+///
+/// Usage: mlbenchmark [--xgboost file] [--lightgbm file] [--library file]
+///                    [--rows N] [--reference file] [--write-reference file]
+///                    [--threshold fraction]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__) && (__GLIBC__ == 2 && __GLIBC_MINOR__ < 34)
+#define ML_BENCHMARK_MALLOC_HOOK
+#include <malloc.h>
+#endif
+
+#include "AliExternalBDT.h"
+#include "AliMLResponse.h"
+
+namespace {
+
+/// Counts the heap allocations (malloc, and operator new through it) made in its scope.
+/// The hook is installed by the constructor and removed by the destructor, so the
+/// allocations of the program outside of the scope are not affected. Not thread safe.
+class ScopedAllocationCounter {
+public:
+  ScopedAllocationCounter() {
+#ifdef ML_BENCHMARK_MALLOC_HOOK
+    fgCount = 0;
+    fgPreviousHook = __malloc_hook;
+    __malloc_hook = &Hook;
+#endif
+  }
+  ~ScopedAllocationCounter() {
+#ifdef ML_BENCHMARK_MALLOC_HOOK
+    __malloc_hook = fgPreviousHook;
+#endif
+  }
+  ScopedAllocationCounter(const ScopedAllocationCounter &) = delete;
+  ScopedAllocationCounter &operator=(const ScopedAllocationCounter &) = delete;
+
+  /// number of allocations since the construction, -1 if they cannot be counted
+  long GetCount() const {
+#ifdef ML_BENCHMARK_MALLOC_HOOK
+    return fgCount;
+#else
+    return -1;
+#endif
+  }
+
+private:
+#ifdef ML_BENCHMARK_MALLOC_HOOK
+  static void *Hook(std::size_t size, const void *) {
+    __malloc_hook = fgPreviousHook;
+    ++fgCount;
+    void *ptr = std::malloc(size);
+    __malloc_hook = &Hook;
+    return ptr;
+  }
+  static long fgCount;
+  static void *(*fgPreviousHook)(std::size_t, const void *);
+#endif
+};
+
+#ifdef ML_BENCHMARK_MALLOC_HOOK
+long ScopedAllocationCounter::fgCount = 0;
+void *(*ScopedAllocationCounter::fgPreviousHook)(std::size_t, const void *) = nullptr;
+#endif
+
+struct Result {
+  std::string name;
+  double candPerSec;
+  double allocPerCall;
+};
+
+/// full binary LightGBM trees of given depth on random features, in the LightGBM text format
+void WriteLightGBMModel(const std::string &path, int nFeatures, int nTrees, int depth, unsigned int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> feature(0, nFeatures - 1);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  const int nInternal = (1 << depth) - 1;
+  const int nLeaves = 1 << depth;
+
+  auto child = [&](int node) { return node < nInternal ? node : -(node - nInternal) - 1; };
+  std::ostringstream trees;
+  for (int iTree = 0; iTree < nTrees; ++iTree) {
+    std::ostringstream split, threshold, gain, decision, left, right, leaves, counts, internal, internalCounts;
+    for (int iNode = 0; iNode < nInternal; ++iNode) {
+      split << (iNode ? " " : "") << feature(gen);
+      threshold << (iNode ? " " : "") << uniform(gen);
+      gain << (iNode ? " " : "") << 1;
+      decision << (iNode ? " " : "") << 2;
+      left << (iNode ? " " : "") << child(2 * iNode + 1);
+      right << (iNode ? " " : "") << child(2 * iNode + 2);
+      internal << (iNode ? " " : "") << 0;
+      internalCounts << (iNode ? " " : "") << 100;
+    }
+    for (int iLeaf = 0; iLeaf < nLeaves; ++iLeaf) {
+      leaves << (iLeaf ? " " : "") << (uniform(gen) - 0.5) * 0.1;
+      counts << (iLeaf ? " " : "") << 10;
+    }
+    trees << "Tree=" << iTree << "\nnum_leaves=" << nLeaves << "\nnum_cat=0\nsplit_feature=" << split.str()
+          << "\nsplit_gain=" << gain.str() << "\nthreshold=" << threshold.str() << "\ndecision_type=" << decision.str()
+          << "\nleft_child=" << left.str() << "\nright_child=" << right.str() << "\nleaf_value=" << leaves.str()
+          << "\nleaf_count=" << counts.str() << "\ninternal_value=" << internal.str()
+          << "\ninternal_count=" << internalCounts.str() << "\nshrinkage=1\n\n\n";
+  }
+
+  std::ofstream out(path);
+  out << "tree\nversion=v2\nnum_class=1\nnum_tree_per_iteration=1\nlabel_index=0\nmax_feature_idx=" << nFeatures - 1
+      << "\nobjective=binary sigmoid:1\nfeature_names=";
+  for (int iFeat = 0; iFeat < nFeatures; ++iFeat)
+    out << (iFeat ? " " : "") << "f" << iFeat;
+  out << "\nfeature_infos=";
+  for (int iFeat = 0; iFeat < nFeatures; ++iFeat)
+    out << (iFeat ? " " : "") << "[0:1]";
+  out << "\n\n" << trees.str() << "end of trees\n";
+}
+
+template <typename F> Result Time(const std::string &name, int nCandidates, int nCalls, F call) {
+  call(); // warm up, buffers are sized here
+  auto start = std::chrono::steady_clock::now();
+  for (int iCall = 0; iCall < nCalls; ++iCall)
+    call();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  // allocations of one call after the timing, the hook slows down the allocations
+  long allocations = 0;
+  {
+    ScopedAllocationCounter counter;
+    call();
+    allocations = counter.GetCount();
+  }
+
+  Result result{name, nCandidates * nCalls / elapsed.count(), double(allocations)};
+  if (allocations < 0)
+    printf("%-40s %14.0f cand/s %8s alloc/call\n", name.data(), result.candPerSec, "n/a");
+  else
+    printf("%-40s %14.0f cand/s %8.0f alloc/call\n", name.data(), result.candPerSec, result.allocPerCall);
+  return result;
+}
+
+void BenchmarkModel(AliExternalBDT &bdt, const std::string &name, int nRows, std::vector<Result> &results) {
+  const int nFeatures = bdt.GetNumberOfFeatures();
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::vector<double> features(nRows * nFeatures);
+  for (auto &feature : features)
+    feature = uniform(gen);
+
+  std::vector<double> scores;
+  scores.reserve(nRows * bdt.GetOutputSize());
+  results.push_back(Time(name + "_single", nRows, 5, [&]() {
+    for (int iRow = 0; iRow < nRows; ++iRow) {
+      scores.clear();
+      bdt.Predict(&features[iRow * nFeatures], nFeatures, scores);
+    }
+  }));
+  results.push_back(Time(name + "_batch", nRows, 5, [&]() {
+    scores.clear();
+    bdt.PredictBatch(features.data(), nRows, nFeatures, scores);
+  }));
+}
+
+/// AliMLResponse on a one-bin configuration, through the feature buffer and the batch path
+void BenchmarkResponse(const std::string &model, int nFeatures, const std::string &name, int nRows,
+                       std::vector<Result> &results) {
+  const std::string config = name + ".yml";
+  std::ofstream out(config);
+  out << "BINS: [0., 100.]\nN_MODELS: 1\nNUM_VAR: " << nFeatures << "\nVAR_NAMES: [";
+  for (int iFeat = 0; iFeat < nFeatures; ++iFeat)
+    out << (iFeat ? ", " : "") << "f" << iFeat;
+  out << "]\nRAW_SCORE: false\nMODELS:\n  - path: " << model << "\n    library: kLightGBM\n    cut: 0.5\n";
+  out.close();
+
+  AliMLResponse response("benchmark", "benchmark");
+  response.CompileModels(config);
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::vector<double> features(nRows * nFeatures), binvars(nRows), scores;
+  for (auto &feature : features)
+    feature = uniform(gen);
+  for (auto &binvar : binvars)
+    binvar = 100. * uniform(gen);
+
+  std::vector<int> slots;
+  for (int iFeat = 0; iFeat < nFeatures; ++iFeat)
+    slots.push_back(response.GetFeatureIndex("f" + std::to_string(iFeat)));
+  results.push_back(Time(name + "_response_buffer", nRows, 5, [&]() {
+    for (int iRow = 0; iRow < nRows; ++iRow) {
+      for (int iFeat = 0; iFeat < nFeatures; ++iFeat)
+        response.SetFeature(slots[iFeat], features[iRow * nFeatures + iFeat]);
+      response.PredictFromBuffer(binvars[iRow]);
+    }
+  }));
+  results.push_back(Time(name + "_response_batch", nRows, 5, [&]() {
+    response.PredictBatch(binvars.data(), features.data(), nRows, scores);
+  }));
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  std::map<std::string, std::string> options{{"--rows", "10000"}, {"--threshold", "0.2"}};
+  for (int iArg = 1; iArg + 1 < argc; iArg += 2)
+    options[argv[iArg]] = argv[iArg + 1];
+  const int nRows = std::stoi(options["--rows"]);
+  const double threshold = std::stod(options["--threshold"]);
+
+  std::vector<Result> results;
+
+  /// feature counts and depths of the HF configurations (D mesons, Ds, Lc)
+  const int configs[][3] = {{8, 100, 3}, {12, 500, 4}, {20, 1000, 6}};
+  for (const auto &config : configs) {
+    const std::string name = "lgbm_f" + std::to_string(config[0]) + "_t" + std::to_string(config[1]) + "_d" +
+                             std::to_string(config[2]);
+    WriteLightGBMModel(name + ".txt", config[0], config[1], config[2], 1234u);
+    AliExternalBDT bdt(name);
+    if (!bdt.LoadLightGBMModel(name + ".txt")) {
+      std::cerr << "Cannot load " << name << std::endl;
+      return 1;
+    }
+    BenchmarkModel(bdt, name, nRows, results);
+
+    /// the library compiled by the first load, loaded as a precompiled model
+    const std::string libraryPath = name + "_" + name + ".txt/main.so";
+    AliExternalBDT library(name + "_lib");
+    if (std::ifstream(libraryPath).good() && library.LoadModelLibrary(libraryPath))
+      BenchmarkModel(library, name + "_library", nRows, results);
+
+    BenchmarkResponse(name + ".txt", config[0], name, nRows, results);
+  }
+
+  if (options.count("--xgboost")) {
+    AliExternalBDT bdt("bench_xgboost");
+    if (bdt.LoadXGBoostModel(options["--xgboost"]))
+      BenchmarkModel(bdt, "xgboost", nRows, results);
+  }
+  if (options.count("--lightgbm")) {
+    AliExternalBDT bdt("bench_lightgbm");
+    if (bdt.LoadLightGBMModel(options["--lightgbm"]))
+      BenchmarkModel(bdt, "lightgbm", nRows, results);
+  }
+  if (options.count("--library")) {
+    AliExternalBDT bdt("bench_library");
+    if (bdt.LoadModelLibrary(options["--library"]))
+      BenchmarkModel(bdt, "library", nRows, results);
+  }
+
+  if (options.count("--write-reference")) {
+    std::ofstream out(options["--write-reference"]);
+    for (const auto &result : results)
+      out << result.name << " " << result.candPerSec << "\n";
+  }
+
+  int status = 0;
+  if (options.count("--reference")) {
+    std::ifstream in(options["--reference"]);
+    std::map<std::string, double> reference;
+    std::string line, name;
+    double candPerSec;
+    while (std::getline(in, line)) {
+      /// "name candidates/s" per line, lines starting with # are comments
+      std::istringstream fields(line);
+      if (line.empty() || line[0] == '#' || !(fields >> name >> candPerSec))
+        continue;
+      reference[name] = candPerSec;
+    }
+    for (const auto &result : results) {
+      if (reference.count(result.name) && result.candPerSec < (1. - threshold) * reference[result.name]) {
+        printf("REGRESSION %s: %.0f cand/s, reference %.0f cand/s\n", result.name.data(), result.candPerSec,
+               reference[result.name]);
+        status = 1;
+      }
+    }
+  }
+
+  std::cout << (status ? "BENCHMARK: Fail!" : "BENCHMARK: Success!") << std::endl;
+  return status;
+}
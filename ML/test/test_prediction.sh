@@ -8,3 +8,6 @@ curl http://personalpages.to.infn.it/~fecchio/test_extBDT/test_tree_pt8_12.root
 curl http://personalpages.to.infn.it/~fecchio/test_extBDT/xgboost_pred.txt -o ${DIRPATH}/xgboost_pred.txt
 
 root -q -b -l ../macros/test_AliEsternalBDT.cc\(\"${DIRPATH}\"\)
+
+# throughput of the single candidate and batch paths, add "--reference <file>" to check for regressions
+mlbenchmark --xgboost ${DIRPATH}/test_xgboost_pt8_12.model
@@ -26,6 +26,7 @@
 #include <TMath.h>
 #include <TRandom.h>
 #include <TChain.h>
+#include <TChainElement.h>
 #include <TGrid.h>
 #include <TGridResult.h>
 #include <TSystem.h>
@@ -35,6 +36,7 @@
 #include <TH1F.h>
 #include <TRandom3.h>
 #include <TList.h>
+#include <TROOT.h>
 
 #include <AliLog.h>
 #include <AliAnalysisManager.h>
@@ -51,6 +53,7 @@
 #include "AliYAMLConfiguration.h"
 #include "AliEmcalList.h"
 #include "AliEmcalContainerUtils.h"
+#include "AliEmcalEmbeddingFilePrefetcher.h"
 
 #include "AliAnalysisTaskEmcalEmbeddingHelper.h"
 
@@ -173,7 +176,14 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fPrefetchFiles(0),
+  fPrefetchDirectory("."),
+  fPrefetcher(nullptr),
+  fPrefetchedPosition(-1),
+  fPrefetchedRemoteFile(),
+  fPrefetchedLocalPaths(),
+  fPrefetchedXSecFile()
 {
   if (fgInstance != nullptr) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -250,7 +260,14 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fPrefetchFiles(0),
+  fPrefetchDirectory("."),
+  fPrefetcher(nullptr),
+  fPrefetchedPosition(-1),
+  fPrefetchedRemoteFile(),
+  fPrefetchedLocalPaths(),
+  fPrefetchedXSecFile()
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -278,6 +295,8 @@ AliAnalysisTaskEmcalEmbeddingHelper::~AliAnalysisTaskEmcalEmbeddingHelper()
     fExternalFile->Close();
     delete fExternalFile;
   }
+  if (fPrefetcher) delete fPrefetcher;
+  ReleasePrefetchedFile();
 }
 
 bool AliAnalysisTaskEmcalEmbeddingHelper::Initialize(bool removeDummyTask)
@@ -336,6 +355,8 @@ void AliAnalysisTaskEmcalEmbeddingHelper::RetrieveTaskPropertiesFromYAMLConfig()
   res = fYAMLConfig.GetProperty("randomFileAccess", fRandomFileAccess, false);
   res = fYAMLConfig.GetProperty("createHisto", fCreateHisto, false);
   res = fYAMLConfig.GetProperty("printTimingInfoInLog", fPrintTimingInfoToLog, false);
+  res = fYAMLConfig.GetProperty("prefetchFiles", fPrefetchFiles, false);
+  res = fYAMLConfig.GetProperty("prefetchDirectory", fPrefetchDirectory, false);
   // More general embedding helper properties
   res = fYAMLConfig.GetProperty("filePattern", fFilePattern, false);
   res = fYAMLConfig.GetProperty("inputFilename", fInputFilename, false);
@@ -1204,6 +1225,12 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::InitEvent()
  */
 void AliAnalysisTaskEmcalEmbeddingHelper::UserCreateOutputObjects()
 {
+  // The file prefetcher copies files with ROOT I/O in a background thread. Thread safety has to be
+  // enabled before the analysis starts, also if the embedding is only set up in UserExec().
+  if (fPrefetchFiles > 0) {
+    ROOT::EnableThreadSafety();
+  }
+
   if ( fEmbeddedRunblock.size() == 0 ) {
     SetupEmbedding();
   }
@@ -1514,6 +1541,12 @@ void AliAnalysisTaskEmcalEmbeddingHelper::SetupEmbedding()
   if (fRandomEventNumberAccess) {
     AliInfo("Random event number access enabled!");
   }
+
+  // Copy the next files to local disk while embedding
+  if (fPrefetchFiles > 0) {
+    AliInfoStream() << "Prefetching " << fPrefetchFiles << " files to \"" << fPrefetchDirectory << "\".\n";
+    fPrefetcher = new AliEmcalEmbeddingFilePrefetcher(fPrefetchDirectory, fPrefetchFiles);
+  }
   
   fInitializedEmbedding = kTRUE;
 }
@@ -1540,6 +1573,10 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   // (it is inaccessible otherwise).
   // Since fUpperEntry is the total number of entries, loading it will retrieve the
   // next tree (in the next file) since entries are indexed starting from 0.
+  // If the next file was prefetched, the local copy is opened instead.
+  if (fPrefetcher) {
+    UsePrefetchedFile(fUpperEntry > 0 ? fFileNumber + 1 : 0);
+  }
   fChain->GetEntry(fUpperEntry);
 
   // Determine tree size and current entry
@@ -1578,7 +1615,7 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   if (fPythiaCrossSectionFilenames.size() > 0) {
     // Need to check that fFileNumber is smaller than the size of the vector because we don't check if
     if (fFileNumber < fPythiaCrossSectionFilenames.size()) {
-      bool success = PythiaInfoFromCrossSectionFile(fPythiaCrossSectionFilenames.at(fFileNumber));
+      bool success = PythiaInfoFromCrossSectionFile(fPrefetchedXSecFile != "" ? fPrefetchedXSecFile : fPythiaCrossSectionFilenames.at(fFileNumber));
 
       if (!success) {
         AliDebugStream(3) << "Failed to retrieve cross section from xsec file. Will still attempt to get the information from the header.\n";
@@ -1610,6 +1647,64 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
 
 }
 
+/**
+ * Replace the file at the given position of the chain by its local copy, if it was prefetched, and
+ * request the following files from the prefetcher. The local copy of the previous file is removed
+ * (the chain only closes it when loading the next tree, but it is not read anymore).
+ *
+ * The files are requested in the order in which InitTree() moves through the chain, including the
+ * restart from the beginning of the chain, so the embedded events are the same as without prefetching.
+ *
+ * @param position Position in the chain of the file which is opened next
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::UsePrefetchedFile(UInt_t position)
+{
+  ReleasePrefetchedFile();
+  if (position >= fMaxNumberOfFiles) return;
+
+  TChainElement * element = static_cast<TChainElement *>(fChain->GetListOfFiles()->At(position));
+
+  AliEmcalEmbeddingFilePrefetcher::File file;
+  if (element && fPrefetcher->Take(position, file)) {
+    fPrefetchedLocalPaths = file.fLocalPaths;
+    fPrefetchedXSecFile = file.fLocalXSecName;
+    if (file.fLocalName != "") {
+      AliDebugStream(2) << "Reading prefetched copy \"" << file.fLocalName << "\" of \"" << element->GetTitle() << "\".\n";
+      fPrefetchedPosition = position;
+      fPrefetchedRemoteFile = element->GetTitle();
+      element->SetTitle(file.fLocalName.c_str());
+    }
+  }
+
+  // Request the next files, in the order in which they are embedded
+  for (UInt_t i = 1; i <= static_cast<UInt_t>(fPrefetchFiles) && i < fMaxNumberOfFiles; i++) {
+    UInt_t next = (position + i) % fMaxNumberOfFiles;
+    if (fPrefetcher->IsRequested(next)) continue;
+    TChainElement * nextElement = static_cast<TChainElement *>(fChain->GetListOfFiles()->At(next));
+    if (!nextElement) continue;
+    std::string nextXSecFilename = next < fPythiaCrossSectionFilenames.size() ? fPythiaCrossSectionFilenames.at(next) : "";
+    if (!fPrefetcher->Request(next, nextElement->GetTitle(), nextXSecFilename)) break;
+  }
+}
+
+/**
+ * Restore the original name of the file read from a local copy in the chain and remove the local copies.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::ReleasePrefetchedFile()
+{
+  if (fPrefetchedPosition >= 0 && fChain) {
+    TChainElement * element = static_cast<TChainElement *>(fChain->GetListOfFiles()->At(fPrefetchedPosition));
+    if (element) element->SetTitle(fPrefetchedRemoteFile.c_str());
+  }
+  for (const auto & path : fPrefetchedLocalPaths) {
+    gSystem->Unlink(path.c_str());
+  }
+  fPrefetchedPosition = -1;
+  fPrefetchedRemoteFile = "";
+  fPrefetchedLocalPaths.clear();
+  fPrefetchedXSecFile = "";
+}
+
 /**
  * Extract pythia information from a cross section file. Modified from AliAnalysisTaskEmcal::PythiaInfoFromFile().
  *
@@ -2007,6 +2102,8 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "File list filename: \"" << fFileListFilename << "\"\n";
   tempSS << "Tree name: " << fTreeName << "\n";
   tempSS << "Print timing info to log: " << fPrintTimingInfoToLog << "\n";
+  tempSS << "Prefetch files: " << fPrefetchFiles << "\n";
+  tempSS << "Prefetch directory: \"" << fPrefetchDirectory << "\"\n";
   tempSS << "Random event number access: " << fRandomEventNumberAccess << "\n";
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
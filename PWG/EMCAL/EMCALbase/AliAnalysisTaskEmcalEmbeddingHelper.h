@@ -24,6 +24,7 @@ class AliMCEvent;
 class AliVHeader;
 class AliGenPythiaEventHeader;
 class AliEmcalList;
+class AliEmcalEmbeddingFilePrefetcher;
 
 #include <iosfwd>
 #include <vector>
@@ -124,6 +125,8 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   TString GetFileListFilename()                             const { return fFileListFilename; }
   bool GetCreateHistos()                                    const { return fCreateHisto; }
   TString GetExternalFilePath()                             const ;
+  Int_t GetPrefetchFiles()                                  const { return fPrefetchFiles; }
+  std::string GetPrefetchDirectory()                        const { return fPrefetchDirectory; }
   
   // Set
   /// Set the pt hard bin which will be added into the file pattern. Can also be omitted and set directly in the pattern.
@@ -136,6 +139,13 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetAOD(const char * treeName = "aodTree")                  { fTreeName     = treeName; }
   /// Set whether to print and plot execution time of InitTree()
   void SetPrintTimingInfoToLog(bool b)                            { fPrintTimingInfoToLog = b;}
+  /**
+   * Copy the next n files of the chain to local disk in a background thread while the current file
+   * is embedded (see AliEmcalEmbeddingFilePrefetcher). 0 (default) reads the files directly.
+   */
+  void SetPrefetchFiles(Int_t n)                                  { fPrefetchFiles = n; }
+  /// Set the directory of the local copies of the prefetched files (default: working directory)
+  void SetPrefetchDirectory(std::string dir)                      { fPrefetchDirectory = dir; }
   /**
    * Enable to begin embedding at a random entry in each embedded file. Will then loop around in order
    * so that all entries are made available.
@@ -309,6 +319,8 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
+  void            UsePrefetchedFile(UInt_t position);
+  void            ReleasePrefetchedFile();
   // Validation helper
   void            ValidatePhysicsSelectionForInternalEventSelection();
   // Helper functions
@@ -387,6 +399,14 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   bool                                          fPrintTimingInfoToLog; ///< Flag to print time to execute InitTree(), for logging purposes
   TStopwatch                                    fTimer            ;    //!<! Timer for the InitTree() function
 
+  Int_t                                         fPrefetchFiles    ; ///<  Number of files of the chain to copy ahead to local disk (0: no prefetching)
+  std::string                                   fPrefetchDirectory; ///<  Directory of the local copies of the prefetched files
+  AliEmcalEmbeddingFilePrefetcher              *fPrefetcher       ; //!<! Copies the next files of the chain in a background thread
+  Int_t                                         fPrefetchedPosition; //!<! Position in the chain of the file read from a local copy (-1: none)
+  std::string                                   fPrefetchedRemoteFile; //!<! Original name of the file read from a local copy
+  std::vector <std::string>                     fPrefetchedLocalPaths; //!<! Local copies to remove when the chain moves to the next file
+  std::string                                   fPrefetchedXSecFile; //!<! Local copy of the pythia cross section file of the current file
+
   static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
 
  private:
@@ -394,7 +414,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 14);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 15);
   /// \endcond
 };
 #endif
@@ -439,6 +439,7 @@ Bool_t AliClusterContainer::ApplyClusterCuts(const AliVCluster* clus, UInt_t &re
  */
 Int_t AliClusterContainer::GetNAcceptedClusters() const
 {
+  if (fUseKinematicsCache) return GetAcceptedIndices().size();
   UInt_t rejectionReason = 0;
   Int_t nClus = 0;
   for(int iclust = 0; iclust < this->fClArray->GetEntries(); ++iclust){
@@ -406,7 +406,7 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
   if ( absID < 0 || absID >= 24*48*geom->GetNumberOfSuperModules() )
     return kFALSE;
 
-  Int_t imod = -1, iphi =-1, ieta=-1,iTower = -1, iIphi = -1, iIeta = -1, status=0;
+  Int_t imod = -1, iphi =-1, ieta=-1,iTower = -1, iIphi = -1, iIeta = -1;
 
   if (!geom->GetCellIndex(absID,imod,iTower,iIphi,iIeta)){
     // cell absID does not exist
@@ -417,7 +417,34 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
   geom->GetCellPhiEtaIndexInSModule(imod,iTower,iIphi, iIeta,iphi,ieta);
 
   // Do not include bad channels found in analysis,
+  if ( !AcceptCellStatus(absID, imod, ieta, iphi) ) return kFALSE;
+
+  Bool_t isLowGain = !(cells->GetCellHighGain(absID));//HG = false -> LG = true
+
+  amp  = cells->GetCellAmplitude(absID);
+  time = cells->GetCellTime(absID);
+
+  RecalibrateCellAmpTime(absID, imod, ieta, iphi, bc, isLowGain, amp, time);
+
+  return kTRUE;
+}
+
+///
+/// Bad channel selection of AcceptCalibrateCell, for a cell whose
+/// super module, column and row are already known.
+///
+/// \param absID: absolute cell ID number
+/// \param imod: super module number
+/// \param ieta: column in the super module
+/// \param iphi: row in the super module
+///
+/// \return false if the bad channels are removed and the cell is bad
+///
+//_______________________________________________________________________________
+Bool_t AliEMCALRecoUtils::AcceptCellStatus(Int_t absID, Int_t imod, Int_t ieta, Int_t iphi) const
+{
   if ( IsBadChannelsRemovalSwitchedOn() ){
+    Int_t status = 0;
     Bool_t bad = kFALSE;
 
     if(fUse1Dmap)
@@ -430,10 +457,30 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
 
     if ( bad ) return kFALSE;
   }
-  Bool_t isLowGain = !(cells->GetCellHighGain(absID));//HG = false -> LG = true
 
+  return kTRUE;
+}
+
+///
+/// Energy and time calibration of AcceptCalibrateCell, for an accepted cell
+/// whose super module, column and row are already known. Used directly when
+/// the cell amplitude and time are not taken from the cells object, for
+/// example when several recalibrations are applied in one loop on the cells.
+///
+/// \param absID: absolute cell ID number
+/// \param imod: super module number
+/// \param ieta: column in the super module
+/// \param iphi: row in the super module
+/// \param bc: bunch crossing number
+/// \param isLowGain: low gain cell
+/// \param amp: input cell energy amplitude, output calibrated amplitude
+/// \param time: input cell time, output calibrated time
+///
+//_______________________________________________________________________________
+void AliEMCALRecoUtils::RecalibrateCellAmpTime(Int_t absID, Int_t imod, Int_t ieta, Int_t iphi, Int_t bc, Bool_t isLowGain,
+                                               Float_t & amp, Double_t & time)
+{
   //Recalibrate energy
-  amp  = cells->GetCellAmplitude(absID);
   if (!fCellsRecalibrated && IsRecalibrationOn()){
     // take out non lin from shaper for low gain cells
     if(fUseShaperNonlin && isLowGain){
@@ -452,9 +499,8 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
         amp *= GetEMCALSingleChannelRecalibrationFactor(imod,ieta,iphi);
     }
   }
-  // Recalibrate time
-  time = cells->GetCellTime(absID);
 
+  // Recalibrate time
   if (IsTimeECorrectionOn()) 
     CorrectCellTimeVsE(amp, time, isLowGain);
   time-=fConstantTimeShift*1e-9; // only in case of old Run1 simulation
@@ -464,8 +510,6 @@ Bool_t AliEMCALRecoUtils::AcceptCalibrateCell(Int_t absID, Int_t bc,
 
   // Correct for cable length and other delays
   RecalibrateCellTime(absID,bc,time,isLowGain);
-
-  return kTRUE;
 }
 
 ///
@@ -2345,7 +2389,7 @@ void AliEMCALRecoUtils::RecalibrateClusterEnergy(const AliEMCALGeometry* geom,
 //_______________________________________________________________________
 void AliEMCALRecoUtils::RecalibrateCells(AliVCaloCells * cells, Int_t bc)
 {
-  if (!IsRecalibrationOn() && !IsTimeRecalibrationOn() && !IsL1PhaseInTimeRecalibrationOn() && !IsBadChannelsRemovalSwitchedOn() && !IsSingleChannelRecalibrationOn())
+  if (!IsCellRecalibrationOn())
     return;
 
   if (!cells)
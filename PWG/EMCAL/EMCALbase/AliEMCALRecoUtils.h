@@ -169,9 +169,14 @@ public:
   //-----------------------------------------------------
   Bool_t   AcceptCalibrateCell(Int_t absId, Int_t bc,
                                Float_t & amp, Double_t & time, AliVCaloCells* cells) ; // Energy and Time
+  Bool_t   AcceptCellStatus(Int_t absId, Int_t iSM, Int_t iCol, Int_t iRow) const ; // Bad channel part of AcceptCalibrateCell
+  void     RecalibrateCellAmpTime(Int_t absId, Int_t iSM, Int_t iCol, Int_t iRow, Int_t bc, Bool_t isLowGain,
+                                  Float_t & amp, Double_t & time) ; // Energy and time part of AcceptCalibrateCell
   void     RecalibrateCells(AliVCaloCells * cells, Int_t bc) ; // Energy and Time
   void     RecalibrateClusterEnergy(const AliEMCALGeometry* geom, AliVCluster* cluster, AliVCaloCells * cells, Int_t bc=-1) ; // Energy and time
+  Bool_t   IsCellRecalibrationOn()                 const { return IsRecalibrationOn() || IsTimeRecalibrationOn() || IsL1PhaseInTimeRecalibrationOn() || IsBadChannelsRemovalSwitchedOn() || IsSingleChannelRecalibrationOn() ; }
   void     ResetCellsCalibrated()                        { fCellsRecalibrated = kFALSE; }
+  void     SetCellsCalibrated()                          { fCellsRecalibrated = kTRUE ; }
 
   // Energy recalibration
   Bool_t   IsRecalibrationOn()                     const { return fRecalibration ; }
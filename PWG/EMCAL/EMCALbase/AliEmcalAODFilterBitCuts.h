@@ -98,6 +98,24 @@ public:
    */
   void SetSelectionMode(SelectionMode_t mode) { fSelectionMode = mode; };
 
+  /**
+   * @brief Get the requested filter bits (bit representation)
+   * @return Requested filter bits
+   */
+  ULong_t GetFilterBits() const { return fAODfilterBits; }
+
+  /**
+   * @brief Get the requested track status bits (bit representation)
+   * @return Requested status bits
+   */
+  ULong_t GetStatusBits() const { return fAODstatusBits; }
+
+  /**
+   * @brief Get the selection mode (any/all) of the bit selection
+   * @return Selection mode
+   */
+  SelectionMode_t GetSelectionMode() const { return fSelectionMode; }
+
   /**
    * Select AOD tracks according which contain any of the bits. The way of the selection
    * is determined by the selection mode (default: any):
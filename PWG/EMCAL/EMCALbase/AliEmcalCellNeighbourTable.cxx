@@ -0,0 +1,152 @@
+//
+// Table of EMCal/DCal cell indices and neighbours
+//
+
+#include "AliEmcalCellNeighbourTable.h"
+
+#include <TMath.h>
+
+#include <AliLog.h>
+#include <AliEMCALGeometry.h>
+#include <AliEMCALGeoParams.h>
+
+/**
+ * Default constructor: empty table.
+ */
+AliEmcalCellNeighbourTable::AliEmcalCellNeighbourTable() :
+  fGeometryName(),
+  fNCells(0),
+  fSuperModule(),
+  fRow(),
+  fColumn(),
+  fPhiRack(),
+  fLocalPosition(),
+  fNeighbours()
+{
+}
+
+/**
+ * Check whether the table was built for the given geometry.
+ * @param geom EMCal geometry
+ * @return kTRUE if the table can be used with this geometry
+ */
+Bool_t AliEmcalCellNeighbourTable::IsBuilt(const AliEMCALGeometry *geom) const
+{
+  return geom && fNCells > 0 && fNCells == geom->GetNCells() && fGeometryName == geom->GetName();
+}
+
+/**
+ * Remove the content of the table.
+ */
+void AliEmcalCellNeighbourTable::Clear()
+{
+  fGeometryName = "";
+  fNCells = 0;
+  fSuperModule.clear();
+  fRow.clear();
+  fColumn.clear();
+  fPhiRack.clear();
+  fLocalPosition.clear();
+  fNeighbours.clear();
+}
+
+/**
+ * Fill the table from the geometry. Nothing is done if the table was already built for this geometry.
+ * The neighbours are found from the (row, column) of the cells: within a phi rack, the columns
+ * of the C side (odd) super module are shifted by the number of columns of a super module, such
+ * that the cells at eta = 0 of the A and C side super modules are adjacent.
+ * @param geom EMCal geometry
+ * @return kTRUE if the table is usable
+ */
+Bool_t AliEmcalCellNeighbourTable::Build(const AliEMCALGeometry *geom)
+{
+  if (!geom) {
+    AliErrorGeneral("AliEmcalCellNeighbourTable", "No geometry given, cannot build the cell table");
+    return kFALSE;
+  }
+  if (IsBuilt(geom)) return kTRUE;
+
+  Clear();
+  fGeometryName = geom->GetName();
+  fNCells = geom->GetNCells();
+  fSuperModule.assign(fNCells, -1);
+  fRow.assign(fNCells, -1);
+  fColumn.assign(fNCells, -1);
+  fPhiRack.assign(fNCells, -1);
+  fLocalPosition.assign(3*fNCells, 0.);
+  fNeighbours.assign(fgkNNeighbours*fNCells, -1);
+
+  // Super modules with the same phi position share a rack
+  const Int_t nSM = geom->GetNumberOfSuperModules();
+  std::vector<Int_t> rackOfSM(nSM, -1);
+  std::vector<Float_t> rackPhi;
+  for (Int_t iSM = 0; iSM < nSM; iSM++) {
+    Float_t smPhi = geom->GetEMCGeometry()->GetPhiCenterOfSM(iSM);
+    for (UInt_t irack = 0; irack < rackPhi.size(); irack++) {
+      if (TMath::AreEqualAbs(smPhi, rackPhi[irack], 1e-3)) {
+        rackOfSM[iSM] = irack;
+        break;
+      }
+    }
+    if (rackOfSM[iSM] < 0) {
+      rackOfSM[iSM] = rackPhi.size();
+      rackPhi.push_back(smPhi);
+    }
+  }
+
+  const Int_t nRows = AliEMCALGeoParams::fgkEMCALRows;
+  const Int_t nCols = 2*AliEMCALGeoParams::fgkEMCALCols;
+  std::vector<Int_t> cellAt(rackPhi.size()*nRows*nCols, -1);
+
+  Int_t nSupMod = 0, nModule = 0, nIphi = 0, nIeta = 0, iphi = 0, ieta = 0;
+  for (Int_t absId = 0; absId < fNCells; absId++) {
+    if (!geom->CheckAbsCellId(absId)) continue;
+    if (!geom->GetCellIndex(absId, nSupMod, nModule, nIphi, nIeta)) continue;
+    geom->GetCellPhiEtaIndexInSModule(nSupMod, nModule, nIphi, nIeta, iphi, ieta);
+    if (nSupMod < 0 || nSupMod >= nSM || iphi < 0 || iphi >= nRows || ieta < 0 || ieta >= nCols/2) {
+      AliWarningGeneral("AliEmcalCellNeighbourTable", Form("Cell %d out of range: SM %d, row %d, column %d", absId, nSupMod, iphi, ieta));
+      continue;
+    }
+
+    fSuperModule[absId] = nSupMod;
+    fRow[absId] = iphi;
+    fColumn[absId] = ieta;
+    fPhiRack[absId] = rackOfSM[nSupMod];
+    geom->RelPosCellInSModule(absId, fLocalPosition[3*absId], fLocalPosition[3*absId+1], fLocalPosition[3*absId+2]);
+
+    Int_t rackCol = ieta + (nSupMod % 2 ? AliEMCALGeoParams::fgkEMCALCols : 0);
+    Int_t& slot = cellAt[(fPhiRack[absId]*nRows + iphi)*nCols + rackCol];
+    if (slot >= 0) {
+      AliWarningGeneral("AliEmcalCellNeighbourTable", Form("Cells %d and %d at the same position in the phi rack", slot, absId));
+    }
+    slot = absId;
+  }
+
+  // side neighbours first, then the corners
+  static const Int_t dRow[fgkNNeighbours] = { 0, 0, -1, 1, -1, -1,  1, 1 };
+  static const Int_t dCol[fgkNNeighbours] = {-1, 1,  0, 0, -1,  1, -1, 1 };
+  for (Int_t absId = 0; absId < fNCells; absId++) {
+    if (fSuperModule[absId] < 0) continue;
+    Int_t rackCol = fColumn[absId] + (fSuperModule[absId] % 2 ? AliEMCALGeoParams::fgkEMCALCols : 0);
+    for (Int_t i = 0; i < fgkNNeighbours; i++) {
+      Int_t row = fRow[absId] + dRow[i];
+      Int_t col = rackCol + dCol[i];
+      if (row < 0 || row >= nRows || col < 0 || col >= nCols) continue;
+      fNeighbours[fgkNNeighbours*absId+i] = cellAt[(fPhiRack[absId]*nRows + row)*nCols + col];
+    }
+  }
+
+  return kTRUE;
+}
+
+/**
+ * Check whether a neighbour is in another super module (cluster shared between the A and C side).
+ * @param absId absolute id of the cell
+ * @param i index of the neighbour
+ * @return kTRUE if the neighbour exists and is in another super module
+ */
+Bool_t AliEmcalCellNeighbourTable::IsSharedNeighbour(Int_t absId, Int_t i) const
+{
+  Int_t neighbour = GetNeighbour(absId, i);
+  return neighbour >= 0 && fSuperModule[neighbour] != fSuperModule[absId];
+}
@@ -0,0 +1,75 @@
+#ifndef ALIEMCALCELLNEIGHBOURTABLE_H
+#define ALIEMCALCELLNEIGHBOURTABLE_H
+
+#include <vector>
+
+#include <TString.h>
+
+class AliEMCALGeometry;
+
+/**
+ * @class AliEmcalCellNeighbourTable
+ * @ingroup EMCALCOREFW
+ * @brief Table of EMCal/DCal cell indices and neighbours, built once per geometry
+ *
+ * For every cell absolute id, the table stores the super module, the row (phi) and column (eta)
+ * in the super module, the position in the super module and the absolute ids of the 8 surrounding
+ * cells. The first fgkNSideNeighbours neighbours share a side with the cell, the others a corner.
+ * Missing neighbours have id -1.
+ *
+ * Cells in the two super modules of the same phi position (A and C side) are neighbours at eta = 0,
+ * as in AliEMCALClusterizerv1::AreNeighbours(). Such neighbours are flagged as shared.
+ *
+ * The table only depends on the geometry (not on the alignment matrices or the run), so it can be
+ * built once and used for all the events, instead of calling AliEMCALGeometry::GetCellIndex() and
+ * AliEMCALGeometry::GetCellPhiEtaIndexInSModule() for every cell pair.
+ *
+ * ~~~{.cxx}
+ * AliEmcalCellNeighbourTable table;
+ * table.Build(geom); // does nothing if already built for this geometry
+ * for (Int_t i = 0; i < AliEmcalCellNeighbourTable::fgkNSideNeighbours; i++) {
+ *   Int_t neighbour = table.GetNeighbour(absId, i);
+ *   if (neighbour < 0) continue;
+ *   ...
+ * }
+ * ~~~
+ *
+ * @date Oct 2026
+ */
+class AliEmcalCellNeighbourTable {
+ public:
+  static const Int_t fgkNNeighbours = 8;      ///< number of neighbours stored per cell
+  static const Int_t fgkNSideNeighbours = 4;  ///< number of neighbours sharing a side (stored first)
+
+  AliEmcalCellNeighbourTable();
+  virtual ~AliEmcalCellNeighbourTable() {}
+
+  Bool_t   Build(const AliEMCALGeometry *geom);
+  Bool_t   IsBuilt(const AliEMCALGeometry *geom) const;
+  void     Clear();
+
+  Int_t    GetNCells()                            const { return fNCells; }
+  Bool_t   IsValid(Int_t absId)                   const { return absId >= 0 && absId < fNCells && fSuperModule[absId] >= 0; }
+  Int_t    GetSuperModule(Int_t absId)            const { return fSuperModule[absId]; }
+  Int_t    GetRow(Int_t absId)                    const { return fRow[absId]; }
+  Int_t    GetColumn(Int_t absId)                 const { return fColumn[absId]; }
+  Int_t    GetPhiRack(Int_t absId)                const { return fPhiRack[absId]; }
+  Double_t GetLocalX(Int_t absId)                 const { return fLocalPosition[3*absId]; }
+  Double_t GetLocalY(Int_t absId)                 const { return fLocalPosition[3*absId+1]; }
+  Double_t GetLocalZ(Int_t absId)                 const { return fLocalPosition[3*absId+2]; }
+  Int_t    GetNeighbour(Int_t absId, Int_t i)     const { return fNeighbours[fgkNNeighbours*absId+i]; }
+  const Int_t *GetNeighbours(Int_t absId)         const { return &fNeighbours[fgkNNeighbours*absId]; }
+  Bool_t   IsSharedNeighbour(Int_t absId, Int_t i) const;
+
+ protected:
+  TString               fGeometryName;    ///< name of the geometry the table was built for
+  Int_t                 fNCells;          ///< number of cells in the geometry
+  std::vector<Int_t>    fSuperModule;     ///< super module of each cell (-1: invalid id)
+  std::vector<Int_t>    fRow;             ///< row (phi index) in the super module
+  std::vector<Int_t>    fColumn;          ///< column (eta index) in the super module
+  std::vector<Int_t>    fPhiRack;         ///< index of the super modules with the same phi position
+  std::vector<Double_t> fLocalPosition;   ///< x, y, z of each cell in the super module
+  std::vector<Int_t>    fNeighbours;      ///< fgkNNeighbours absolute ids per cell (-1: none)
+};
+
+#endif
@@ -60,6 +60,17 @@ AliEmcalContainer::AliEmcalContainer():
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fUseKinematicsCache(kFALSE),
+  fKinematicsCacheValid(kFALSE),
+  fCacheIndices(),
+  fCachePx(),
+  fCachePy(),
+  fCachePz(),
+  fCacheE(),
+  fCachePt(),
+  fCacheEta(),
+  fCachePhi(),
+  fCacheCharge(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -90,6 +101,17 @@ AliEmcalContainer::AliEmcalContainer(const char *name):
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fUseKinematicsCache(kFALSE),
+  fKinematicsCacheValid(kFALSE),
+  fCacheIndices(),
+  fCachePx(),
+  fCachePy(),
+  fCachePz(),
+  fCacheE(),
+  fCachePt(),
+  fCacheEta(),
+  fCachePhi(),
+  fCacheCharge(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -126,6 +148,8 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
     fClArrayName = GetDefaultArrayName(event);
   }
 
+  InvalidateKinematicsCache();
+
   // Get the right event (either the current event of the embedded event)
   event = AliEmcalContainerUtils::GetEvent(event, fIsEmbedding);
 
@@ -159,6 +183,8 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
 
 void AliEmcalContainer::NextEvent(const AliVEvent * event)
 {
+  InvalidateKinematicsCache();
+
   // Get the right event (either the current event of the embedded event)
   event = AliEmcalContainerUtils::GetEvent(event, fIsEmbedding);
 
@@ -168,6 +194,7 @@ void AliEmcalContainer::NextEvent(const AliVEvent * event)
 }
 
 Int_t AliEmcalContainer::GetNAcceptEntries() const{
+  if (fUseKinematicsCache) return GetAcceptedIndices().size();
   Int_t result = 0;
   for(int index = 0; index < GetNEntries(); index++){
     UInt_t rejectionReason = 0;
@@ -176,6 +203,70 @@ Int_t AliEmcalContainer::GetNAcceptEntries() const{
   return result;
 }
 
+void AliEmcalContainer::BuildKinematicsCache() const
+{
+  fCacheIndices.clear();
+  fCachePx.clear();
+  fCachePy.clear();
+  fCachePz.clear();
+  fCacheE.clear();
+  fCachePt.clear();
+  fCacheEta.clear();
+  fCachePhi.clear();
+  fCacheCharge.clear();
+
+  AliTLorentzVector mom;
+  for (Int_t index = 0; index < GetNEntries(); index++) {
+    UInt_t rejectionReason = 0;
+    if (!AcceptObject(index, rejectionReason)) continue;
+    GetMomentum(mom, index);
+    fCacheIndices.push_back(index);
+    fCachePx.push_back(mom.Px());
+    fCachePy.push_back(mom.Py());
+    fCachePz.push_back(mom.Pz());
+    fCacheE.push_back(mom.E());
+    fCachePt.push_back(mom.Pt());
+    fCacheEta.push_back(mom.Eta());
+    fCachePhi.push_back(mom.Phi_0_2pi());
+    fCacheCharge.push_back(GetObjectCharge(index));
+  }
+  fKinematicsCacheValid = kTRUE;
+}
+
+const std::vector<Int_t>& AliEmcalContainer::GetAcceptedIndices() const
+{
+  if (!fKinematicsCacheValid) BuildKinematicsCache();
+  return fCacheIndices;
+}
+
+Bool_t AliEmcalContainer::GetCachedMomentum(TLorentzVector &mom, Int_t j) const
+{
+  if (!fKinematicsCacheValid) BuildKinematicsCache();
+  if (j < 0 || j >= (Int_t)fCacheIndices.size()) {
+    mom.SetPxPyPzE(0, 0, 0, 0);
+    return kFALSE;
+  }
+  mom.SetPxPyPzE(fCachePx[j], fCachePy[j], fCachePz[j], fCacheE[j]);
+  return kTRUE;
+}
+
+AliEmcalContainerKinematics AliEmcalContainer::GetAcceptedKinematics() const
+{
+  if (!fKinematicsCacheValid) BuildKinematicsCache();
+  AliEmcalContainerKinematics kin;
+  kin.fN = fCacheIndices.size();
+  kin.fIndex = fCacheIndices.data();
+  kin.fPx = fCachePx.data();
+  kin.fPy = fCachePy.data();
+  kin.fPz = fCachePz.data();
+  kin.fE = fCacheE.data();
+  kin.fPt = fCachePt.data();
+  kin.fEta = fCacheEta.data();
+  kin.fPhi = fCachePhi.data();
+  kin.fCharge = fCacheCharge.data();
+  return kin;
+}
+
 Int_t AliEmcalContainer::GetIndexFromLabel(Int_t lab) const
 { 
   if (fLabelMap) {
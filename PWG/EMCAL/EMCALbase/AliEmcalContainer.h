@@ -37,12 +37,42 @@ class AliVEvent;
 class AliNamedArrayI;
 class AliVParticle;
 
+#include <vector>
 #include <TNamed.h>
 #include <TClonesArray.h>
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterableContainer::operator_star_object<TObject> > AliEmcalIterableContainer;
 typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterableContainer::operator_star_pair<TObject> > AliEmcalIterableMomentumContainer;
+
+/**
+ * @struct AliEmcalContainerKinematics
+ * @brief Read-only structure-of-arrays view of the accepted objects of an EMCAL container
+ * @ingroup EMCALCOREFW
+ *
+ * All arrays have fN entries, entry j belongs to the object with index fIndex[j] in the
+ * container. The kinematics are the ones of AliEmcalContainer::GetMomentum (including the
+ * mass hypothesis and the cluster energy type), \f$ \phi \f$ is in [0, 2\f$ \pi \f$).
+ * The view is valid until the next event or the next call of
+ * AliEmcalContainer::InvalidateKinematicsCache.
+ *
+ * ~~~{.cxx}
+ * AliEmcalContainerKinematics kin = cont->GetAcceptedKinematics();
+ * for (Int_t j = 0; j < kin.fN; j++) sumPt += kin.fPt[j];
+ * ~~~
+ */
+struct AliEmcalContainerKinematics {
+  Int_t           fN;                   ///< number of accepted objects
+  const Int_t    *fIndex;               ///< index of the accepted objects in the container
+  const Double_t *fPx;                  ///< \f$ p_{x} \f$
+  const Double_t *fPy;                  ///< \f$ p_{y} \f$
+  const Double_t *fPz;                  ///< \f$ p_{z} \f$
+  const Double_t *fE;                   ///< energy
+  const Double_t *fPt;                  ///< \f$ p_{t} \f$
+  const Double_t *fEta;                 ///< \f$ \eta \f$
+  const Double_t *fPhi;                 ///< \f$ \phi \f$ in [0, 2\f$ \pi \f$)
+  const Short_t  *fCharge;              ///< charge (0 for clusters)
+};
 #endif
 
 /**
@@ -96,6 +126,13 @@ typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterabl
  * }
  * ~~~
  *
+ * The accepted indices and the kinematics of the accepted objects can be cached once
+ * per event (see SetUseKinematicsCache): the selection then runs once per event and the
+ * accepted iterators, GetNAcceptEntries and the structure-of-arrays view returned by
+ * GetAcceptedKinematics share the result. The cache is invalidated in NextEvent; a
+ * task changing the objects or the cuts within an event has to call
+ * InvalidateKinematicsCache.
+ *
  * The usage of EMCAL containers is described under \subpage EMCALcontainers
  */
 class AliEmcalContainer : public TObject {
@@ -273,6 +310,38 @@ class AliEmcalContainer : public TObject {
   void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; }
   void                        SetClassName(const char *clname);
 
+  /**
+   * @brief Switch on/off the per-event cache of the accepted objects
+   *
+   * If on, the accepted iterators and GetNAcceptEntries use the accepted indices and
+   * momenta computed once per event instead of applying the selection at each call.
+   * @param[in] b If true the cache is used
+   */
+  void                        SetUseKinematicsCache(Bool_t b = kTRUE)   { fUseKinematicsCache = b; InvalidateKinematicsCache(); }
+  Bool_t                      GetUseKinematicsCache()           const   { return fUseKinematicsCache; }
+
+  /**
+   * @brief Mark the cached accepted indices and kinematics as outdated
+   *
+   * To be called if the objects or the cuts change within an event, the cache
+   * is rebuilt at the next access.
+   */
+  void                        InvalidateKinematicsCache()       const   { fKinematicsCacheValid = kFALSE; }
+
+  /**
+   * @brief Get the indices of the accepted objects, from the cache (built if needed)
+   * @return Indices of the accepted objects in increasing order
+   */
+  const std::vector<Int_t>&   GetAcceptedIndices() const;
+
+  /**
+   * @brief Get the momentum of an accepted object from the cache
+   * @param[out] mom Momentum of the accepted object
+   * @param[in] j Position of the object in the list of accepted objects
+   * @return True if the position is valid, false otherwise
+   */
+  Bool_t                      GetCachedMomentum(TLorentzVector &mom, Int_t j) const;
+
   /**
    * @brief Set embedding status
    * 
@@ -349,6 +418,15 @@ class AliEmcalContainer : public TObject {
    * @return iterable container over accepted objects in the EMCAL container
    */
   const AliEmcalIterableMomentumContainer   accepted_momentum() const;
+
+  /**
+   * @brief Structure-of-arrays view of the kinematics of the accepted objects.
+   *
+   * The view is built from the per-event cache, which is filled at the first call
+   * in the event independently of SetUseKinematicsCache.
+   * @return View on the cached kinematics of the accepted objects
+   */
+  AliEmcalContainerKinematics       GetAcceptedKinematics() const;
 #endif
 
  protected:
@@ -372,6 +450,18 @@ class AliEmcalContainer : public TObject {
    */
   void                        GetVertexFromEvent(const AliVEvent * event);
 
+  /**
+   * @brief Apply the selection to all objects and fill the cache of accepted indices and kinematics
+   */
+  void                        BuildKinematicsCache() const;
+
+  /**
+   * @brief Charge of the object stored in the kinematics cache
+   * @param[in] i Index of the object in the container
+   * @return Charge of the object (0 in the base class)
+   */
+  virtual Short_t             GetObjectCharge(Int_t /*i*/) const { return 0; }
+
   TString                     fName;                    ///< object name
   TString                     fClArrayName;             ///< name of branch
   TString                     fBaseClassName;           ///< name of the base class that this container can handle
@@ -394,6 +484,17 @@ class AliEmcalContainer : public TObject {
   AliNamedArrayI             *fLabelMap;                //!<! Label-Index map
   Double_t                    fVertex[3];               //!<! event vertex array
   TClass                     *fLoadedClass;             //!<! Class of the objects contained in the TClonesArray
+  Bool_t                      fUseKinematicsCache;      ///< use the per-event cache of accepted objects in the accepted iterators
+  mutable Bool_t              fKinematicsCacheValid;    //!<! the cache is up to date for the current event
+  mutable std::vector<Int_t>  fCacheIndices;            //!<! indices of the accepted objects
+  mutable std::vector<Double_t> fCachePx;               //!<! \f$ p_{x} \f$ of the accepted objects
+  mutable std::vector<Double_t> fCachePy;               //!<! \f$ p_{y} \f$ of the accepted objects
+  mutable std::vector<Double_t> fCachePz;               //!<! \f$ p_{z} \f$ of the accepted objects
+  mutable std::vector<Double_t> fCacheE;                //!<! energy of the accepted objects
+  mutable std::vector<Double_t> fCachePt;               //!<! \f$ p_{t} \f$ of the accepted objects
+  mutable std::vector<Double_t> fCacheEta;              //!<! \f$ \eta \f$ of the accepted objects
+  mutable std::vector<Double_t> fCachePhi;              //!<! \f$ \phi \f$ of the accepted objects
+  mutable std::vector<Short_t> fCacheCharge;            //!<! charge of the accepted objects
 
  private:
   TString                     fClassName;               ///< name of the class in the TClonesArray
@@ -401,6 +502,6 @@ class AliEmcalContainer : public TObject {
   AliEmcalContainer(const AliEmcalContainer& obj); // copy constructor
   AliEmcalContainer& operator=(const AliEmcalContainer& other); // assignment
 
-  ClassDef(AliEmcalContainer,9);
+  ClassDef(AliEmcalContainer,10);
 };
 #endif
@@ -0,0 +1,230 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <TFile.h>
+#include <TSystem.h>
+#include <TUrl.h>
+
+#include "AliEmcalEmbeddingFilePrefetcher.h"
+
+/**
+ * Constructor. Starts the copy thread. ROOT::EnableThreadSafety() has to be called before,
+ * when the job is set up.
+ *
+ * @param[in] directory Directory where the local copies are written
+ * @param[in] maxFiles Maximum number of files requested and not yet taken
+ */
+AliEmcalEmbeddingFilePrefetcher::AliEmcalEmbeddingFilePrefetcher(const std::string & directory, unsigned int maxFiles):
+  fDirectory(directory),
+  fMaxFiles(maxFiles),
+  fNCopies(0),
+  fFiles(),
+  fMutex(),
+  fCondition(),
+  fStop(false),
+  fThread()
+{
+  fThread = std::thread(&AliEmcalEmbeddingFilePrefetcher::Run, this);
+}
+
+/**
+ * Destructor. Stops the copy thread and removes the local copies which were not taken.
+ */
+AliEmcalEmbeddingFilePrefetcher::~AliEmcalEmbeddingFilePrefetcher()
+{
+  Stop();
+}
+
+/**
+ * Request a file to be copied.
+ *
+ * @param[in] position Position of the file in the embedding chain
+ * @param[in] name Name of the file in the chain
+ * @param[in] xsecName Name of the pythia cross section file (empty if none)
+ * @return false if the maximum number of files is already requested
+ */
+bool AliEmcalEmbeddingFilePrefetcher::Request(unsigned int position, const std::string & name, const std::string & xsecName)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (fStop || fFiles.size() >= fMaxFiles) return false;
+
+  File file;
+  file.fPosition = position;
+  file.fName = name;
+  file.fXSecName = xsecName;
+  fFiles.push_back(file);
+  fCondition.notify_all();
+  return true;
+}
+
+/**
+ * @param[in] position Position of the file in the embedding chain
+ * @return true if the file was requested and not yet taken
+ */
+bool AliEmcalEmbeddingFilePrefetcher::IsRequested(unsigned int position) const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  for (const auto & file : fFiles) {
+    if (file.fPosition == position) return true;
+  }
+  return false;
+}
+
+/**
+ * Take a requested file, waiting for its copy to finish. The files requested before it are released.
+ * The caller owns the local copies of the taken file and has to release them.
+ *
+ * @param[in] position Position of the file in the embedding chain
+ * @param[out] file Requested file with the names of the local copies
+ * @return false if the file was not requested
+ */
+bool AliEmcalEmbeddingFilePrefetcher::Take(unsigned int position, File & file)
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  auto found = fFiles.end();
+  for (auto it = fFiles.begin(); it != fFiles.end(); ++it) {
+    if (it->fPosition == position) {
+      found = it;
+      break;
+    }
+  }
+  if (found == fFiles.end()) return false;
+
+  // The files are copied in order, so the previous files are done as well
+  unsigned int index = found - fFiles.begin();
+  fCondition.wait(lock, [this, index] { return fStop || fFiles[index].fDone; });
+  if (!fFiles[index].fDone) return false;
+
+  for (unsigned int i = 0; i < index; i++) {
+    Release(fFiles.front());
+    fFiles.pop_front();
+  }
+  file = fFiles.front();
+  fFiles.pop_front();
+  fCondition.notify_all();
+  return true;
+}
+
+/**
+ * Stop the copy thread (after the copy in progress) and remove the local copies which were not taken.
+ */
+void AliEmcalEmbeddingFilePrefetcher::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+    fCondition.notify_all();
+  }
+  if (fThread.joinable()) fThread.join();
+
+  for (const auto & file : fFiles) Release(file);
+  fFiles.clear();
+}
+
+/**
+ * Remove the local copies of a file.
+ *
+ * @param[in] file File returned by Take()
+ */
+void AliEmcalEmbeddingFilePrefetcher::Release(const File & file)
+{
+  for (const auto & path : file.fLocalPaths) {
+    gSystem->Unlink(path.c_str());
+  }
+}
+
+/**
+ * Copy thread: copies the requested files in order until stopped.
+ */
+void AliEmcalEmbeddingFilePrefetcher::Run()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (true) {
+    // Next file to copy
+    unsigned int index = 0;
+    fCondition.wait(lock, [this, &index] {
+      if (fStop) return true;
+      for (index = 0; index < fFiles.size(); index++) {
+        if (!fFiles[index].fDone) return true;
+      }
+      return false;
+    });
+    if (fStop) break;
+
+    // Copy without holding the lock. Only files which are done are removed from the queue
+    // meanwhile, so the file is found again as the first one not done.
+    File file = fFiles[index];
+    lock.unlock();
+
+    std::vector<std::pair<std::string, std::string> > copies;
+    file.fLocalName = CopyToLocal(file.fName, copies);
+    if (file.fXSecName != "") {
+      file.fLocalXSecName = CopyToLocal(file.fXSecName, copies);
+    }
+    for (const auto & copy : copies) {
+      if (copy.second != "") file.fLocalPaths.push_back(copy.second);
+    }
+    file.fDone = true;
+
+    lock.lock();
+    if (fStop) {
+      Release(file);
+      break;
+    }
+    for (auto & requested : fFiles) {
+      if (!requested.fDone) {
+        requested = file;
+        break;
+      }
+    }
+    fCondition.notify_all();
+  }
+}
+
+/**
+ * Copy a remote file to the local directory. A file in a zip archive is copied as the full archive,
+ * which is only copied once per requested file.
+ *
+ * @param[in] name File name (with the "#" anchor for zip archives)
+ * @param[in,out] copies Pairs of remote and local paths already copied for the requested file
+ * @return Name of the local copy to be opened, empty if the file is local or the copy failed
+ */
+std::string AliEmcalEmbeddingFilePrefetcher::CopyToLocal(const std::string & name, std::vector<std::pair<std::string, std::string> > & copies)
+{
+  TUrl url(name.c_str(), kTRUE);
+  if (!url.IsValid() || std::string(url.GetProtocol()) == "file") return "";
+
+  std::string anchor = url.GetAnchor();
+  url.SetAnchor("");
+  std::string source = url.GetUrl();
+
+  std::string local;
+  for (const auto & copy : copies) {
+    if (copy.first == source) local = copy.second;
+  }
+  if (local == "") {
+    std::string basename = url.GetFile();
+    basename = basename.substr(basename.find_last_of('/') + 1);
+    local = fDirectory + "/embeddingPrefetch_" + std::to_string(fNCopies++) + "_" + basename;
+    if (!TFile::Cp(source.c_str(), local.c_str(), kFALSE)) {
+      gSystem->Unlink(local.c_str());
+      local = "";
+    }
+    copies.push_back(std::make_pair(source, local));
+  }
+  if (local == "") return "";
+
+  return anchor == "" ? local : local + "#" + anchor;
+}
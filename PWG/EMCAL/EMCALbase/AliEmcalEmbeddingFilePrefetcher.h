@@ -0,0 +1,82 @@
+#ifndef ALIEMCALEMBEDDINGFILEPREFETCHER_H
+#define ALIEMCALEMBEDDINGFILEPREFETCHER_H
+
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class AliEmcalEmbeddingFilePrefetcher
+ * @ingroup EMCALCOREFW
+ * @brief Copies the next files to embed to local disk in a background thread
+ *
+ * The embedding helper requests the files which come next in its TChain (together with the
+ * corresponding pythia cross section file). A background thread copies them in the order of the
+ * requests, such that the remote reads and the cross section file access do not block the event
+ * loop. At most the given number of files is requested and not yet taken at the same time.
+ *
+ * When the chain reaches a file, the helper takes it from the prefetcher (waiting for the copy
+ * if it is still in progress) and reads the local copy instead of the remote file. The content
+ * is the same, so the embedded events and their order do not change. Files for which the copy
+ * failed, or which are local already, are read from their original location.
+ *
+ * Files inside a zip archive ("archive.zip#AliAOD.root") are copied as the full archive.
+ * The local copies are removed by Release().
+ *
+ * Only the file transfer is done in the background: the events are still read and decompressed
+ * by the helper on the analysis thread (from the local copy). The copy thread uses ROOT I/O, so
+ * ROOT::EnableThreadSafety() has to be called when the job is set up, before the prefetcher is
+ * created (the embedding helper does it in UserCreateOutputObjects()).
+ *
+ * @date Oct 2026
+ */
+class AliEmcalEmbeddingFilePrefetcher {
+ public:
+  /// A file requested for prefetching
+  struct File {
+    File() : fPosition(0), fName(), fXSecName(), fLocalName(), fLocalXSecName(), fLocalPaths(), fDone(false) {}
+
+    unsigned int             fPosition;       ///< Position of the file in the embedding chain
+    std::string              fName;           ///< Name of the file in the chain
+    std::string              fXSecName;       ///< Pythia cross section file (empty if none)
+    std::string              fLocalName;      ///< Name to open the local copy of the file (empty if not copied)
+    std::string              fLocalXSecName;  ///< Name to open the local copy of the cross section file (empty if not copied)
+    std::vector<std::string> fLocalPaths;     ///< Local files to remove when the file is released
+    bool                     fDone;           ///< Whether the copy has been attempted
+  };
+
+  AliEmcalEmbeddingFilePrefetcher(const std::string & directory, unsigned int maxFiles);
+  virtual ~AliEmcalEmbeddingFilePrefetcher();
+
+  unsigned int GetMaxFiles()                                const { return fMaxFiles; }
+  bool         Request(unsigned int position, const std::string & name, const std::string & xsecName);
+  bool         IsRequested(unsigned int position)           const;
+  bool         Take(unsigned int position, File & file);
+  void         Stop();
+
+  static void  Release(const File & file);
+
+ protected:
+  void         Run();
+  std::string  CopyToLocal(const std::string & name, std::vector<std::pair<std::string, std::string> > & copies);
+
+  std::string              fDirectory;       ///< Directory of the local copies
+  unsigned int             fMaxFiles;        ///< Maximum number of files requested and not taken
+  unsigned int             fNCopies;         ///< Number of copies made, used to make unique local names
+  std::deque<File>         fFiles;           ///< Requested files, in the order of the requests
+  mutable std::mutex       fMutex;           ///< Protects fFiles and fStop
+  std::condition_variable  fCondition;       ///< Signals new requests, finished copies and stop
+  bool                     fStop;            ///< Whether the thread should stop
+  std::thread              fThread;          ///< Background copy thread
+};
+#endif
+
+#endif
@@ -0,0 +1,155 @@
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#ifndef ALIEMCALETAPHIGRID_H
+#define ALIEMCALETAPHIGRID_H
+
+#include <algorithm>
+#include <vector>
+
+#include <TMath.h>
+
+/**
+ * @class AliEmcalEtaPhiGrid
+ * @ingroup EMCALCOREFW
+ * @brief Spatial index of objects in (eta, phi) for distance-limited matching
+ *
+ * Objects (e.g. clusters) are binned in a grid of cells whose size is at least the maximum
+ * matching distance, with wrap-around in phi. For a given (eta, phi) position (e.g. a track
+ * on the EMCal surface), only the objects of the 3x3 neighbouring cells can be closer than
+ * the maximum distance, in eta and in phi. They are returned in increasing id order, such
+ * that a matching loop over the candidates gives the same results as a loop over all objects.
+ *
+ * Objects with non-finite coordinates or |eta| > 10 (e.g. at the origin) are not binned and are
+ * returned as candidates of every position, and every object is a candidate of a position with
+ * non-finite coordinates. If the maximum distance is too large for the grid to be useful (less
+ * than 3 cells in phi), all objects are returned.
+ *
+ * ~~~{.cxx}
+ * AliEmcalEtaPhiGrid grid;
+ * grid.Reset(maxDistance);
+ * for (Int_t icluster = 0; icluster < nClusters; icluster++) grid.AddPoint(icluster, clusterEta, clusterPhi);
+ * grid.Build();
+ * std::vector<Int_t> candidates;
+ * grid.GetCandidates(trackEta, trackPhi, candidates);
+ * ~~~
+ *
+ * @date Oct 2026
+ */
+class AliEmcalEtaPhiGrid {
+ public:
+  AliEmcalEtaPhiGrid() : fCellSize(0), fEtaMin(0), fNEta(0), fNPhi(0), fIds(), fEtas(), fPhis(), fCellStart(), fCellIds(), fAlwaysIds(), fAllIds() {}
+  virtual ~AliEmcalEtaPhiGrid() {}
+
+  /// Removes all objects and sets the maximum matching distance
+  void Reset(Double_t maxDistance)
+  {
+    fCellSize = maxDistance * (1 + 1e-6);
+    fIds.clear();
+    fEtas.clear();
+    fPhis.clear();
+  }
+
+  /// Adds an object with the given id (ids must be added in increasing order)
+  void AddPoint(Int_t id, Double_t eta, Double_t phi)
+  {
+    fIds.push_back(id);
+    fEtas.push_back(eta);
+    fPhis.push_back(phi);
+  }
+
+  /// Bins the objects, to be called after the last AddPoint()
+  void Build()
+  {
+    fCellStart.clear();
+    fCellIds.clear();
+    fAlwaysIds.clear();
+    fAllIds = fIds;
+    fNEta = 0;
+    fNPhi = fCellSize > 0 ? (Int_t)(TMath::TwoPi() / fCellSize) : 0;
+    if (fNPhi < 3) {
+      fNPhi = 0;
+      return;
+    }
+
+    Double_t etaMax = 0;
+    for (UInt_t i = 0; i < fIds.size(); i++) {
+      if (!IsBinned(fEtas[i], fPhis[i])) continue;
+      if (!fNEta || fEtas[i] < fEtaMin) fEtaMin = fEtas[i];
+      if (!fNEta || fEtas[i] > etaMax) etaMax = fEtas[i];
+      fNEta = 1;
+    }
+    if (fNEta) fNEta = (Int_t)((etaMax - fEtaMin) / fCellSize) + 1;
+
+    std::vector<Int_t> cells(fIds.size(), -1);
+    fCellStart.assign(fNEta * fNPhi + 1, 0);
+    for (UInt_t i = 0; i < fIds.size(); i++) {
+      if (!IsBinned(fEtas[i], fPhis[i])) {
+        fAlwaysIds.push_back(fIds[i]);
+        continue;
+      }
+      cells[i] = EtaCell(fEtas[i]) * fNPhi + PhiCell(fPhis[i]);
+      fCellStart[cells[i] + 1]++;
+    }
+    for (Int_t icell = 0; icell < fNEta * fNPhi; icell++) fCellStart[icell + 1] += fCellStart[icell];
+    fCellIds.resize(fCellStart.back());
+    std::vector<Int_t> next(fCellStart.begin(), fCellStart.end() - 1);
+    for (UInt_t i = 0; i < fIds.size(); i++) {
+      if (cells[i] >= 0) fCellIds[next[cells[i]]++] = fIds[i];
+    }
+  }
+
+  /// Fills ids (sorted) with the objects that can be within the maximum distance of (eta, phi)
+  void GetCandidates(Double_t eta, Double_t phi, std::vector<Int_t>& ids) const
+  {
+    if (!fNPhi || !IsFinite(eta, phi)) {
+      ids = fAllIds;
+      return;
+    }
+    ids = fAlwaysIds;
+    if (fNEta) {
+      Double_t etaCell = TMath::Floor((eta - fEtaMin) / fCellSize);
+      if (etaCell >= -1 && etaCell <= fNEta) {
+        Int_t ieta = (Int_t)etaCell;
+        Int_t iphi = PhiCell(phi);
+        for (Int_t jeta = TMath::Max(ieta - 1, 0); jeta <= TMath::Min(ieta + 1, fNEta - 1); jeta++) {
+          for (Int_t dphi = -1; dphi <= 1; dphi++) {
+            Int_t cell = jeta * fNPhi + (iphi + dphi + fNPhi) % fNPhi;
+            ids.insert(ids.end(), fCellIds.begin() + fCellStart[cell], fCellIds.begin() + fCellStart[cell + 1]);
+          }
+        }
+      }
+    }
+    std::sort(ids.begin(), ids.end());
+  }
+
+ protected:
+  static Bool_t IsFinite(Double_t eta, Double_t phi) { return TMath::Finite(eta) && TMath::Finite(phi); }
+  static Bool_t IsBinned(Double_t eta, Double_t phi) { return IsFinite(eta, phi) && TMath::Abs(eta) < 10; }
+
+  Int_t EtaCell(Double_t eta) const
+  {
+    Int_t ieta = (Int_t)((eta - fEtaMin) / fCellSize);
+    return TMath::Min(TMath::Max(ieta, 0), fNEta - 1);
+  }
+
+  Int_t PhiCell(Double_t phi) const
+  {
+    Double_t phi02pi = phi - TMath::TwoPi() * TMath::Floor(phi / TMath::TwoPi());
+    Int_t iphi = (Int_t)(phi02pi / TMath::TwoPi() * fNPhi);
+    return TMath::Min(TMath::Max(iphi, 0), fNPhi - 1);
+  }
+
+  Double_t             fCellSize;   ///< cell size (maximum distance with a safety margin)
+  Double_t             fEtaMin;     ///< lower eta edge of the grid
+  Int_t                fNEta;       ///< number of cells in eta
+  Int_t                fNPhi;       ///< number of cells in phi (0: no grid)
+  std::vector<Int_t>   fIds;        ///< ids of the objects
+  std::vector<Double_t> fEtas;      ///< eta of the objects
+  std::vector<Double_t> fPhis;      ///< phi of the objects
+  std::vector<Int_t>   fCellStart;  ///< first entry of each cell in fCellIds
+  std::vector<Int_t>   fCellIds;    ///< ids of the objects grouped by cell, in increasing order in each cell
+  std::vector<Int_t>   fAlwaysIds;  ///< ids of the objects not binned
+  std::vector<Int_t>   fAllIds;     ///< ids of all objects
+};
+
+#endif
+#endif
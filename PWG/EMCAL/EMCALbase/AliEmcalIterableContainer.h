@@ -151,7 +151,8 @@ public:
       }
       else {
         this->fCurrentElement.second = (*fkData)[fCurrent];
-        fkData->GetContainer()->GetMomentum(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
+        if (fkData->fUseCache) fkData->GetContainer()->GetCachedMomentum(this->fCurrentElement.first, fCurrent);
+        else fkData->GetContainer()->GetMomentum(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
       }
     }
   };
@@ -217,6 +218,7 @@ private:
   const AliEmcalContainer     *fkContainer;         ///< Container to be iterated over
   TArrayI                     fAcceptIndices;       ///< Array of accepted indices
   Bool_t                      fUseAccepted;         ///< Switch between accepted and all objects
+  Bool_t                      fUseCache;            ///< Accepted indices and momenta taken from the container cache
 
   inline int GetInternalIndex(int index) const {
     if (fUseAccepted) {
@@ -243,7 +245,8 @@ template <typename T, typename STAR>
 AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT():
   fkContainer(NULL),
   fAcceptIndices(),
-  fUseAccepted(kFALSE)
+  fUseAccepted(kFALSE),
+  fUseCache(kFALSE)
 {
 
 }
@@ -258,7 +261,8 @@ template <typename T, typename STAR>
 AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT(const AliEmcalContainer *cont, bool useAccept):
   fkContainer(cont),
   fAcceptIndices(),
-  fUseAccepted(useAccept)
+  fUseAccepted(useAccept),
+  fUseCache(kFALSE)
 {
   if (fUseAccepted) BuildAcceptIndices();
 }
@@ -272,7 +276,8 @@ template <typename T, typename STAR>
 AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT(const AliEmcalIterableContainerT<T, STAR> &ref):
   fkContainer(ref.fkContainer),
   fAcceptIndices(ref.fAcceptIndices),
-  fUseAccepted(ref.fUseAccepted)
+  fUseAccepted(ref.fUseAccepted),
+  fUseCache(ref.fUseCache)
 {
 
 }
@@ -289,6 +294,7 @@ AliEmcalIterableContainerT<T, STAR> &AliEmcalIterableContainerT<T, STAR>::operat
     fkContainer = ref.fkContainer;
     fAcceptIndices = ref.fAcceptIndices;
     fUseAccepted = ref.fUseAccepted;
+    fUseCache = ref.fUseCache;
   }
   return *this;
 }
@@ -328,17 +334,27 @@ T *AliEmcalIterableContainerT<T, STAR>::operator[](int index) const {
 
 /**
  * Build list of accepted indices inside the container.
- * For this all objects inside the container are checked
- * for being accepted or not.
+ * If the container caches the accepted objects of the event,
+ * the list (and the momenta) are taken from the cache. Otherwise
+ * all objects inside the container are checked for being
+ * accepted or not, in a single pass.
  */
 template <typename T, typename STAR>
 void AliEmcalIterableContainerT<T, STAR>::BuildAcceptIndices(){
-  fAcceptIndices.Set(fkContainer->GetNAcceptEntries());
+  if (fkContainer->GetUseKinematicsCache()) {
+    const std::vector<Int_t> &indices = fkContainer->GetAcceptedIndices();
+    fAcceptIndices.Set(indices.size());
+    for(unsigned int i = 0; i < indices.size(); i++) fAcceptIndices[i] = indices[i];
+    fUseCache = kTRUE;
+    return;
+  }
+  fAcceptIndices.Set(fkContainer->GetNEntries());
   int acceptCounter = 0;
   for(int index = 0; index < fkContainer->GetNEntries(); index++){
     UInt_t rejectionReason = 0;
     if(fkContainer->AcceptObject(index, rejectionReason)) fAcceptIndices[acceptCounter++] = index;
   }
+  fAcceptIndices.Set(acceptCounter);
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -0,0 +1,182 @@
+//
+// Per-event cache of the track extrapolation to the EMCal surface
+//
+
+#include "AliEmcalTrackExtrapolationCache.h"
+
+#include <TTree.h>
+
+#include <AliAnalysisManager.h>
+#include <AliEMCALRecoUtils.h>
+#include <AliVTrack.h>
+
+/**
+ * Compare two sets of extrapolation settings.
+ * @param other settings to compare to
+ * @return true if all settings are identical
+ */
+bool AliEmcalTrackExtrapolationCache::Settings::operator==(const Settings &other) const
+{
+  return fDist == other.fDist && fMass == other.fMass && fStep == other.fStep && fMinPt == other.fMinPt &&
+      fUseMassForTracking == other.fUseMassForTracking && fUseDCA == other.fUseDCA && fUseOuterParam == other.fUseOuterParam;
+}
+
+/**
+ * Constructor: empty cache.
+ */
+AliEmcalTrackExtrapolationCache::AliEmcalTrackExtrapolationCache() :
+  fSettings(),
+  fResults(),
+  fEntry(-1),
+  fTree(0),
+  fNPropagations(0),
+  fNCacheHits(0)
+{
+}
+
+/**
+ * Access to the cache shared by all tasks.
+ * @return the cache
+ */
+AliEmcalTrackExtrapolationCache &AliEmcalTrackExtrapolationCache::Instance()
+{
+  static AliEmcalTrackExtrapolationCache instance;
+  return instance;
+}
+
+/**
+ * Remove all cached extrapolations. The settings are kept, as they are usually the same in the next event.
+ */
+void AliEmcalTrackExtrapolationCache::Reset()
+{
+  for (auto &results : fResults) results.clear();
+}
+
+/**
+ * Clear the cache if the analysis manager moved to another event.
+ */
+void AliEmcalTrackExtrapolationCache::CheckEvent()
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr) return;
+  Long64_t entry = mgr->GetCurrentEntry();
+  const TTree *tree = mgr->GetTree();
+  if (entry != fEntry || tree != fTree) {
+    Reset();
+    fEntry = entry;
+    fTree = tree;
+  }
+}
+
+/**
+ * Get the cached results for a set of settings.
+ * @param settings extrapolation settings
+ * @return results for these settings, by track
+ */
+AliEmcalTrackExtrapolationCache::ResultMap &AliEmcalTrackExtrapolationCache::GetResults(const Settings &settings)
+{
+  for (UInt_t i = 0; i < fSettings.size(); i++) {
+    if (fSettings[i] == settings) return fResults[i];
+  }
+  fSettings.push_back(settings);
+  fResults.push_back(ResultMap());
+  return fResults.back();
+}
+
+/**
+ * Find the cached result of a track.
+ * @param results cached results
+ * @param track track
+ * @param result cached result (if found)
+ * @return true if the track has a valid cached result
+ */
+Bool_t AliEmcalTrackExtrapolationCache::FindResult(const ResultMap &results, AliVTrack *track, const Result *&result)
+{
+  auto it = results.find(track);
+  if (it == results.end()) return kFALSE;
+  if (it->second.fID != track->GetID() || it->second.fTrackPt != track->Pt()) return kFALSE;
+  result = &(it->second);
+  return kTRUE;
+}
+
+/**
+ * Extrapolate a track with AliEMCALRecoUtils and record the values set on the track.
+ * @param track track
+ * @param settings extrapolation settings
+ * @return extrapolation result
+ */
+AliEmcalTrackExtrapolationCache::Result AliEmcalTrackExtrapolationCache::Propagate(AliVTrack *track, const Settings &settings)
+{
+  Result result;
+  result.fID = track->GetID();
+  result.fTrackPt = track->Pt();
+  result.fSuccess = AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, settings.fDist, settings.fMass, settings.fStep, settings.fMinPt,
+                                                                      settings.fUseMassForTracking, settings.fUseDCA, settings.fUseOuterParam);
+  result.fEta = track->GetTrackEtaOnEMCal();
+  result.fPhi = track->GetTrackPhiOnEMCal();
+  result.fPt = track->GetTrackPtOnEMCal();
+  return result;
+}
+
+/**
+ * Set a cached result on the track, as the extrapolation would.
+ * @param track track
+ * @param result cached result
+ */
+void AliEmcalTrackExtrapolationCache::ApplyResult(AliVTrack *track, const Result &result)
+{
+  track->SetTrackPhiEtaPtOnEMCal(result.fPhi, result.fEta, result.fPt);
+}
+
+/**
+ * Extrapolate a track to the EMCal surface, or take the extrapolation from the cache.
+ * Same arguments and effect on the track as AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface().
+ * @return true if the extrapolation succeeded
+ */
+Bool_t AliEmcalTrackExtrapolationCache::ExtrapolateTrackToEMCalSurface(AliVTrack *track, Double_t emcalR, Double_t mass, Double_t step, Double_t minpT,
+                                                                       Bool_t useMassForTracking, Bool_t useDCA, Bool_t useOuterParam)
+{
+  if (!track) return kFALSE;
+  CheckEvent();
+
+  ResultMap &results = GetResults(Settings(emcalR, mass, step, minpT, useMassForTracking, useDCA, useOuterParam));
+  const Result *cached = 0;
+  if (FindResult(results, track, cached)) {
+    fNCacheHits++;
+    ApplyResult(track, *cached);
+    return cached->fSuccess;
+  }
+
+  Result result = Propagate(track, Settings(emcalR, mass, step, minpT, useMassForTracking, useDCA, useOuterParam));
+  fNPropagations++;
+  results[track] = result;
+  return result.fSuccess;
+}
+
+/**
+ * Extrapolate a list of tracks to the EMCal surface and fill the cache. Tracks already in the cache
+ * only get the cached values. The propagation is done sequentially: the magnetic field and material
+ * lookups used by the propagation are not thread safe.
+ * @param tracks tracks to extrapolate
+ */
+void AliEmcalTrackExtrapolationCache::ExtrapolateTracksToEMCalSurface(const std::vector<AliVTrack*> &tracks, Double_t emcalR, Double_t mass, Double_t step, Double_t minpT,
+                                                                      Bool_t useMassForTracking, Bool_t useDCA, Bool_t useOuterParam)
+{
+  CheckEvent();
+
+  const Settings settings(emcalR, mass, step, minpT, useMassForTracking, useDCA, useOuterParam);
+  ResultMap &results = GetResults(settings);
+
+  for (auto track : tracks) {
+    if (!track) continue;
+    const Result *cached = 0;
+    if (FindResult(results, track, cached)) {
+      fNCacheHits++;
+      ApplyResult(track, *cached);
+    }
+    else {
+      results[track] = Propagate(track, settings);
+      fNPropagations++;
+    }
+  }
+}
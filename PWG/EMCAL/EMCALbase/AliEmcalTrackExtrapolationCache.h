@@ -0,0 +1,103 @@
+#ifndef ALIEMCALTRACKEXTRAPOLATIONCACHE_H
+#define ALIEMCALTRACKEXTRAPOLATIONCACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <Rtypes.h>
+
+class TTree;
+class AliVTrack;
+
+/**
+ * @class AliEmcalTrackExtrapolationCache
+ * @ingroup EMCALCOREFW
+ * @brief Per-event cache of the track extrapolation to the EMCal surface
+ *
+ * The track propagator task, the cluster-track matchers and user tasks call
+ * AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface() (a material-aware propagation) on the
+ * same tracks in the same event. The cache stores the result of the extrapolation (success,
+ * \f$ \eta \f$, \f$ \phi \f$ and \f$ p_{T} \f$ on the EMCal surface) for each track and set of
+ * extrapolation settings (radius, mass, step, minimum \f$ p_{T} \f$ and flags), such that the
+ * propagation is done only once per event. The cache is filled at the first request, the
+ * following requests only set the stored values on the track, as the propagation would.
+ *
+ * The cache is shared by all tasks (Instance()). It is cleared automatically when the analysis
+ * manager moves to the next entry; tasks modifying the track parameters within an event have to
+ * call Reset(). As a safety net, entries are only reused if the track ID and \f$ p_{T} \f$ did
+ * not change.
+ *
+ * ExtrapolateTracksToEMCalSurface() fills the cache for a list of tracks at once.
+ *
+ * ~~~{.cxx}
+ * AliEmcalTrackExtrapolationCache::Instance().ExtrapolateTrackToEMCalSurface(track, 440.);
+ * Float_t etaEMCal = track->GetTrackEtaOnEMCal();
+ * ~~~
+ *
+ * @date Oct 2026
+ */
+class AliEmcalTrackExtrapolationCache {
+ public:
+  /// Settings of the extrapolation (arguments of AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface)
+  struct Settings {
+    Settings(Double_t dist, Double_t mass, Double_t step, Double_t minpT, Bool_t useMassForTracking, Bool_t useDCA, Bool_t useOuterParam) :
+      fDist(dist), fMass(mass), fStep(step), fMinPt(minpT), fUseMassForTracking(useMassForTracking), fUseDCA(useDCA), fUseOuterParam(useOuterParam) {}
+    bool operator==(const Settings &other) const;
+
+    Double_t fDist;                 ///< distance to the EMCal surface
+    Double_t fMass;                 ///< mass hypothesis
+    Double_t fStep;                 ///< propagation step
+    Double_t fMinPt;                ///< minimum track pt to propagate
+    Bool_t   fUseMassForTracking;   ///< use the track mass (PID) instead of fMass
+    Bool_t   fUseDCA;               ///< start the propagation from the DCA (AOD)
+    Bool_t   fUseOuterParam;        ///< start the propagation from the outer parameters (ESD)
+  };
+
+  /// Extrapolation result of a track
+  struct Result {
+    Result() : fID(0), fTrackPt(0), fSuccess(kFALSE), fEta(0), fPhi(0), fPt(0) {}
+
+    Int_t    fID;                   ///< ID of the track (consistency check)
+    Double_t fTrackPt;              ///< pt of the track (consistency check)
+    Bool_t   fSuccess;              ///< return value of the extrapolation
+    Double_t fEta;                  ///< eta on the EMCal surface
+    Double_t fPhi;                  ///< phi on the EMCal surface
+    Double_t fPt;                   ///< pt on the EMCal surface
+  };
+
+  static AliEmcalTrackExtrapolationCache &Instance();
+
+  Bool_t   ExtrapolateTrackToEMCalSurface(AliVTrack *track, Double_t emcalR = 440, Double_t mass = 0.1396, Double_t step = 20, Double_t minpT = 0.35,
+                                          Bool_t useMassForTracking = kFALSE, Bool_t useDCA = kFALSE, Bool_t useOuterParam = kFALSE);
+  void     ExtrapolateTracksToEMCalSurface(const std::vector<AliVTrack*> &tracks, Double_t emcalR = 440, Double_t mass = 0.1396, Double_t step = 20, Double_t minpT = 0.35,
+                                           Bool_t useMassForTracking = kFALSE, Bool_t useDCA = kFALSE, Bool_t useOuterParam = kFALSE);
+  void     Reset();
+
+  ULong64_t GetNPropagations()                    const { return fNPropagations; }
+  ULong64_t GetNCacheHits()                       const { return fNCacheHits; }
+
+ protected:
+  typedef std::unordered_map<const AliVTrack*, Result> ResultMap;
+
+  AliEmcalTrackExtrapolationCache();
+  virtual ~AliEmcalTrackExtrapolationCache() {}
+
+  void       CheckEvent();
+  ResultMap &GetResults(const Settings &settings);
+  static Bool_t FindResult(const ResultMap &results, AliVTrack *track, const Result *&result);
+  static Result Propagate(AliVTrack *track, const Settings &settings);
+  static void   ApplyResult(AliVTrack *track, const Result &result);
+
+  std::vector<Settings>  fSettings;       ///< settings of the cached extrapolations
+  std::vector<ResultMap> fResults;        ///< extrapolation results for each settings, by track
+  Long64_t               fEntry;          ///< analysis manager entry of the cached event
+  const TTree           *fTree;           ///< analysis manager tree of the cached event
+  ULong64_t              fNPropagations;  ///< number of propagations done
+  ULong64_t              fNCacheHits;     ///< number of requests served from the cache
+
+ private:
+  AliEmcalTrackExtrapolationCache(const AliEmcalTrackExtrapolationCache &);            // not implemented
+  AliEmcalTrackExtrapolationCache &operator=(const AliEmcalTrackExtrapolationCache &); // not implemented
+};
+
+#endif
@@ -35,22 +35,33 @@ using namespace PWG::EMCAL;
 
 AliEmcalTrackSelResultCombined::AliEmcalTrackSelResultCombined():
   TObject(),
-  fData()
+  fData(),
+  fVariantMask(0)
 {
 
 }
 
 AliEmcalTrackSelResultCombined::AliEmcalTrackSelResultCombined(const std::vector<PWG::EMCAL::AliEmcalTrackSelResultPtr>& singleSelPointers):
   TObject(),
-  fData(singleSelPointers)
+  fData(singleSelPointers),
+  fVariantMask(0)
  {
 
  }
 
+AliEmcalTrackSelResultCombined::AliEmcalTrackSelResultCombined(const std::vector<PWG::EMCAL::AliEmcalTrackSelResultPtr>& singleSelPointers, ULong64_t variantMask):
+  TObject(),
+  fData(singleSelPointers),
+  fVariantMask(variantMask)
+{
+
+}
+
 
 AliEmcalTrackSelResultCombined::AliEmcalTrackSelResultCombined(const TObjArray *singleSelPointers):
   TObject(),
-  fData(singleSelPointers->GetEntries())
+  fData(singleSelPointers->GetEntries()),
+  fVariantMask(0)
 {
   int index(0);
   for(auto o  : *singleSelPointers) fData[index] = *static_cast<AliEmcalTrackSelResultPtr *>(o);
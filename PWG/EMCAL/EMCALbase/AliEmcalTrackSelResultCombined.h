@@ -62,17 +62,41 @@ public:
   AliEmcalTrackSelResultCombined();
   AliEmcalTrackSelResultCombined(const TObjArray *singleSelPointers);
   AliEmcalTrackSelResultCombined(const std::vector<PWG::EMCAL::AliEmcalTrackSelResultPtr>& singleSelPointers);
+  AliEmcalTrackSelResultCombined(const std::vector<PWG::EMCAL::AliEmcalTrackSelResultPtr>& singleSelPointers, ULong64_t variantMask);
   virtual ~AliEmcalTrackSelResultCombined() {}
 
   const AliEmcalTrackSelResultPtr &operator[](int index) const;
   AliEmcalTrackSelResultPtr &operator[](int index);
   Int_t GetNumberOfSelectionResults() const;
 
+  /**
+   * @brief Get the bitmask of the track selection variants passed by the track
+   *
+   * Only set by AliEmcalTrackSelectionMultiVariant: bit i is set if the track passed
+   * the variant with index i.
+   * @return Bitmask of passed variants
+   */
+  ULong64_t GetVariantMask() const { return fVariantMask; }
+
+  /**
+   * @brief Check whether the track passed a track selection variant
+   * @param[in] variant Index of the variant
+   * @return True if the track passed the variant
+   */
+  Bool_t IsVariantSelected(Int_t variant) const { return variant >= 0 && variant < 64 && (fVariantMask >> variant) & 1; }
+
+  /**
+   * @brief Set the bitmask of the track selection variants passed by the track
+   * @param[in] mask Bitmask of passed variants
+   */
+  void SetVariantMask(ULong64_t mask) { fVariantMask = mask; }
+
 private:
-  std::vector<AliEmcalTrackSelResultPtr>        fData;    ///< Single 
+  std::vector<AliEmcalTrackSelResultPtr>        fData;          ///< Single 
+  ULong64_t                                     fVariantMask;   ///< Bitmask of passed track selection variants
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTrackSelResultCombined, 1);
+  ClassDef(AliEmcalTrackSelResultCombined, 2);
   /// \endcond
 };
 
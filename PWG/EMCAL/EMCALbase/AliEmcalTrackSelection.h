@@ -339,6 +339,12 @@ public:
 	 */
 	void SetSelectionModeAll() { fSelectionModeAny = kFALSE; }
 
+	/**
+	 * @brief Check the selection mode
+	 * @return True if tracks are accepted if any of the cuts is passed, false if all cuts need to be passed
+	 */
+	Bool_t IsSelectionModeAny() const { return fSelectionModeAny; }
+
 	/**
 	 * Saving QA objects to the output list.
 	 * @param[in] outputList Common output list, used to store QA objects
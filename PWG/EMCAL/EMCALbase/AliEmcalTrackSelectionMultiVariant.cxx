@@ -0,0 +1,207 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <iostream>
+
+#include <TObjArray.h>
+
+#include "AliEmcalAODFilterBitCuts.h"
+#include "AliEmcalCutBase.h"
+#include "AliEmcalTrackSelResultCombined.h"
+#include "AliEmcalTrackSelectionMultiVariant.h"
+#include "AliEmcalVCutsWrapper.h"
+#include "AliLog.h"
+#include "AliPicoTrack.h"
+#include "AliVCuts.h"
+#include "AliVTrack.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalTrackSelectionMultiVariant)
+/// \endcond
+
+AliEmcalTrackSelectionMultiVariant::AliEmcalTrackSelectionMultiVariant():
+  AliEmcalTrackSelection(),
+  fVariantNames(),
+  fVariantPrimitives(),
+  fVariantModeAny(),
+  fVariantSelections(nullptr),
+  fPrimitiveResults()
+{
+  fSelectionModeAny = kTRUE;
+}
+
+AliEmcalTrackSelectionMultiVariant::~AliEmcalTrackSelectionMultiVariant() {
+  // Primitive cuts taken from the variant selections are owned by the variant selections
+  if(fVariantSelections) delete fVariantSelections;
+}
+
+void AliEmcalTrackSelectionMultiVariant::GenerateTrackCuts(ETrackFilterType_t type, const char* /*period*/){
+  AliErrorStream() << "Track cuts of type " << type << " cannot be generated for a multi-variant track selection. Add them as variant (AddVariant) instead." << std::endl;
+}
+
+Int_t AliEmcalTrackSelectionMultiVariant::AddPrimitiveCuts(AliVCuts *cuts){
+  if(!cuts) return -1;
+  AddTrackCuts(cuts);
+  return GetNumberOfCutObjects() - 1;
+}
+
+Int_t AliEmcalTrackSelectionMultiVariant::AddPrimitiveCuts(PWG::EMCAL::AliEmcalCutBase *cuts){
+  if(!cuts) return -1;
+  AddTrackCuts(cuts);
+  return GetNumberOfCutObjects() - 1;
+}
+
+Int_t AliEmcalTrackSelectionMultiVariant::AddVariant(const char *name, const std::vector<Int_t> &primitives, Bool_t selectionModeAny){
+  if(static_cast<Int_t>(fVariantNames.size()) >= kMaxVariants) {
+    AliErrorStream() << "Maximum number of variants (" << kMaxVariants << ") reached, variant " << name << " not added" << std::endl;
+    return -1;
+  }
+  for(auto iprim : primitives) {
+    if(iprim < 0 || iprim >= GetNumberOfCutObjects()) {
+      AliErrorStream() << "Primitive cut " << iprim << " of variant " << name << " does not exist, variant not added" << std::endl;
+      return -1;
+    }
+  }
+  if(GetVariantIndex(name) >= 0) {
+    AliWarningStream() << "Variant " << name << " defined more than once, use the index to distinguish the definitions" << std::endl;
+  }
+  fVariantNames.push_back(name);
+  fVariantPrimitives.push_back(primitives);
+  fVariantModeAny.push_back(selectionModeAny);
+  AliInfoStream() << "Added track selection variant " << name << " with " << primitives.size() << " cuts ("
+                  << GetNumberOfCutObjects() << " primitive cuts in total)" << std::endl;
+  return fVariantNames.size() - 1;
+}
+
+Int_t AliEmcalTrackSelectionMultiVariant::AddVariant(AliEmcalTrackSelection *selection, const char *name){
+  if(!selection) return -1;
+  if(static_cast<Int_t>(fVariantNames.size()) >= kMaxVariants) {
+    AliErrorStream() << "Maximum number of variants (" << kMaxVariants << ") reached, variant " << name << " not added" << std::endl;
+    delete selection;
+    return -1;
+  }
+  if(!fVariantSelections) {
+    fVariantSelections = new TObjArray;
+    fVariantSelections->SetOwner(kTRUE);
+  }
+  fVariantSelections->Add(selection);
+  if(!fListOfCuts) {
+    fListOfCuts = new TObjArray;
+    fListOfCuts->SetOwner(kTRUE);
+  }
+
+  std::vector<Int_t> primitives;
+  for(Int_t icut = 0; icut < selection->GetNumberOfCutObjects(); icut++) {
+    PWG::EMCAL::AliEmcalCutBase *cuts = selection->GetTrackCuts(icut);
+    if(!cuts) continue;
+    Int_t iprim = FindPrimitiveCuts(cuts);
+    if(iprim < 0) {
+      // The cuts stay owned by the variant selection
+      fListOfCuts->Add(new AliEmcalManagedObject(cuts, false));
+      iprim = GetNumberOfCutObjects() - 1;
+    } else {
+      AliDebugStream(1) << "Cut " << cuts->GetName() << " of variant " << name << " shared with primitive cut " << iprim << std::endl;
+    }
+    primitives.push_back(iprim);
+  }
+  return AddVariant(name, primitives, selection->IsSelectionModeAny());
+}
+
+Int_t AliEmcalTrackSelectionMultiVariant::GetVariantIndex(const char *name) const {
+  for(UInt_t ivar = 0; ivar < fVariantNames.size(); ivar++) {
+    if(fVariantNames[ivar] == name) return ivar;
+  }
+  return -1;
+}
+
+const char *AliEmcalTrackSelectionMultiVariant::GetVariantName(Int_t variant) const {
+  if(variant < 0 || variant >= static_cast<Int_t>(fVariantNames.size())) return "";
+  return fVariantNames[variant].data();
+}
+
+PWG::EMCAL::AliEmcalTrackSelResultPtr AliEmcalTrackSelectionMultiVariant::IsTrackAccepted(AliVTrack * const trk) {
+  if(!trk) return PWG::EMCAL::AliEmcalTrackSelResultPtr(nullptr, kFALSE);
+  AliVTrack *track = trk;
+  if(AliPicoTrack *picotrack = dynamic_cast<AliPicoTrack *>(trk)) {
+    track = picotrack->GetTrack();
+    if(!track) {
+      AliError("Failed getting the track underlying the pico track");
+      return PWG::EMCAL::AliEmcalTrackSelResultPtr(nullptr, kFALSE);
+    }
+  }
+
+  // Each primitive cut is evaluated once
+  const Int_t nprimitives = GetNumberOfCutObjects();
+  std::vector<PWG::EMCAL::AliEmcalTrackSelResultPtr> selectionStatus;
+  selectionStatus.reserve(nprimitives);
+  fPrimitiveResults.resize(nprimitives);
+  for(Int_t iprim = 0; iprim < nprimitives; iprim++) {
+    PWG::EMCAL::AliEmcalCutBase *cuts = static_cast<PWG::EMCAL::AliEmcalCutBase *>(static_cast<AliEmcalManagedObject *>(fListOfCuts->At(iprim))->GetObject());
+    PWG::EMCAL::AliEmcalTrackSelResultPtr cutresult = cuts->IsSelected(track);
+    fPrimitiveResults[iprim] = cutresult.GetSelectionResult();
+    selectionStatus.push_back(cutresult);
+  }
+
+  // Combine the primitive results for each variant (same logic as in the single track selections)
+  ULong64_t variantmask = 0;
+  for(UInt_t ivar = 0; ivar < fVariantPrimitives.size(); ivar++) {
+    const std::vector<Int_t> &primitives = fVariantPrimitives[ivar];
+    UInt_t npassed = 0;
+    for(auto iprim : primitives) {
+      if(fPrimitiveResults[iprim]) npassed++;
+    }
+    Bool_t selected = fVariantModeAny[ivar] ? (npassed > 0 || primitives.empty()) : (npassed == primitives.size());
+    if(selected) variantmask |= (ULong64_t(1) << ivar);
+  }
+
+  return PWG::EMCAL::AliEmcalTrackSelResultPtr(track, variantmask != 0, new PWG::EMCAL::AliEmcalTrackSelResultCombined(selectionStatus, variantmask));
+}
+
+Int_t AliEmcalTrackSelectionMultiVariant::FindPrimitiveCuts(PWG::EMCAL::AliEmcalCutBase *cuts) const {
+  if(!fListOfCuts) return -1;
+  for(Int_t iprim = 0; iprim < fListOfCuts->GetEntries(); iprim++) {
+    PWG::EMCAL::AliEmcalCutBase *primitive = static_cast<PWG::EMCAL::AliEmcalCutBase *>(static_cast<AliEmcalManagedObject *>(fListOfCuts->At(iprim))->GetObject());
+    if(IsSameCut(primitive, cuts)) return iprim;
+  }
+  return -1;
+}
+
+Bool_t AliEmcalTrackSelectionMultiVariant::IsSameCut(PWG::EMCAL::AliEmcalCutBase *first, PWG::EMCAL::AliEmcalCutBase *second) {
+  if(first == second) return kTRUE;
+  auto firstwrapper = dynamic_cast<PWG::EMCAL::AliEmcalVCutsWrapper *>(first),
+       secondwrapper = dynamic_cast<PWG::EMCAL::AliEmcalVCutsWrapper *>(second);
+  if(!(firstwrapper && secondwrapper)) return kFALSE;
+  if(firstwrapper->GetCutObject() == secondwrapper->GetCutObject()) return kTRUE;
+
+  // Filter bit cuts are fully defined by the requested bits and the selection mode
+  auto firstbits = dynamic_cast<PWG::EMCAL::AliEmcalAODFilterBitCuts *>(firstwrapper->GetCutObject()),
+       secondbits = dynamic_cast<PWG::EMCAL::AliEmcalAODFilterBitCuts *>(secondwrapper->GetCutObject());
+  if(!(firstbits && secondbits)) return kFALSE;
+  if(firstbits->IsA() != PWG::EMCAL::AliEmcalAODFilterBitCuts::Class() || secondbits->IsA() != PWG::EMCAL::AliEmcalAODFilterBitCuts::Class()) return kFALSE;
+  return firstbits->GetFilterBits() == secondbits->GetFilterBits()
+      && firstbits->GetStatusBits() == secondbits->GetStatusBits()
+      && firstbits->GetSelectionMode() == secondbits->GetSelectionMode();
+}
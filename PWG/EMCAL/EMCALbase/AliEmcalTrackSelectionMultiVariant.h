@@ -0,0 +1,185 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALTRACKSELECTIONMULTIVARIANT_H_
+#define ALIEMCALTRACKSELECTIONMULTIVARIANT_H_
+
+#include <string>
+#include <vector>
+#include "AliEmcalTrackSelection.h"
+#include "AliEmcalTrackSelResultPtr.h"
+
+class TObjArray;
+class AliVCuts;
+class AliVTrack;
+
+namespace PWG {
+namespace EMCAL {
+
+class AliEmcalCutBase;
+
+}
+}
+
+/**
+ * @class AliEmcalTrackSelectionMultiVariant
+ * @brief Track selection evaluating several track selection variants in one pass
+ * @ingroup EMCALCOREFW
+ * @since Oct 2026
+ *
+ * Analyses comparing several track definitions (hybrid, TPC-only, systematic variations of
+ * the track cuts) would need one track selection per variant, each evaluating all of its
+ * cuts for every track. This selection holds the union of the cuts of all variants (the
+ * primitive cuts) and evaluates each primitive cut only once per track. The variants are
+ * then defined as combinations (any/all) of primitive cuts.
+ *
+ * Variants can be defined either
+ * - from primitive cuts added with AddPrimitiveCuts, which can be shared between variants, or
+ * - from an existing track selection (for example created with GenerateTrackCuts). Cuts
+ *   already present as primitive cuts (the same cut object, or AOD filter bit cuts with the
+ *   same bits) are shared, the others are added as new primitive cuts.
+ *
+ * The result of IsTrackAccepted is selected if the track passes any of the variants. The user
+ * info is an AliEmcalTrackSelResultCombined with the results of the primitive cuts and the
+ * bitmask of the passed variants:
+ * ~~~{.cxx}
+ * AliEmcalTrackSelectionMultiVariant sel;
+ * Int_t hybrid = sel.AddVariant(new AliEmcalTrackSelectionAOD(AliEmcalTrackSelection::kHybridTracks, "LHC11h"), "hybrid");
+ * Int_t tpconly = sel.AddVariant(new AliEmcalTrackSelectionAOD(AliEmcalTrackSelection::kTPCOnlyTracks, "LHC11h"), "tpconly");
+ * auto result = sel.IsTrackAccepted(track);
+ * auto variants = static_cast<const PWG::EMCAL::AliEmcalTrackSelResultCombined *>(result.GetUserInfo());
+ * if(variants->IsVariantSelected(hybrid)) { ... }
+ * ~~~
+ * At most 64 variants are supported.
+ */
+class AliEmcalTrackSelectionMultiVariant : public AliEmcalTrackSelection {
+public:
+  /**
+   * @brief Default constructor
+   */
+  AliEmcalTrackSelectionMultiVariant();
+
+  /**
+   * @brief Destructor
+   *
+   * Deletes the track selections the variants were created from.
+   */
+  virtual ~AliEmcalTrackSelectionMultiVariant();
+
+  /**
+   * @brief Evaluate all primitive cuts and all variants for a track
+   *
+   * The cuts get the underlying track in case of AliPicoTracks.
+   * @param[in] trk Track to be checked
+   * @return Result (selected if any variant is passed) with the primitive cut results and the variant bitmask as user info
+   */
+  virtual PWG::EMCAL::AliEmcalTrackSelResultPtr IsTrackAccepted(AliVTrack * const trk);
+
+  /**
+   * @brief Not supported: the variants have to be added with AddVariant
+   */
+  virtual void GenerateTrackCuts(ETrackFilterType_t type, const char* period = "");
+
+  /**
+   * @brief Add a primitive cut, wrapped in the same way as in AliEmcalTrackSelection::AddTrackCuts
+   *
+   * Takes ownership over the cuts
+   * @param[in] cuts Cuts to be added
+   * @return Index of the primitive cut, to be used in AddVariant
+   */
+  Int_t AddPrimitiveCuts(AliVCuts *cuts);
+
+  /**
+   * @brief Add a primitive cut
+   *
+   * Takes ownership over the cuts
+   * @param[in] cuts Cuts to be added
+   * @return Index of the primitive cut, to be used in AddVariant
+   */
+  Int_t AddPrimitiveCuts(PWG::EMCAL::AliEmcalCutBase *cuts);
+
+  /**
+   * @brief Define a variant from primitive cuts
+   * @param[in] name Name of the variant
+   * @param[in] primitives Indices of the primitive cuts of the variant
+   * @param[in] selectionModeAny If true the variant is passed if any of the cuts is passed, otherwise all cuts need to be passed
+   * @return Index of the variant (bit in the variant mask), -1 if the variant could not be added
+   */
+  Int_t AddVariant(const char *name, const std::vector<Int_t> &primitives, Bool_t selectionModeAny = kFALSE);
+
+  /**
+   * @brief Define a variant from the cuts of a track selection
+   *
+   * Takes ownership over the track selection. Its cuts are matched to the existing primitive cuts,
+   * its selection mode is used for the variant.
+   * @param[in] selection Track selection defining the variant
+   * @param[in] name Name of the variant
+   * @return Index of the variant (bit in the variant mask), -1 if the variant could not be added
+   */
+  Int_t AddVariant(AliEmcalTrackSelection *selection, const char *name);
+
+  /**
+   * @brief Get the number of variants
+   * @return Number of variants
+   */
+  Int_t GetNumberOfVariants() const { return fVariantNames.size(); }
+
+  /**
+   * @brief Get the index of a variant
+   * @param[in] name Name of the variant
+   * @return Index of the variant (-1 if not found)
+   */
+  Int_t GetVariantIndex(const char *name) const;
+
+  /**
+   * @brief Get the name of a variant
+   * @param[in] variant Index of the variant
+   * @return Name of the variant (empty for invalid indices)
+   */
+  const char *GetVariantName(Int_t variant) const;
+
+  static const Int_t kMaxVariants = 64;     ///< Maximum number of variants (bits of the variant mask)
+
+protected:
+  Int_t FindPrimitiveCuts(PWG::EMCAL::AliEmcalCutBase *cuts) const;
+  static Bool_t IsSameCut(PWG::EMCAL::AliEmcalCutBase *first, PWG::EMCAL::AliEmcalCutBase *second);
+
+  std::vector<std::string>          fVariantNames;        ///< Names of the variants
+  std::vector<std::vector<Int_t> >  fVariantPrimitives;   ///< Indices of the primitive cuts of each variant
+  std::vector<Bool_t>               fVariantModeAny;      ///< Selection mode (any/all) of each variant
+  TObjArray                        *fVariantSelections;   ///< Track selections the variants were created from (owned)
+  std::vector<Bool_t>               fPrimitiveResults;    //!<! Results of the primitive cuts for the current track
+
+private:
+  AliEmcalTrackSelectionMultiVariant(const AliEmcalTrackSelectionMultiVariant &);
+  AliEmcalTrackSelectionMultiVariant &operator=(const AliEmcalTrackSelectionMultiVariant &);
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTrackSelectionMultiVariant, 1);
+  /// \endcond
+};
+
+#endif /* ALIEMCALTRACKSELECTIONMULTIVARIANT_H_ */
@@ -418,6 +418,7 @@ Bool_t AliParticleContainer::ApplyKinematicCuts(const AliTLorentzVector& mom, UI
  */
 Int_t AliParticleContainer::GetNAcceptedParticles() const
 {
+  if (fUseKinematicsCache) return GetAcceptedIndices().size();
   Int_t nPart = 0;
   for(int ipart = 0; ipart < this->GetNParticles(); ipart++){
     UInt_t rejectionReason = 0;
@@ -426,6 +427,17 @@ Int_t AliParticleContainer::GetNAcceptedParticles() const
   return nPart;
 }
 
+/**
+ * Charge of the \f$ i^{th} \f$ particle, stored in the kinematics cache.
+ * @param[in] i Index of the particle
+ * @return Charge of the particle (0 if the index is out of range)
+ */
+Short_t AliParticleContainer::GetObjectCharge(Int_t i) const
+{
+  AliVParticle *vp = GetParticle(i);
+  return vp ? vp->Charge() : 0;
+}
+
 /**
  * Make a title of the container name based on the min \f$ p_{t} \f$ used
  * in the particle selection process.
@@ -96,6 +96,8 @@ class AliParticleContainer : public AliEmcalContainer {
   static AliEmcalContainerIndexMap <TClonesArray, AliVParticle> fgEmcalContainerIndexMap; //!<! Mapping from containers to indices
 #endif
 
+  virtual Short_t             GetObjectCharge(Int_t i) const;
+
   Double_t                    fMinDistanceTPCSectorEdge;      ///< require minimum distance to edge of TPC sector edge
   EChargeCut_t                fChargeCut;                     ///< select particles according to their charge
   Short_t                     fGeneratorIndex;                ///< select MC particles with generator index (default = -1 = switch off selection)
@@ -21,6 +21,7 @@
 #pragma link C++ class AliEmcalTrackSelection+;
 #pragma link C++ class AliEmcalTrackSelectionESD+;
 #pragma link C++ class AliEmcalTrackSelectionAOD+;
+#pragma link C++ class AliEmcalTrackSelectionMultiVariant+;
 #pragma link C++ class AliParticleContainer+;
 #pragma link C++ class AliPicoTrack+;
 #pragma link C++ class AliMCParticleContainer+;
@@ -7,6 +7,7 @@
 
 #include <TClonesArray.h>
 #include <TClass.h>
+#include <TVector3.h>
 
 #include <AliAODCaloCluster.h>
 #include <AliESDCaloCluster.h>
@@ -16,6 +17,7 @@
 #include <AliEMCALRecoUtils.h>
 
 #include "AliEmcalParticle.h"
+#include "AliEmcalTrackExtrapolationCache.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
 
@@ -261,7 +263,7 @@ void AliEmcalClusTrackMatcherTask::GenerateEmcalParticles()
         propthistrack = kTRUE;
       }
     }
-    if (propthistrack) AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist);
+    if (propthistrack) AliEmcalTrackExtrapolationCache::Instance().ExtrapolateTrackToEMCalSurface(track, fPropDist);
 
     // Create AliEmcalParticle objects to handle the matching
     AliEmcalParticle* emcalTrack = new ((*fEmcalTracks)[fNEmcalTracks]) AliEmcalParticle(track, tracks->GetCurrentID());
@@ -283,11 +285,27 @@ void AliEmcalClusTrackMatcherTask::DoMatching()
 
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // Bin the clusters in (eta, phi): only the clusters in the cells neighbouring
+  // the track position on the EMCal surface can be within the maximum distance
+  fClusterGrid.Reset(fMaxDistance);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    fClusterGrid.AddPoint(icluster, cpos.Eta(), cpos.Phi());
+  }
+  fClusterGrid.Build();
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
+    if (!track) continue;
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    // candidates in increasing cluster index, as in a loop over all the clusters
+    fClusterGrid.GetCandidates(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), fClusterCandidates);
+    for (UInt_t icandidate = 0; icandidate < fClusterCandidates.size(); icandidate++) {
+      Int_t icluster = fClusterCandidates[icandidate];
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
 
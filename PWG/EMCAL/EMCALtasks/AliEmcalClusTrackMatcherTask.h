@@ -1,7 +1,12 @@
 #ifndef ALIEMCALCLUSTRACKMATCHERTASK_H
 #define ALIEMCALCLUSTRACKMATCHERTASK_H
 
+#include <vector>
+
 #include "AliAnalysisTaskEmcal.h"
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#include "AliEmcalEtaPhiGrid.h"
+#endif
 
 class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
  public:
@@ -46,6 +51,10 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   TH1          *fHistMatchPhiAll;       //!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!deta distribution
   TH1          *fHistMatchPhi[10][9][2]; //!dphi distribution
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  AliEmcalEtaPhiGrid fClusterGrid;      //!clusters binned in (eta,phi) for the matching
+#endif
+  std::vector<Int_t> fClusterCandidates; //!clusters which can be matched to the current track
   
  private:
   AliEmcalClusTrackMatcherTask(const AliEmcalClusTrackMatcherTask&);            // not implemented
@@ -0,0 +1,198 @@
+// AliEmcalClusterizerFastv1
+//
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <algorithm>
+
+#include <TClonesArray.h>
+#include <TMath.h>
+#include <TObjArray.h>
+
+#include "AliEMCALDigit.h"
+#include "AliEMCALGeometry.h"
+#include "AliEMCALRecPoint.h"
+#include "AliLog.h"
+#include "AliVCluster.h"
+
+#include "AliEmcalCellNeighbourTable.h"
+#include "AliEmcalClusterizerFastv1.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalClusterizerFastv1);
+/// \endcond
+
+/**
+ * Default constructor
+ */
+AliEmcalClusterizerFastv1::AliEmcalClusterizerFastv1() :
+  AliEMCALClusterizerv1(),
+  fCellTable(0),
+  fDigitOfCell(),
+  fDigits(),
+  fDigitAmps(),
+  fDigitTimes(),
+  fDigitFree(),
+  fClusterDigits(),
+  fNewDigits()
+{
+}
+
+/**
+ * Constructor with geometry
+ * @param geometry EMCal geometry
+ */
+AliEmcalClusterizerFastv1::AliEmcalClusterizerFastv1(AliEMCALGeometry *geometry) :
+  AliEMCALClusterizerv1(geometry),
+  fCellTable(0),
+  fDigitOfCell(),
+  fDigits(),
+  fDigitAmps(),
+  fDigitTimes(),
+  fDigitFree(),
+  fClusterDigits(),
+  fNewDigits()
+{
+}
+
+/**
+ * Make the rec points from the digits. The digits are calibrated and selected as in
+ * AliEMCALClusterizerv1::MakeClusters(); each digit above the seed threshold and not yet
+ * in a cluster starts a new cluster, which is grown with the side neighbours within the
+ * cluster time cut.
+ */
+void AliEmcalClusterizerFastv1::MakeClusters()
+{
+  if (!fCellTable) {
+    AliEMCALClusterizerv1::MakeClusters();
+    return;
+  }
+
+  if (!fGeom) AliFatal("Did not get geometry from EMCALLoader");
+
+  if ((Int_t)fDigitOfCell.size() != fCellTable->GetNCells()) fDigitOfCell.assign(fCellTable->GetNCells(), -1);
+
+  // The v1 digit scan treats several digits in the same cell as separate digits, which the
+  // cell map cannot represent: such events are clusterized with the v1 implementation
+  if (HasDuplicateDigits()) {
+    AliWarning("Several digits in the same cell, using the v1 clusterizer for this event");
+    AliEMCALClusterizerv1::MakeClusters();
+    return;
+  }
+
+  fRecPoints->Delete();
+  fNumberOfECAClusters = 0;
+
+  fDigits.clear();
+  fDigitAmps.clear();
+  fDigitTimes.clear();
+  fDigitFree.clear();
+
+  // Calibrate and clean up the digits
+  Float_t ehs = 0;
+  const Int_t ndigits = fDigitsArr->GetEntriesFast();
+  for (Int_t idigit = 0; idigit < ndigits; idigit++) {
+    AliEMCALDigit *digit = static_cast<AliEMCALDigit*>(fDigitsArr->At(idigit));
+    if (!digit) continue;
+
+    Float_t dEnergyCalibrated = digit->GetAmplitude();
+    Float_t time              = digit->GetTime();
+    Calibrate(dEnergyCalibrated, time, digit->GetId());
+    digit->SetCalibAmp(dEnergyCalibrated);
+    digit->SetTime(time);
+
+    if (dEnergyCalibrated < fMinECut || time > fTimeMax || time < fTimeMin) continue;
+    if (!fCellTable->IsValid(digit->GetId())) continue;
+
+    ehs += dEnergyCalibrated;
+    fDigitOfCell[digit->GetId()] = fDigits.size();
+    fDigits.push_back(digit);
+    fDigitAmps.push_back(dEnergyCalibrated);
+    fDigitTimes.push_back(time);
+    fDigitFree.push_back(kTRUE);
+  }
+
+  AliDebug(1, Form("MakeClusters: Number of digits %d  -> (e %f), ehs %f", ndigits, fMinECut, ehs));
+
+  const Int_t nused = fDigits.size();
+  for (Int_t iseed = 0; iseed < nused; iseed++) {
+    if (!fDigitFree[iseed] || !(fDigitAmps[iseed] > fECAClusteringThreshold)) continue;
+
+    // start a new tower rec point
+    if (fNumberOfECAClusters >= fRecPoints->GetSize()) fRecPoints->Expand(2*fNumberOfECAClusters+1);
+    AliEMCALRecPoint *recPoint = new AliEMCALRecPoint("");
+    fRecPoints->AddAt(recPoint, fNumberOfECAClusters);
+    fNumberOfECAClusters++;
+    recPoint->SetClusterType(AliVCluster::kEMCALClusterv1);
+    recPoint->AddDigit(*fDigits[iseed], fDigitAmps[iseed], kFALSE);
+    fDigitFree[iseed] = kFALSE;
+
+    // grow the cluster: the neighbours of each cluster digit are added in digit order
+    fClusterDigits.assign(1, iseed);
+    for (UInt_t icl = 0; icl < fClusterDigits.size(); icl++) {
+      const Int_t jdigit = fClusterDigits[icl];
+      const Int_t absId = fDigits[jdigit]->GetId();
+      const Int_t *neighbours = fCellTable->GetNeighbours(absId);
+
+      fNewDigits.clear();
+      for (Int_t ineigh = 0; ineigh < AliEmcalCellNeighbourTable::fgkNSideNeighbours; ineigh++) {
+        if (neighbours[ineigh] < 0) continue;
+        const Int_t kdigit = fDigitOfCell[neighbours[ineigh]];
+        if (kdigit < 0 || !fDigitFree[kdigit]) continue;
+        if (TMath::Abs(fDigitTimes[jdigit] - fDigitTimes[kdigit]) > fTimeCut) continue;
+        fNewDigits.push_back(kdigit);
+      }
+      std::sort(fNewDigits.begin(), fNewDigits.end());
+
+      for (UInt_t inew = 0; inew < fNewDigits.size(); inew++) {
+        const Int_t kdigit = fNewDigits[inew];
+        Bool_t shared = fCellTable->GetSuperModule(fDigits[kdigit]->GetId()) != fCellTable->GetSuperModule(absId);
+        recPoint->AddDigit(*fDigits[kdigit], fDigitAmps[kdigit], shared);
+        fDigitFree[kdigit] = kFALSE;
+        fClusterDigits.push_back(kdigit);
+      }
+    }
+
+    AliDebug(2, Form("MakeClusters: %d digits, energy %f", (Int_t)fClusterDigits.size(), recPoint->GetEnergy()));
+  }
+
+  // reset the cell map for the next event
+  for (Int_t idigit = 0; idigit < nused; idigit++) fDigitOfCell[fDigits[idigit]->GetId()] = -1;
+
+  AliDebug(1, Form("total no of clusters %d from %d digits", fNumberOfECAClusters, ndigits));
+}
+
+/**
+ * Check whether a cell has more than one digit. Only the digit IDs are read, the
+ * digits are not calibrated yet.
+ * @return true if two digits have the same cell ID
+ */
+Bool_t AliEmcalClusterizerFastv1::HasDuplicateDigits()
+{
+  Bool_t duplicates = kFALSE;
+  const Int_t ndigits = fDigitsArr->GetEntriesFast();
+  for (Int_t idigit = 0; idigit < ndigits; idigit++) {
+    AliEMCALDigit *digit = static_cast<AliEMCALDigit*>(fDigitsArr->At(idigit));
+    if (!digit || !fCellTable->IsValid(digit->GetId())) continue;
+    if (fDigitOfCell[digit->GetId()] >= 0) duplicates = kTRUE;
+    fDigitOfCell[digit->GetId()] = idigit;
+  }
+  for (Int_t idigit = 0; idigit < ndigits; idigit++) {
+    AliEMCALDigit *digit = static_cast<AliEMCALDigit*>(fDigitsArr->At(idigit));
+    if (!digit || !fCellTable->IsValid(digit->GetId())) continue;
+    fDigitOfCell[digit->GetId()] = -1;
+  }
+  return duplicates;
+}
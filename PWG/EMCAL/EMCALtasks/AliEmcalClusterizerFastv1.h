@@ -0,0 +1,60 @@
+#ifndef ALIEMCALCLUSTERIZERFASTV1_H
+#define ALIEMCALCLUSTERIZERFASTV1_H
+
+#include <vector>
+
+#include "AliEMCALClusterizerv1.h"
+
+class AliEMCALDigit;
+class AliEmcalCellNeighbourTable;
+
+/**
+ * @class AliEmcalClusterizerFastv1
+ * @ingroup EMCALCORRECTIONFW
+ * @brief v1 clusterizer using a precomputed cell neighbour table
+ *
+ * Same clustering as AliEMCALClusterizerv1, but the digits are copied once per event into flat
+ * arrays (digit index of each cell, calibrated amplitude and time of each digit) and the clusters
+ * are grown breadth-first over the side neighbours of an AliEmcalCellNeighbourTable, instead of
+ * testing every pair of digits with AliEMCALClusterizerv1::AreNeighbours(). The digits added to a
+ * cluster from a given cluster cell are taken in increasing digit index, as in the v1 digit scan,
+ * such that the rec points (cells, their order and the shared flag) are identical.
+ *
+ * Evaluation of the rec points, unfolding and calibration are inherited from AliEMCALClusterizerv1.
+ * Without a neighbour table, or in events with more than one digit in a cell, the v1 implementation
+ * is used.
+ *
+ * @date Oct 2026
+ */
+class AliEmcalClusterizerFastv1 : public AliEMCALClusterizerv1 {
+ public:
+  AliEmcalClusterizerFastv1();
+  AliEmcalClusterizerFastv1(AliEMCALGeometry *geometry);
+  virtual ~AliEmcalClusterizerFastv1() {}
+
+  void                  SetCellNeighbourTable(const AliEmcalCellNeighbourTable *table) { fCellTable = table; }
+  const AliEmcalCellNeighbourTable *GetCellNeighbourTable()                      const { return fCellTable; }
+
+ protected:
+  virtual void          MakeClusters();
+  Bool_t                HasDuplicateDigits();
+
+  const AliEmcalCellNeighbourTable *fCellTable;   //!<! cell neighbour table
+  std::vector<Int_t>    fDigitOfCell;             //!<! index in fDigits of the digit of each cell (-1: none)
+  std::vector<AliEMCALDigit*> fDigits;            //!<! digits used for clustering, in the order of the digit array
+  std::vector<Float_t>  fDigitAmps;               //!<! calibrated amplitude of the digits
+  std::vector<Float_t>  fDigitTimes;              //!<! calibrated time of the digits
+  std::vector<Bool_t>   fDigitFree;               //!<! digit not yet in a cluster
+  std::vector<Int_t>    fClusterDigits;           //!<! digits of the cluster being grown
+  std::vector<Int_t>    fNewDigits;               //!<! neighbours added from one cluster digit
+
+ private:
+  AliEmcalClusterizerFastv1(const AliEmcalClusterizerFastv1 &);            // Not implemented
+  AliEmcalClusterizerFastv1 &operator=(const AliEmcalClusterizerFastv1 &); // Not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalClusterizerFastv1, 1); // v1 clusterizer with cell neighbour table
+  /// \endcond
+};
+
+#endif
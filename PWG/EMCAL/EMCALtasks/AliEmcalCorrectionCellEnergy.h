@@ -32,6 +32,10 @@ class AliEmcalCorrectionCellEnergy : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // The QA histograms need the cells after this component, which prevents a fused cell update
+  Bool_t CanFuseCellUpdate() const { return !fCreateHisto; }
+  void FinishCellUpdate();
   
 protected:
   TH1F* fCellEnergyDistBefore;        //!<! cell energy distribution, before energy calibration
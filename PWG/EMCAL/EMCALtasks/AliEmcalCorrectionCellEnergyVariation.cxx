@@ -89,6 +89,12 @@ void AliEmcalCorrectionCellEnergyVariation::ExecOnce()
 Bool_t AliEmcalCorrectionCellEnergyVariation::Run()
 {
   AliEmcalCorrectionComponent::Run();
+
+  // The cells are updated by the correction task, see UpdateCellValues()
+  if (fFusedCellUpdate) {
+    fCellUpdatePending = kTRUE;
+    return kTRUE;
+  }
   
   Short_t  absId  =-1;
   Double_t ecell = 0;
@@ -124,6 +130,18 @@ Bool_t AliEmcalCorrectionCellEnergyVariation::Run()
   return kTRUE;
 }
 
+/**
+ * Scale the energy of one cell in the fused cell update, as in Run().
+ */
+void AliEmcalCorrectionCellEnergyVariation::UpdateCellValues(Short_t absId, Int_t iSM, Int_t iCol, Int_t iRow, Bool_t highGain, Double_t & amp, Double_t & time)
+{
+  if (fEnergyScaleFunction && amp > fMinCellE && amp < fMaxCellE) {
+    Double_t ecell = amp;
+    ecell *= fEnergyScaleFunction->Eval(ecell);
+    if (ecell > 0.) amp = ecell;
+  }
+}
+
 /**
  * Load the energy scale function TF1 from a file into the member fEnergyScaleFunction
  * @param path Path to the file containing the TF1
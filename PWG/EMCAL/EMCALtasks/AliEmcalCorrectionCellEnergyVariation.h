@@ -30,6 +30,11 @@ class AliEmcalCorrectionCellEnergyVariation : public AliEmcalCorrectionComponent
   void UserCreateOutputObjects();
   void ExecOnce();
   Bool_t Run();
+
+  // Fused cell update
+  Bool_t CanFuseCellUpdate() const { return kTRUE; }
+  void UpdateCellValues(Short_t absId, Int_t iSM, Int_t iCol, Int_t iRow, Bool_t highGain, Double_t & amp, Double_t & time);
+  void FinishCellUpdate() { fCellUpdatePending = kFALSE; }
   
 protected:
   
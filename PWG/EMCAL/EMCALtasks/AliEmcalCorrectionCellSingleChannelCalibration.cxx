@@ -117,11 +117,23 @@ Bool_t AliEmcalCorrectionCellSingleChannelCalibration::Run()
   // switch off recalibrations so those are not done multiple times
   // this is just for safety, the recalibrated flag of cell object
   // should not allow for farther processing anyways
-  fRecoUtils->SwitchOffRecalibration();
+  // (after the cell update, see FinishCellUpdate(), in case of a fused cell update)
+  if (!fFusedCellUpdate)
+    fRecoUtils->SwitchOffRecalibration();
 
   return kTRUE;
 }
 
+/**
+ * Called by the correction task after the fused cell update.
+ */
+void AliEmcalCorrectionCellSingleChannelCalibration::FinishCellUpdate()
+{
+  AliEmcalCorrectionComponent::FinishCellUpdate();
+
+  fRecoUtils->SwitchOffRecalibration();
+}
+
 /**
  * Initialize the energy calibration.
  */
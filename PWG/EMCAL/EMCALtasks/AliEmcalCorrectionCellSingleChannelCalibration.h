@@ -33,6 +33,10 @@ class AliEmcalCorrectionCellSingleChannelCalibration : public AliEmcalCorrection
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // The QA histograms need the cells after this component, which prevents a fused cell update
+  Bool_t CanFuseCellUpdate() const { return !fCreateHisto; }
+  void FinishCellUpdate();
   
  protected:
   TH1F* fCellSingleChannelEnergyDistBefore;        //!<! cell energy distribution, before energy calibration
@@ -8,6 +8,7 @@
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
 #include "AliEMCALRecoUtils.h"
+#include "AliEmcalTrackExtrapolationCache.h"
 #include "AliESDCaloCluster.h"
 #include "AliAODCaloCluster.h"
 #include "AliVParticle.h"
@@ -106,7 +107,7 @@ Bool_t AliEmcalCorrectionCellTrackMatcherAndMIPSubtraction::Run()
     for (AliParticleIterableMomentumContainer::iterator partIterator = partItCont.begin(); partIterator != partItCont.end(); ++partIterator) {
       track = static_cast<AliVTrack *>(partIterator->second);
       // Propagate the track
-      AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, 440, 0.1396, 20, 0.35, kFALSE, kTRUE, kFALSE);
+      AliEmcalTrackExtrapolationCache::Instance().ExtrapolateTrackToEMCalSurface(track, 440, 0.1396, 20, 0.35, kFALSE, kTRUE, kFALSE);
       //std::cout << "found a track with pt = " << track->Pt() << "\t eta = " << track->Eta() << "\t phi = " << track->Phi() << std::endl;
       // Check if the track is within the EMCal acceptance
       if(abs(track->Eta()) > 0.8) continue;
@@ -4,11 +4,13 @@
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
 #include <TH1.h>
+#include <TVector3.h>
 #include <TList.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
 #include "AliEMCALRecoUtils.h"
+#include "AliEmcalTrackExtrapolationCache.h"
 #include "AliESDCaloCluster.h"
 #include "AliAODCaloCluster.h"
 #include "AliVParticle.h"
@@ -343,7 +345,7 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
         }
         
         // Propagate the track
-        AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA, fUseOuterParamInESDs);
+        AliEmcalTrackExtrapolationCache::Instance().ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA, fUseOuterParamInESDs);
       }
 
       // Reset properties of the track to fix TRefArray errors which occur when AddTrackMatched(obj) is called.
@@ -378,11 +380,27 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // Bin the clusters in (eta, phi): only the clusters in the cells neighbouring
+  // the track position on the EMCal surface can be within the maximum distance
+  fClusterGrid.Reset(fMaxDistance);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    fClusterGrid.AddPoint(icluster, cpos.Eta(), cpos.Phi());
+  }
+  fClusterGrid.Build();
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
+    if (!track) continue;
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    // candidates in increasing cluster index, as in a loop over all the clusters
+    fClusterGrid.GetCandidates(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), fClusterCandidates);
+    for (UInt_t icandidate = 0; icandidate < fClusterCandidates.size(); icandidate++) {
+      Int_t icluster = fClusterCandidates[icandidate];
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
@@ -1,10 +1,13 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 #include "AliEmcalContainerIndexMap.h"
+#include "AliEmcalEtaPhiGrid.h"
 #endif
 
 class TH1;
@@ -93,7 +96,9 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   // Handle mapping between index and containers
   AliEmcalContainerIndexMap <AliClusterContainer, AliVCluster> fClusterContainerIndexMap;    //!<! Mapping between index and cluster containers
   AliEmcalContainerIndexMap <AliParticleContainer, AliVParticle> fParticleContainerIndexMap; //!<! Mapping between index and particle containers
+  AliEmcalEtaPhiGrid    fClusterGrid;   //!<! clusters binned in (eta,phi) for the matching
 #endif
+  std::vector<Int_t> fClusterCandidates; //!<! clusters which can be matched to the current track
 
   TClonesArray *fEmcalTracks;           //!<!emcal tracks
   TClonesArray *fEmcalClusters;         //!<!emcal clusters
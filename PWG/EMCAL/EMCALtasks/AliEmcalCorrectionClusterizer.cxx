@@ -43,6 +43,8 @@
 #include "AliESDEvent.h"
 #include "AliAnalysisManager.h"
 
+#include "AliEmcalCellNeighbourTable.h"
+#include "AliEmcalClusterizerFastv1.h"
 #include "AliEmcalCorrectionClusterizer.h"
 
 /// \cond CLASSIMP
@@ -93,6 +95,8 @@ AliEmcalCorrectionClusterizer::AliEmcalCorrectionClusterizer() :
   fShiftEta(2),
   fTRUShift(0),
   fTestPatternInput(kFALSE),
+  fUseFastClusterizer(kFALSE),
+  fCellNeighbourTable(0),
   fSetCellMCLabelFromCluster(0),
   fSetCellMCLabelFromEdepFrac(0),
   fRemapMCLabelForAODs(0),
@@ -115,6 +119,7 @@ AliEmcalCorrectionClusterizer::~AliEmcalCorrectionClusterizer()
   delete fClusterizer;
   delete fUnfolder;
   delete fRecParam;
+  delete fCellNeighbourTable;
 }
 
 /**
@@ -157,6 +162,7 @@ Bool_t AliEmcalCorrectionClusterizer::Initialize()
   Float_t diffEAggregation = 0.;
   GetProperty("diffEAggregation", diffEAggregation);
   GetProperty("useTestPatternForInput", fTestPatternInput);
+  GetProperty("useFastClusterizer", fUseFastClusterizer);
   
   Int_t removeNMCGenerators = 0;
   GetProperty("removeNMCGenerators", removeNMCGenerators);
@@ -862,7 +868,7 @@ void AliEmcalCorrectionClusterizer::Init()
   else
     fRecoUtils->SwitchOffDistToBadChannelRecalculation();
   
-  CheckIfRunChanged();
+  Bool_t runChanged = CheckIfRunChanged();
   
   if (fJustUnfold){
     // init the unfolding afterburner
@@ -908,13 +914,24 @@ void AliEmcalCorrectionClusterizer::Init()
     fDigitsArr->SetOwner(1);
   }
   
+  // the fast clusterizer only depends on the geometry and on the run calibration,
+  // the other clusterizers are recreated for each event as before
+  if (fClusterizer && !runChanged && fClusterizer->IsA() == AliEmcalClusterizerFastv1::Class()) return;
+  
   // then setup clusterizer
   if (fClusterizer) {
     // avoid to delete digits array
     fClusterizer->SetDigitsArr(0);
     delete fClusterizer;
   }
-  if (fRecParam->GetClusterizerFlag() == AliEMCALRecParam::kClusterizerv1)
+  if (fRecParam->GetClusterizerFlag() == AliEMCALRecParam::kClusterizerv1 && fUseFastClusterizer) {
+    if (!fCellNeighbourTable) fCellNeighbourTable = new AliEmcalCellNeighbourTable;
+    fCellNeighbourTable->Build(fGeom);
+    AliEmcalClusterizerFastv1 *clusterizer = new AliEmcalClusterizerFastv1(fGeom);
+    clusterizer->SetCellNeighbourTable(fCellNeighbourTable);
+    fClusterizer = clusterizer;
+  }
+  else if (fRecParam->GetClusterizerFlag() == AliEMCALRecParam::kClusterizerv1)
     fClusterizer = new AliEMCALClusterizerv1(fGeom);
   else if (fRecParam->GetClusterizerFlag() == AliEMCALRecParam::kClusterizerNxN) {
     AliEMCALClusterizerNxN *clusterizer = new AliEMCALClusterizerNxN(fGeom);
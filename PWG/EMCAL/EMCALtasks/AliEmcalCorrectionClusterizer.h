@@ -6,6 +6,7 @@
 #include "AliEMCALRecParam.h"
 
 class TStopwatch;
+class AliEmcalCellNeighbourTable;
 
 /**
  * @class AliEmcalCorrectionClusterizer
@@ -20,6 +21,8 @@ class TStopwatch;
  *
  * The clusterizer will use as input the cell branch specified in the %YAML config, and as output will rewrite the cluster branch specified in the %YAML config.
  *
+ * With `useFastClusterizer`, the v1 clusterizer is replaced by AliEmcalClusterizerFastv1, which gives the same clusters using a cell neighbour table built once per geometry (AliEmcalCellNeighbourTable). The fast clusterizer is only recreated when the run changes.
+ *
  * At this point the energy of the cluster will be available through `cluster->E()` where cluster is the pointer to the AliAODCaloCluster or AliESDCaloCluster object.
  *
  * Based on code in AliAnalysisTaskEMCALClusterizeFast, in turn based on code by Deepa Thomas.
@@ -87,6 +90,8 @@ protected:
   Int_t                  fShiftEta;                       ///< shift in eta (for FixedWindowsClusterizer)
   Bool_t                 fTRUShift;                       ///< shifting inside a TRU (true) or through the whole calorimeter (false) (for FixedWindowsClusterizer)
   Bool_t                 fTestPatternInput;               ///< Use test pattern as input instead of cells
+  Bool_t                 fUseFastClusterizer;             ///< Use AliEmcalClusterizerFastv1 (cell neighbour table) for the v1 clusterizer
+  AliEmcalCellNeighbourTable *fCellNeighbourTable;        //!<!cell neighbour table, built once per geometry
   
   // MC labels
   static const Int_t     fgkTotalCellNumber = 17664 ;     ///< Maximum number of cells in EMCAL/DCAL: (48*24)*(10+4/3.+6*2/3.)
@@ -118,7 +123,7 @@ protected:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterizer> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterizer, 6); // EMCal correction clusterizer component
+  ClassDef(AliEmcalCorrectionClusterizer, 7); // EMCal correction clusterizer component
   /// \endcond
 };
 
@@ -52,7 +52,11 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   fRecoUtils(0),
   fOutput(0),
   fBasePath(""),
-  fCustomBadChannelFilePath("")
+  fCustomBadChannelFilePath(""),
+  fFusedCellUpdate(kFALSE),
+  fCellUpdatePending(kFALSE),
+  fCellSortPending(kFALSE),
+  fCellUpdateBC(0)
 
 {
   fVertex[0] = 0;
@@ -88,7 +92,11 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   fRecoUtils(0),
   fOutput(0),
   fBasePath(""),
-  fCustomBadChannelFilePath("")
+  fCustomBadChannelFilePath(""),
+  fFusedCellUpdate(kFALSE),
+  fCellUpdatePending(kFALSE),
+  fCellSortPending(kFALSE),
+  fCellUpdateBC(0)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -221,12 +229,61 @@ void AliEmcalCorrectionComponent::UpdateCells()
       fRecoUtils->SetCurrentParNumber(currentParIndex);      
     }
     //end of PAR run settings
+  }
 
+  if (fFusedCellUpdate) {
+    // The cells are updated by the correction task in one loop for all the
+    // consecutive cell components, see UpdateCellValues()
+    fCellUpdateBC = bunchCrossNo;
+    fCellUpdatePending = kTRUE;
+    fCellSortPending = kTRUE;
+    return;
+  }
+
+  if (fRecoUtils){
     fRecoUtils->RecalibrateCells(fCaloCells, bunchCrossNo);
   }
   fCaloCells->Sort();
 }
 
+/**
+ * Update the amplitude and time of one cell in the fused cell update. The default
+ * implementation applies the same recalibration as AliEMCALRecoUtils::RecalibrateCells,
+ * to the values left by the previous component.
+ * @param[in] absId Absolute cell ID
+ * @param[in] iSM Super module of the cell (-1 if the cell does not exist)
+ * @param[in] iCol Column of the cell in the super module
+ * @param[in] iRow Row of the cell in the super module
+ * @param[in] highGain High gain flag of the cell
+ * @param[in,out] amp Cell amplitude
+ * @param[in,out] time Cell time
+ */
+void AliEmcalCorrectionComponent::UpdateCellValues(Short_t absId, Int_t iSM, Int_t iCol, Int_t iRow, Bool_t highGain, Double_t & amp, Double_t & time)
+{
+  if (!fRecoUtils || !fRecoUtils->IsCellRecalibrationOn()) return;
+
+  Float_t ecell = 0;
+  Double_t tcell = -1;
+  if (iSM >= 0 && fRecoUtils->AcceptCellStatus(absId, iSM, iCol, iRow)) {
+    ecell = amp;
+    tcell = time;
+    fRecoUtils->RecalibrateCellAmpTime(absId, iSM, iCol, iRow, fCellUpdateBC, !highGain, ecell, tcell);
+  }
+  amp = ecell;
+  time = tcell;
+}
+
+/**
+ * Called by the correction task after the fused cell update, for the steps of
+ * Run() following the cell update.
+ */
+void AliEmcalCorrectionComponent::FinishCellUpdate()
+{
+  if (fRecoUtils && fRecoUtils->IsCellRecalibrationOn()) fRecoUtils->SetCellsCalibrated();
+  fCellUpdatePending = kFALSE;
+  fCellSortPending = kFALSE;
+}
+
 /**
  * Check whether the run changed.
  */
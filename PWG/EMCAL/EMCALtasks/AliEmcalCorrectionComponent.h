@@ -56,6 +56,15 @@ class AliEmcalCorrectionComponent : public TNamed {
   
   void GetEtaPhiDiff(const AliVTrack *t, const AliVCluster *v, Double_t &phidiff, Double_t &etadiff);
   void UpdateCells();
+
+  // Fused cell update, steered by AliEmcalCorrectionTask
+  virtual Bool_t CanFuseCellUpdate() const { return kFALSE; }
+  virtual void UpdateCellValues(Short_t absId, Int_t iSM, Int_t iCol, Int_t iRow, Bool_t highGain, Double_t & amp, Double_t & time);
+  virtual void FinishCellUpdate();
+  void SetFusedCellUpdate(Bool_t b) { fFusedCellUpdate = b; }
+  Bool_t GetFusedCellUpdate() const { return fFusedCellUpdate; }
+  Bool_t IsCellUpdatePending() const { return fCellUpdatePending; }
+  Bool_t IsCellSortPending() const { return fCellSortPending; }
   void GetPass();
   void FillCellQA(TH1F* h);
   Int_t InitBadChannels();
@@ -136,6 +145,10 @@ class AliEmcalCorrectionComponent : public TNamed {
   
   TString                fBasePath;                       ///< Base folder path to get root files
   TString                fCustomBadChannelFilePath;       ///< Custom path to bad channel map OADB file
+  Bool_t                 fFusedCellUpdate;                //!<! Cells are updated by the correction task together with the neighbouring cell components
+  Bool_t                 fCellUpdatePending;              //!<! Cell update of this event left to the correction task
+  Bool_t                 fCellSortPending;                //!<! Cells to be sorted after the fused cell update
+  Int_t                  fCellUpdateBC;                   //!<! Bunch crossing number of the pending cell update
 
  private:
   AliEmcalCorrectionComponent(const AliEmcalCorrectionComponent &);               // Not implemented
@@ -61,6 +61,10 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fForceBeamType(kNA),
   fNeedEmcalGeom(kTRUE),
   fGeom(0),
+  fFuseCellComponents(kFALSE),
+  fFusedCellGroups(),
+  fCellIndexTable(),
+  fCellIndexTableRun(-1),
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
@@ -106,6 +110,10 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fForceBeamType(kNA),
   fNeedEmcalGeom(kTRUE),
   fGeom(0),
+  fFuseCellComponents(kFALSE),
+  fFusedCellGroups(),
+  fCellIndexTable(),
+  fCellIndexTableRun(-1),
   fParticleCollArray(),
   fClusterCollArray(),
   fCellCollArray(),
@@ -151,6 +159,10 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fForceBeamType(task.fForceBeamType),
   fNeedEmcalGeom(task.fNeedEmcalGeom),
   fGeom(task.fGeom),
+  fFuseCellComponents(task.fFuseCellComponents),
+  fFusedCellGroups(),
+  fCellIndexTable(),
+  fCellIndexTableRun(-1),
   fParticleCollArray(*(static_cast<TObjArray *>(task.fParticleCollArray.Clone()))),
   fClusterCollArray(*(static_cast<TObjArray *>(task.fClusterCollArray.Clone()))),
   fOutput(task.fOutput)                           // TODO: More care is needed here!
@@ -214,6 +226,10 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fForceBeamType, second.fForceBeamType);
   swap(first.fNeedEmcalGeom, second.fNeedEmcalGeom);
   swap(first.fGeom, second.fGeom);
+  swap(first.fFuseCellComponents, second.fFuseCellComponents);
+  swap(first.fFusedCellGroups, second.fFusedCellGroups);
+  swap(first.fCellIndexTable, second.fCellIndexTable);
+  swap(first.fCellIndexTableRun, second.fCellIndexTableRun);
   swap(first.fParticleCollArray, second.fParticleCollArray);
   swap(first.fClusterCollArray, second.fClusterCollArray);
   swap(first.fCellCollArray, second.fCellCollArray);
@@ -1204,6 +1220,125 @@ void AliEmcalCorrectionTask::ExecOnceComponents()
       AddContainersToComponent(component, AliEmcalContainerUtils::kCaloCells, true);
     }
   }
+
+  SetupFusedCellGroups();
+}
+
+/**
+ * Find the groups of consecutive cell components which can update the same cells together
+ * (see AliEmcalCorrectionComponent::CanFuseCellUpdate()). In each group with at least two
+ * components, the components no longer loop over the cells themselves: after the Run() of the
+ * last component of the group, RunFusedCellUpdate() applies all of them in a single loop.
+ */
+void AliEmcalCorrectionTask::SetupFusedCellGroups()
+{
+  fFusedCellGroups.clear();
+  if (!fFuseCellComponents) return;
+
+  std::vector <AliEmcalCorrectionComponent *> group;
+  for (auto component : fCorrectionComponents)
+  {
+    Bool_t fusable = component->CanFuseCellUpdate() && component->GetCaloCells();
+    if (!group.empty() && (!fusable || component->GetCaloCells() != group.back()->GetCaloCells())) {
+      if (group.size() > 1) fFusedCellGroups.push_back(group);
+      group.clear();
+    }
+    if (fusable) group.push_back(component);
+  }
+  if (group.size() > 1) fFusedCellGroups.push_back(group);
+
+  for (auto & fusedGroup : fFusedCellGroups)
+  {
+    std::stringstream names;
+    for (auto component : fusedGroup)
+    {
+      component->SetFusedCellUpdate(kTRUE);
+      names << " " << component->GetName();
+    }
+    AliInfoStream() << "Fused cell update for the components" << names.str() << std::endl;
+  }
+}
+
+/**
+ * Fill the super module, column and row of each absolute cell ID, as used by
+ * AliEMCALRecoUtils::AcceptCalibrateCell(), for the fused cell update. The table
+ * is rebuilt when the run changes.
+ */
+void AliEmcalCorrectionTask::BuildCellIndexTable()
+{
+  fCellIndexTableRun = InputEvent()->GetRunNumber();
+  fCellIndexTable.clear();
+
+  AliEMCALGeometry * geom = AliEMCALGeometry::GetInstance();
+  if (!geom) {
+    AliError("No instance of the geometry is available");
+    return;
+  }
+
+  Int_t nCells = 24*48*geom->GetNumberOfSuperModules();
+  fCellIndexTable.assign(3*nCells, -1);
+  for (Int_t absId = 0; absId < nCells; absId++)
+  {
+    Int_t iSM = -1, iTower = -1, iIphi = -1, iIeta = -1, iRow = -1, iCol = -1;
+    if (!geom->GetCellIndex(absId, iSM, iTower, iIphi, iIeta)) continue;
+    geom->GetCellPhiEtaIndexInSModule(iSM, iTower, iIphi, iIeta, iRow, iCol);
+    fCellIndexTable[3*absId] = iSM;
+    fCellIndexTable[3*absId+1] = iCol;
+    fCellIndexTable[3*absId+2] = iRow;
+  }
+}
+
+/**
+ * Apply the cell components of a group to the cells in a single loop. Each cell is read once,
+ * the components are applied in their order to its amplitude and time, and it is written once.
+ * The result is identical to the components running one after the other.
+ *
+ * @param[in] group Consecutive cell components updating the same cells
+ */
+void AliEmcalCorrectionTask::RunFusedCellUpdate(const std::vector <AliEmcalCorrectionComponent *> & group)
+{
+  std::vector <AliEmcalCorrectionComponent *> pending;
+  Bool_t sortCells = kFALSE;
+  for (auto component : group)
+  {
+    if (!component->IsCellUpdatePending()) continue;
+    pending.push_back(component);
+    if (component->IsCellSortPending()) sortCells = kTRUE;
+  }
+  if (pending.empty()) return;
+
+  if (fCellIndexTableRun != InputEvent()->GetRunNumber()) BuildCellIndexTable();
+  const Int_t nCells = fCellIndexTable.size() / 3;
+
+  AliVCaloCells * cells = pending.front()->GetCaloCells();
+  Short_t absId = -1;
+  Double_t amp = 0, time = 0, efrac = 0;
+  Int_t mclabel = -1;
+  for (Int_t iCell = 0; iCell < cells->GetNumberOfCells(); iCell++)
+  {
+    cells->GetCell(iCell, absId, amp, time, mclabel, efrac);
+    Bool_t highGain = cells->GetHighGain(iCell);
+
+    Int_t iSM = -1, iCol = -1, iRow = -1;
+    if (absId >= 0 && absId < nCells) {
+      iSM = fCellIndexTable[3*absId];
+      iCol = fCellIndexTable[3*absId+1];
+      iRow = fCellIndexTable[3*absId+2];
+    }
+
+    for (auto component : pending)
+    {
+      component->UpdateCellValues(absId, iSM, iCol, iRow, highGain, amp, time);
+    }
+
+    cells->SetCell(iCell, absId, amp, time, mclabel, efrac, highGain);
+  }
+  if (sortCells) cells->Sort();
+
+  for (auto component : pending)
+  {
+    component->FinishCellUpdate();
+  }
 }
 
 /**
@@ -1315,6 +1450,12 @@ Bool_t AliEmcalCorrectionTask::Run()
     component->SetVertex(fVertex);
 
     component->Run();
+
+    // Cell update of a group of cell components, after the last one of the group
+    for (auto & group : fFusedCellGroups)
+    {
+      if (group.back() == component) RunFusedCellUpdate(group);
+    }
   }
 
   PostData(1, fOutput);
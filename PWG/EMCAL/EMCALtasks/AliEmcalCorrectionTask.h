@@ -100,6 +100,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Set
   void                        SetForceBeamType(BeamType f)                          { fForceBeamType     = f                              ; }
   void                        SetNeedEmcalGeometry(Bool_t b)                        { fNeedEmcalGeom     = b                              ; }
+  void                        SetFuseCellComponents(Bool_t b)                       { fFuseCellComponents = b                             ; }
   // Centrality options
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
@@ -192,6 +193,11 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   void UserCreateOutputObjectsComponents();
   void ExecOnceComponents();
 
+  // Fused cell update of consecutive cell components
+  void SetupFusedCellGroups();
+  void BuildCellIndexTable();
+  void RunFusedCellUpdate(const std::vector <AliEmcalCorrectionComponent *> & group);
+
   // Initialization functions
   void InitializeConfiguration();
   void DetermineComponentsToExecute(std::vector <std::string> & componentsToExecute);
@@ -241,6 +247,10 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   BeamType                    fForceBeamType;              ///< forced beam type
   Bool_t                      fNeedEmcalGeom;              ///< whether or not the task needs the emcal geometry
   AliEMCALGeometry           *fGeom;                       //!<! Emcal geometry
+  Bool_t                      fFuseCellComponents;         ///< Apply consecutive cell components in a single loop over the cells (off by default)
+  std::vector <std::vector <AliEmcalCorrectionComponent *> > fFusedCellGroups; //!<! Groups of consecutive cell components updating the cells together
+  std::vector <Int_t>         fCellIndexTable;             //!<! Super module, column and row of each absolute cell ID (-1 if the cell does not exist)
+  Int_t                       fCellIndexTableRun;          //!<! Run of the cell index table
 
   TObjArray                   fParticleCollArray;          ///< Particle/track collection array
   TObjArray                   fClusterCollArray;           ///< Cluster collection array
@@ -249,7 +259,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   TList *                     fOutput;                     //!<! Output for histograms
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 9); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 10); // EMCal correction task
   /// \endcond
 };
 
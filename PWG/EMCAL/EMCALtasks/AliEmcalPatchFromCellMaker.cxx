@@ -30,6 +30,9 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker() :
   fCellTimeMin(485e-9),
   fCellTimeMax(685e-9),
   fL1Slide(0),
+  fExtraPatchDims(),
+  fExtraPatchOutNames(),
+  fExtraTriggersOut(),
   fTriggerBitConfig(0x0),
   fh3EEtaPhiCell(0),
   fh2CellEnergyVsTime(0),
@@ -42,6 +45,12 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker() :
       fPatchESimple[i][j] = 0.;
     }
  }
+  for (Int_t i = 0; i <= kPatchCols; i++) {
+    for (Int_t j = 0; j <= kPatchRows; j++) {
+      fPatchADCSum[i][j] = 0;
+      fPatchESum[i][j] = 0.;
+    }
+  }
 
   SetMakeGeneralHistograms(kTRUE);
 }
@@ -56,6 +65,9 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker(const char *name) :
   fCellTimeMin(485e-9),
   fCellTimeMax(685e-9),
   fL1Slide(0),
+  fExtraPatchDims(),
+  fExtraPatchOutNames(),
+  fExtraTriggersOut(),
   fTriggerBitConfig(0x0),
   fh3EEtaPhiCell(0),
   fh2CellEnergyVsTime(0),
@@ -68,6 +80,12 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker(const char *name) :
       fPatchESimple[i][j] = 0.;
     }
  }
+  for (Int_t i = 0; i <= kPatchCols; i++) {
+    for (Int_t j = 0; j <= kPatchRows; j++) {
+      fPatchADCSum[i][j] = 0;
+      fPatchESum[i][j] = 0.;
+    }
+  }
 
   SetMakeGeneralHistograms(kTRUE);
 }
@@ -102,6 +120,20 @@ void AliEmcalPatchFromCellMaker::ExecOnce()
     }
   }
 
+  // additional patch sizes, computed from the same summed-area tables
+  fExtraTriggersOut.clear();
+  for (UInt_t ipatch = 0; ipatch < fExtraPatchDims.size(); ipatch++) {
+    TClonesArray *triggersOut = new TClonesArray("AliEMCALTriggerPatchInfo");
+    triggersOut->SetName(fExtraPatchOutNames[ipatch].c_str());
+    if (InputEvent()->FindListObject(fExtraPatchOutNames[ipatch].c_str())) {
+      fLocalInitialized = kFALSE;
+      AliFatal(Form("%s: Container with same name %s already present. Aborting", GetName(), fExtraPatchOutNames[ipatch].c_str()));
+      return;
+    }
+    InputEvent()->AddObject(triggersOut);
+    fExtraTriggersOut.push_back(triggersOut);
+  }
+
   if(!fTriggerBitConfig)
     fTriggerBitConfig = new AliEMCALTriggerBitConfigNew();
 
@@ -181,6 +213,7 @@ Bool_t AliEmcalPatchFromCellMaker::Run()
   // Main loop, called for each event.
   
   fCaloTriggersOut->Delete();
+  for (auto triggersOut : fExtraTriggersOut) triggersOut->Delete();
 
   if (!fCaloCells) {
     AliError(Form("Calo cells container %s not available.", fCaloCellsName.Data()));
@@ -199,7 +232,12 @@ Bool_t AliEmcalPatchFromCellMaker::Run()
     return kFALSE;
   }
 
+  BuildSummedAreaTables();
+
   RunSimpleOfflineTrigger();
+  for (UInt_t ipatch = 0; ipatch < fExtraPatchDims.size(); ipatch++) {
+    RunSimpleOfflineTrigger(fExtraPatchDims[ipatch], fExtraTriggersOut[ipatch]);
+  }
 
   Double_t sum = 0.;
   for (Int_t i = 0; i < kPatchCols; i++) {
@@ -257,34 +295,66 @@ Bool_t AliEmcalPatchFromCellMaker::FillPatchADCSimple()
   return kTRUE;
 }
 
+//________________________________________________________________________
+void AliEmcalPatchFromCellMaker::BuildSummedAreaTables()
+{
+  // Build the summed-area tables of the trigger tower ADC and energy maps:
+  // fPatchADCSum[i][j] is the sum of the towers with col < i and row < j,
+  // such that the sum of any patch is obtained from 4 entries.
+  // The ADC is truncated per tower, as in the sum over the patch towers.
+
+  for (Int_t i = 0; i <= kPatchCols; i++) {
+    fPatchADCSum[i][0] = 0;
+    fPatchESum[i][0] = 0.;
+  }
+  for (Int_t j = 0; j <= kPatchRows; j++) {
+    fPatchADCSum[0][j] = 0;
+    fPatchESum[0][j] = 0.;
+  }
+  for (Int_t i = 0; i < kPatchCols; i++) {
+    for (Int_t j = 0; j < kPatchRows; j++) {
+      fPatchADCSum[i+1][j+1] = (Long64_t)fPatchADCSimple[i][j] + fPatchADCSum[i][j+1] + fPatchADCSum[i+1][j] - fPatchADCSum[i][j];
+      fPatchESum[i+1][j+1] = fPatchESimple[i][j] + fPatchESum[i][j+1] + fPatchESum[i+1][j] - fPatchESum[i][j];
+    }
+  }
+}
+
 //________________________________________________________________________
 void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger()
 {
   // Runs a simple offline trigger algorithm.
   // It creates separate patches with dimension fPatchDim
 
+  RunSimpleOfflineTrigger(fPatchDim, fCaloTriggersOut);
+}
+
+//________________________________________________________________________
+void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger(Int_t patchDim, TClonesArray *triggersOut)
+{
+  // Runs a simple offline trigger algorithm.
+  // It creates separate patches with dimension patchDim (in cells),
+  // with the patch sums from the summed-area tables (BuildSummedAreaTables)
+
   // run the trigger algo, stepping by stepsize (in trigger tower units)
   Int_t itrig = 0;
-  Int_t patchSize = GetDimFastor();
-  Int_t stepSize = GetSlidingStepSizeFastor();
+  Int_t patchSize = GetDimFastor(patchDim);
+  Int_t stepSize = GetSlidingStepSizeFastor(patchDim);
+  if (patchSize <= 0 || stepSize <= 0) {
+    AliError(Form("%s: Invalid patch dimension %d", GetName(), patchDim));
+    return;
+  }
   Int_t maxCol = kPatchCols - patchSize;
   //  Int_t maxRow = kPatchRows - patchSize;
   Int_t maxRow = fGeom->GetNTotalTRU()*2 - patchSize; //apparently this is the total TRU in phi ??
+  // the tower maps only have kPatchRows rows
+  if (maxRow > kPatchRows - patchSize) maxRow = kPatchRows - patchSize;
   //  Printf("fGeom->GetNTotalTRU(): %d %d = %d x %d ;  %d x %d",fGeom->GetNTRU(),fGeom->GetNTotalTRU(),fGeom->GetNTRUEta(),fGeom->GetNTRUPhi(),fGeom->GetNModulesInTRUEta(),fGeom->GetNModulesInTRUPhi());
 
   for (Int_t i = 0; i <= maxCol; i += stepSize) {
     for (Int_t j = 0; j <= maxRow; j += stepSize) {
-      // get the trigger towers composing the patch
-      Int_t   adcAmp = 0;
-      Double_t enAmp = 0.;
-      // window
-      for (Int_t k = 0; k < patchSize; ++k) {
-        for (Int_t l = 0; l < patchSize; ++l) {
-	  // add amplitudes
-          adcAmp += (ULong64_t)fPatchADCSimple[i+k][j+l];
-	  enAmp += fPatchESimple[i+k][j+l];
-	}
-      }
+      // sum of the trigger towers composing the patch
+      Int_t   adcAmp = fPatchADCSum[i+patchSize][j+patchSize] - fPatchADCSum[i][j+patchSize] - fPatchADCSum[i+patchSize][j] + fPatchADCSum[i][j];
+      Double_t enAmp = fPatchESum[i+patchSize][j+patchSize] - fPatchESum[i][j+patchSize] - fPatchESum[i+patchSize][j] + fPatchESum[i][j];
 
       if (adcAmp == 0) {
 	AliDebug(2,"EMCal trigger patch with 0 ADC counts.");
@@ -325,7 +395,7 @@ void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger()
 
       // save the trigger object
       AliEMCALTriggerPatchInfo *trigger =
-          new ((*fCaloTriggersOut)[itrig]) AliEMCALTriggerPatchInfo();
+          new ((*triggersOut)[itrig]) AliEMCALTriggerPatchInfo();
       itrig++;
       trigger->SetTriggerBitConfig(fTriggerBitConfig);
       trigger->SetCenterGeo(centerGeo, enAmp);
@@ -340,16 +410,16 @@ void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger()
 }
 
 //________________________________________________________________________
-Int_t AliEmcalPatchFromCellMaker::GetDimFastor() const {
+Int_t AliEmcalPatchFromCellMaker::GetDimFastor(Int_t patchDim) const {
 
-  Int_t dim = TMath::FloorNint((Double_t)(fPatchDim/2.));
+  Int_t dim = TMath::FloorNint((Double_t)(patchDim/2.));
   return dim;
 }
 
 //________________________________________________________________________
-Int_t AliEmcalPatchFromCellMaker::GetSlidingStepSizeFastor() const {
+Int_t AliEmcalPatchFromCellMaker::GetSlidingStepSizeFastor(Int_t patchDim) const {
 
-  Int_t dim = GetDimFastor();
+  Int_t dim = GetDimFastor(patchDim);
   if(!fL1Slide) return dim;
 
   if(dim==2) return 2;
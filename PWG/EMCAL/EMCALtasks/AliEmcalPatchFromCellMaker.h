@@ -5,6 +5,9 @@ class TClonesArray;
 class TH3F;
 class AliEMCALTriggerBitConfig;
 
+#include <string>
+#include <vector>
+
 #include "AliAnalysisTaskEmcal.h"
 
 class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
@@ -18,6 +21,7 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   void               SetMinCellE(Double_t e)                           { fMinCellE            = e;    }
   void               SetCellTimeCuts(Double_t min, Double_t max)       { fCellTimeMin = min; fCellTimeMax = max; }
   void               ActivateSlidingPatch(Bool_t b)                    { fL1Slide             = b;    }
+  void               AddPatchDimension(Int_t i, const char *name)      { fExtraPatchDims.push_back(i); fExtraPatchOutNames.push_back(name); }
 
  protected:
   enum{
@@ -31,25 +35,34 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   void               UserCreateOutputObjects();
 
   Bool_t             FillPatchADCSimple();
+  void               BuildSummedAreaTables();
   void               RunSimpleOfflineTrigger();
+  void               RunSimpleOfflineTrigger(Int_t patchDim, TClonesArray *triggersOut);
 
   //Getters
   Int_t              GetPatchDimension() const                         { return fPatchDim;  }
   Double_t           GetPatchArea() const                              { return (Double_t)(fPatchDim*fPatchDim)*0.014*0.014; }
-  Int_t              GetDimFastor() const;
-  Int_t              GetSlidingStepSizeFastor() const;
+  Int_t              GetDimFastor() const                              { return GetDimFastor(fPatchDim); }
+  Int_t              GetSlidingStepSizeFastor() const                  { return GetSlidingStepSizeFastor(fPatchDim); }
+  Int_t              GetDimFastor(Int_t patchDim) const;
+  Int_t              GetSlidingStepSizeFastor(Int_t patchDim) const;
 
   TString            fCaloTriggersOutName;  // name of output patch array
   TClonesArray      *fCaloTriggersOut;      //!trigger array out
       
   Double_t           fPatchADCSimple[kPatchCols][kPatchRows];   // patch map for simple offline trigger
   Double_t           fPatchESimple[kPatchCols][kPatchRows];     // patch map for simple offline trigger
+  Long64_t           fPatchADCSum[kPatchCols+1][kPatchRows+1];  //! summed-area table of fPatchADCSimple (towers below (col,row))
+  Double_t           fPatchESum[kPatchCols+1][kPatchRows+1];    //! summed-area table of fPatchESimple (towers below (col,row))
 
   Int_t              fPatchDim;             // dimension of patch in #cells
   Double_t           fMinCellE;             // minimum cell energy
   Double_t           fCellTimeMin;          // minimum time cell
   Double_t           fCellTimeMax;          // maximum time cell
   Bool_t             fL1Slide;              // sliding window on
+  std::vector<Int_t> fExtraPatchDims;       // dimensions of additional patches in #cells
+  std::vector<std::string> fExtraPatchOutNames; // names of the output arrays of the additional patches
+  std::vector<TClonesArray*> fExtraTriggersOut; //! output arrays of the additional patches
   AliEMCALTriggerBitConfig *fTriggerBitConfig; // dummy trigger bit config
 
  private:
@@ -60,6 +73,6 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   AliEmcalPatchFromCellMaker(const AliEmcalPatchFromCellMaker&);            // not implemented
   AliEmcalPatchFromCellMaker &operator=(const AliEmcalPatchFromCellMaker&); // not implemented
 
-  ClassDef(AliEmcalPatchFromCellMaker, 1); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
+  ClassDef(AliEmcalPatchFromCellMaker, 2); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
 };
 #endif
@@ -10,7 +10,7 @@
 #include <TClonesArray.h>
 
 #include <AliVTrack.h>
-#include <AliEMCALRecoUtils.h>
+#include "AliEmcalTrackExtrapolationCache.h"
 
 ClassImp(AliEmcalTrackPropagatorTask)
 
@@ -19,7 +19,8 @@ AliEmcalTrackPropagatorTask::AliEmcalTrackPropagatorTask() :
   AliAnalysisTaskEmcal("AliEmcalTrackPropagatorTask", kFALSE),
   fDist(440),
   fOnlyIfNotSet(kTRUE),
-  fOnlyIfEmcal(kTRUE)
+  fOnlyIfEmcal(kTRUE),
+  fTracksToPropagate()
 {
   // Constructor.
 }
@@ -29,7 +30,8 @@ AliEmcalTrackPropagatorTask::AliEmcalTrackPropagatorTask(const char *name) :
   AliAnalysisTaskEmcal(name, kFALSE),
   fDist(440),
   fOnlyIfNotSet(kTRUE),
-  fOnlyIfEmcal(kTRUE)
+  fOnlyIfEmcal(kTRUE),
+  fTracksToPropagate()
 {
   // Constructor.
 }
@@ -62,14 +64,17 @@ Bool_t AliEmcalTrackPropagatorTask::Run()
 
   if (!tracks) return 0;
   
+  // The extrapolations are cached for the other tasks of the event
+  fTracksToPropagate.clear();
   tracks->ResetCurrentID();
   AliVTrack* track = 0;
   while ((track = static_cast<AliVTrack*>(tracks->GetNextAcceptParticle()))) {
     if (fOnlyIfNotSet && track->IsExtrapolatedToEMCAL()) continue;
     if (fOnlyIfEmcal && !track->IsEMCAL()) continue;
     
-    AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fDist);
+    fTracksToPropagate.push_back(track);
   }
+  AliEmcalTrackExtrapolationCache::Instance().ExtrapolateTracksToEMCalSurface(fTracksToPropagate, fDist);
 
   return kTRUE;
 }
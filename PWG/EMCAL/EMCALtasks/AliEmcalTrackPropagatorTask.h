@@ -1,8 +1,12 @@
 #ifndef ALIEMCALTRACKPROPAGATORTASK_H
 #define ALIEMCALTRACKPROPAGATORTASK_H
 
+#include <vector>
+
 #include "AliAnalysisTaskEmcal.h"
 
+class AliVTrack;
+
 class AliEmcalTrackPropagatorTask : public AliAnalysisTaskEmcal {
  public:
   AliEmcalTrackPropagatorTask();
@@ -20,6 +24,7 @@ class AliEmcalTrackPropagatorTask : public AliAnalysisTaskEmcal {
   Double_t           fDist;              // distance to surface (440cm default)
   Bool_t             fOnlyIfNotSet;      // propagate only if needed
   Bool_t             fOnlyIfEmcal;       // propagate only if it is in the EMCal acceptance
+  std::vector<AliVTrack*> fTracksToPropagate; //! tracks to propagate in the current event
 
  private:
   AliEmcalTrackPropagatorTask(const AliEmcalTrackPropagatorTask&);            // not implemented
@@ -45,6 +45,7 @@
 #pragma link C++ class  AliEmcalCorrectionCellCombineCollections+;
 #pragma link C++ class  AliEmcalCorrectionCellCloneContainer+;
 #pragma link C++ class  AliEmcalCorrectionClusterizer+;
+#pragma link C++ class  AliEmcalClusterizerFastv1+;
 #pragma link C++ class  AliEmcalCorrectionClusterNonLinearity+;
 #pragma link C++ class  AliEmcalCorrectionClusterNonLinearityMCAfterburner+;
 #pragma link C++ class  AliEmcalCorrectionClusterExotics+;
@@ -64,8 +64,11 @@ AliEmcalJet::AliEmcalJet() :
   fJetShapeProperties(0),
   fJetAcceptanceType(0),
   fParticleConstituents(),
-  fClusterConstituents()
+  fClusterConstituents(),
+  fArena(0),
+  fArenaConstituentsDone(kFALSE)
 {
+  ResetArena();
   fClosestJets[0] = 0;
   fClosestJets[1] = 0;
   fClosestJetsDist[0] = 999;
@@ -116,8 +119,11 @@ AliEmcalJet::AliEmcalJet(Double_t px, Double_t py, Double_t pz) :
   fJetShapeProperties(0),
   fJetAcceptanceType(0),
   fParticleConstituents(),
-  fClusterConstituents()
+  fClusterConstituents(),
+  fArena(0),
+  fArenaConstituentsDone(kFALSE)
 {
+  ResetArena();
   if (fPt != 0) {
     fPhi = TVector2::Phi_0_2pi(TMath::ATan2(py, px));
   }
@@ -173,8 +179,11 @@ AliEmcalJet::AliEmcalJet(Double_t pt, Double_t eta, Double_t phi, Double_t m) :
   fJetShapeProperties(0),
   fJetAcceptanceType(0),
   fParticleConstituents(),
-  fClusterConstituents()
+  fClusterConstituents(),
+  fArena(0),
+  fArenaConstituentsDone(kFALSE)
 {
+  ResetArena();
   fPhi = TVector2::Phi_0_2pi(fPhi);
 
   fClosestJets[0] = 0;
@@ -224,10 +233,18 @@ AliEmcalJet::AliEmcalJet(const AliEmcalJet& jet) :
   fJetShapeProperties(0),
   fJetAcceptanceType(jet.fJetAcceptanceType),
   fParticleConstituents(jet.fParticleConstituents),
-  fClusterConstituents(jet.fClusterConstituents)
-
+  fClusterConstituents(jet.fClusterConstituents),
+  fArena(jet.fArena),
+  fArenaConstituentsDone(jet.fArenaConstituentsDone)
 {
   // Copy constructor.
+  for (Int_t i = 0; i < PWG::JETFW::AliEmcalJetConstituentArena::kNConstituentTypes; i++) {
+    fArenaOffset[i] = jet.fArenaOffset[i];
+    fArenaN[i]      = jet.fArenaN[i];
+  }
+  // the copy may outlive the event arena
+  DetachFromArena();
+
   fClosestJets[0]     = jet.fClosestJets[0];
   fClosestJets[1]     = jet.fClosestJets[1];
   fClosestJetsDist[0] = jet.fClosestJetsDist[0];
@@ -296,6 +313,14 @@ AliEmcalJet& AliEmcalJet::operator=(const AliEmcalJet& jet)
     fJetAcceptanceType  = jet.fJetAcceptanceType;
     fParticleConstituents = jet.fParticleConstituents;
     fClusterConstituents = jet.fClusterConstituents;
+    fArena = jet.fArena;
+    fArenaConstituentsDone = jet.fArenaConstituentsDone;
+    for (Int_t i = 0; i < PWG::JETFW::AliEmcalJetConstituentArena::kNConstituentTypes; i++) {
+      fArenaOffset[i] = jet.fArenaOffset[i];
+      fArenaN[i]      = jet.fArenaN[i];
+    }
+    // the copy may outlive the event arena
+    DetachFromArena();
   }
 
   return *this;
@@ -385,10 +410,11 @@ TLorentzVector AliEmcalJet::SubtractRhoVect(Double_t rho, Bool_t save)
 
 /**
  *  Sort constituent by index (increasing).
- *
+ *  The constituents stored in an arena are already sorted.
  */
 void AliEmcalJet::SortConstituents()
 {
+  if (fArena) return;
   std::sort(fClusterIDs.GetArray(), fClusterIDs.GetArray() + fClusterIDs.GetSize());
   std::sort(fTrackIDs.GetArray(), fTrackIDs.GetArray() + fTrackIDs.GetSize());
 }
@@ -428,13 +454,21 @@ std::vector<int> AliEmcalJet::GetPtSortedTrackConstituentIndexes(TClonesArray* t
   // Create vector for Pt sorting
   std::vector<ptidx_pair> pair_list;
 
-  for (Int_t i_entry = 0; i_entry < GetNumberOfTracks(); i_entry++) {
-    AliVParticle* track = Track(i_entry);
-    if (!track) {
-      AliError(Form("Unable to find jet track %d in collection %s (pos in collection %d, max %d)", i_entry, tracks->GetName(), TrackAt(i_entry), tracks->GetEntriesFast()));
-      continue;
+  // The arena holds the constituent pt: no need to access the tracks
+  if (fArena) {
+    const Double_t *pts = fArena->GetPts() + fArenaOffset[kArenaTrack];
+    pair_list.reserve(fArenaN[kArenaTrack]);
+    for (UInt_t i_entry = 0; i_entry < fArenaN[kArenaTrack]; i_entry++) pair_list.push_back(std::make_pair(pts[i_entry], (Int_t)i_entry));
+  }
+  else {
+    for (Int_t i_entry = 0; i_entry < GetNumberOfTracks(); i_entry++) {
+      AliVParticle* track = Track(i_entry);
+      if (!track) {
+        AliError(Form("Unable to find jet track %d in collection %s (pos in collection %d, max %d)", i_entry, tracks->GetName(), TrackAt(i_entry), tracks->GetEntriesFast()));
+        continue;
+      }
+      pair_list.push_back(std::make_pair(track->Pt(), i_entry));
     }
-    pair_list.push_back(std::make_pair(track->Pt(), i_entry));
   }
 
   std::stable_sort(pair_list.begin() , pair_list.end() , sort_descend());
@@ -540,8 +574,8 @@ void AliEmcalJet::ResetMatching()
  */
 Int_t AliEmcalJet::ContainsTrack(Int_t it) const
 {
-  for (Int_t i = 0; i < fTrackIDs.GetSize(); i++) {
-    if (it == fTrackIDs[i]) return i;
+  for (Int_t i = 0; i < GetNumberOfTracks(); i++) {
+    if (it == TrackAt(i)) return i;
   }
   return -1;
 }
@@ -553,8 +587,8 @@ Int_t AliEmcalJet::ContainsTrack(Int_t it) const
  */
 Int_t AliEmcalJet::ContainsCluster(Int_t ic) const
 {
-  for (Int_t i = 0; i < fClusterIDs.GetSize(); i++) {
-    if (ic == fClusterIDs[i]) return i;
+  for (Int_t i = 0; i < GetNumberOfClusters(); i++) {
+    if (ic == ClusterAt(i)) return i;
   }
   return -1;
 }
@@ -654,12 +688,126 @@ std::ostream &operator<<(std::ostream &in, const AliEmcalJet &myjet) {
  */
 void AliEmcalJet::AddGhost(const Double_t dPx, const Double_t dPy, const Double_t dPz, const Double_t dE)
 {
+  DetachFromArena();
   TLorentzVector ghost(dPx, dPy, dPz, dE);
   fGhosts.push_back(ghost);
   if (!fHasGhost) fHasGhost = kTRUE;
   return;
 }
 
+/**
+ * Get the ghost particles of the jet (filled by the jet finder if requested).
+ * @return Vector of the ghost particles
+ */
+const std::vector<TLorentzVector> AliEmcalJet::GetGhosts() const
+{
+  if (!fArena) return fGhosts;
+
+  std::vector<TLorentzVector> ghosts(fArenaN[kArenaGhost]);
+  for (UInt_t i = 0; i < fArenaN[kArenaGhost]; i++) {
+    UInt_t pos = fArenaOffset[kArenaGhost] + i;
+    ghosts[i].SetPtEtaPhiM(fArena->GetPt(pos), fArena->GetEta(pos), fArena->GetPhi(pos), fArena->GetM(pos));
+  }
+  return ghosts;
+}
+
+/**
+ * Attach the jet to the constituents stored in an event arena. Called by
+ * PWG::JETFW::AliEmcalJetConstituentArena::FinishJet(): the constituents previously assigned
+ * to the jet are replaced by those of the arena.
+ * @param arena Arena holding the constituents
+ * @param offsets Offset of the track, cluster and ghost constituents in the arena
+ * @param counts Number of track, cluster and ghost constituents
+ */
+void AliEmcalJet::SetConstituentArena(const PWG::JETFW::AliEmcalJetConstituentArena *arena, const UInt_t *offsets, const UInt_t *counts)
+{
+  fClusterIDs.Set(0);
+  fTrackIDs.Set(0);
+  fGhosts.clear();
+  fParticleConstituents.clear();
+  fClusterConstituents.clear();
+
+  fArena = arena;
+  for (Int_t i = 0; i < PWG::JETFW::AliEmcalJetConstituentArena::kNConstituentTypes; i++) {
+    fArenaOffset[i] = offsets[i];
+    fArenaN[i]      = counts[i];
+  }
+  fArenaConstituentsDone = kFALSE;
+  fHasGhost = fArenaN[kArenaGhost] > 0;
+}
+
+/**
+ * Reset the position of the jet in the constituent arena.
+ */
+void AliEmcalJet::ResetArena()
+{
+  fArena = 0;
+  for (Int_t i = 0; i < PWG::JETFW::AliEmcalJetConstituentArena::kNConstituentTypes; i++) {
+    fArenaOffset[i] = 0;
+    fArenaN[i]      = 0;
+  }
+  fArenaConstituentsDone = kFALSE;
+}
+
+/**
+ * Create the particle and cluster constituent objects from the arena, on the first request,
+ * if the arena provides them (same objects as filled by the jet finder without arena).
+ */
+void AliEmcalJet::CreateArenaConstituents() const
+{
+  if (!fArena || fArenaConstituentsDone) return;
+  fArenaConstituentsDone = kTRUE;
+  if (!fArena->GetConstituentObjects()) return;
+
+  fParticleConstituents.clear();
+  fParticleConstituents.reserve(fArenaN[kArenaTrack]);
+  for (UInt_t i = 0; i < fArenaN[kArenaTrack]; i++) {
+    UInt_t pos = fArenaOffset[kArenaTrack] + i;
+    AliVParticle *part = Track(i);
+    if (!part) continue;
+    PWG::JETFW::AliEmcalParticleJetConstituent constituent(part);
+    constituent.SetIsFromEmbeddedEvent(fArena->IsFromEmbeddedEvent(pos));
+    constituent.SetGlobalIndex(fArena->GetIndex(pos));
+    fParticleConstituents.push_back(constituent);
+  }
+
+  fClusterConstituents.clear();
+  fClusterConstituents.reserve(fArenaN[kArenaCluster]);
+  for (UInt_t i = 0; i < fArenaN[kArenaCluster]; i++) {
+    UInt_t pos = fArenaOffset[kArenaCluster] + i;
+    AliVCluster *clust = Cluster(i);
+    if (!clust) continue;
+    Double_t pt = fArena->GetPt(pos);
+    Double_t pvec[3] = {pt * TMath::Cos(fArena->GetPhi(pos)), pt * TMath::Sin(fArena->GetPhi(pos)), pt * TMath::SinH(fArena->GetEta(pos))};
+    PWG::JETFW::AliEmcalClusterJetConstituent constituent(clust, (AliVCluster::VCluUserDefEnergy_t)fArena->GetEnergyDefinition(pos), pvec);
+    constituent.SetIsFromEmbeddedEvent(fArena->IsFromEmbeddedEvent(pos));
+    constituent.SetGlobalIndex(fArena->GetIndex(pos));
+    fClusterConstituents.push_back(constituent);
+  }
+}
+
+/**
+ * Copy the constituents from the arena into the jet (index arrays, constituent objects, ghosts).
+ * The jet no longer refers to the arena.
+ */
+void AliEmcalJet::CopyArenaConstituents()
+{
+  CreateArenaConstituents();
+
+  Int_t ntracks = GetNumberOfTracks();
+  Int_t nclusters = GetNumberOfClusters();
+  TArrayI trackIDs(ntracks);
+  TArrayI clusterIDs(nclusters);
+  for (Int_t i = 0; i < ntracks; i++) trackIDs[i] = TrackAt(i);
+  for (Int_t i = 0; i < nclusters; i++) clusterIDs[i] = ClusterAt(i);
+  std::vector<TLorentzVector> ghosts(GetGhosts());
+
+  ResetArena();
+  fTrackIDs = trackIDs;
+  fClusterIDs = clusterIDs;
+  fGhosts = ghosts;
+}
+
 /**
  * Clear this object: remove matching information, jet constituents, ghosts
  */
@@ -677,6 +825,7 @@ void AliEmcalJet::Clear(Option_t */*option*/)
   fHasGhost = kFALSE;
   fClusterConstituents.clear();
   fParticleConstituents.clear();
+  ResetArena();
 }
 
 /**
@@ -765,15 +914,15 @@ Int_t AliEmcalJet::ContainsCluster(AliVCluster* cluster, TClonesArray* clusters)
 }
 
 const PWG::JETFW::AliEmcalClusterJetConstituent *AliEmcalJet::ClusterConstituentAt(unsigned int icl) const {
-  return (icl < fClusterConstituents.size()) ? &fClusterConstituents[icl] : nullptr;
+  return (icl < GetClusterConstituents().size()) ? &fClusterConstituents[icl] : nullptr;
 }
 
 const PWG::JETFW::AliEmcalParticleJetConstituent *AliEmcalJet::ParticleConstituentAt(unsigned int ipart) const {
-  return (ipart < fParticleConstituents.size()) ? &fParticleConstituents[ipart] : nullptr;
+  return (ipart < GetParticleConstituents().size()) ? &fParticleConstituents[ipart] : nullptr;
 }
 
 const PWG::JETFW::AliEmcalClusterJetConstituent *AliEmcalJet::GetLeadingClusterConstituent() const {
-  if(!fClusterConstituents.size()) return nullptr;
+  if(!GetClusterConstituents().size()) return nullptr;
   const PWG::JETFW::AliEmcalClusterJetConstituent *leading(nullptr);
   for(const auto &c : fClusterConstituents) {
     if(!leading) leading = &c;
@@ -785,7 +934,7 @@ const PWG::JETFW::AliEmcalClusterJetConstituent *AliEmcalJet::GetLeadingClusterC
 }
 
 const PWG::JETFW::AliEmcalParticleJetConstituent *AliEmcalJet::GetLeadingParticleConstituent() const {
-  if(!fParticleConstituents.size()) return nullptr;
+  if(!GetParticleConstituents().size()) return nullptr;
   const PWG::JETFW::AliEmcalParticleJetConstituent *leading(nullptr);
   for(const auto &p : fParticleConstituents) {
     if(!leading) leading = &p;
@@ -799,7 +948,7 @@ const PWG::JETFW::AliEmcalParticleJetConstituent *AliEmcalJet::GetLeadingParticl
 bool AliEmcalJet::HasClusterConstituent(const AliVCluster *const clust) const {
   PWG::JETFW::AliEmcalClusterJetConstituent test(clust);
   bool found(false);
-  for(auto c : fClusterConstituents) {
+  for(auto c : GetClusterConstituents()) {
     if(test == c) {
       found = true;
       break;
@@ -811,7 +960,7 @@ bool AliEmcalJet::HasClusterConstituent(const AliVCluster *const clust) const {
 bool AliEmcalJet::HasParticleConstituent(const AliVParticle *const part) const {
   PWG::JETFW::AliEmcalParticleJetConstituent test(part);
   bool found(false);
-  for(auto p : fParticleConstituents) {
+  for(auto p : GetParticleConstituents()) {
     if(test == p) {
       found = true;
       break;
@@ -861,6 +1010,7 @@ void AliEmcalJet::AddParticleConstituent(const AliVParticle *const part, Bool_t
 }
 
 void AliEmcalJet::AddParticleConstituent(const PWG::JETFW::AliEmcalParticleJetConstituent &part){
+  DetachFromArena();
   fParticleConstituents.emplace_back(part);
 }
 
@@ -873,6 +1023,7 @@ void AliEmcalJet::AddClusterConstituent(const AliVCluster *const clust, AliVClus
 }
 
 void AliEmcalJet::AddClusterConstituent(const PWG::JETFW::AliEmcalClusterJetConstituent &clust) {
+  DetachFromArena();
   fClusterConstituents.emplace_back(clust);
 }
 
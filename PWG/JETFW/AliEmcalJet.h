@@ -22,6 +22,7 @@
 #include "AliEmcalJetShapeProperties.h"
 #include "AliEmcalClusterJetConstituent.h"
 #include "AliEmcalParticleJetConstituent.h"
+#include "AliEmcalJetConstituentArena.h"
 
 /**
  * @class AliEmcalJet
@@ -47,6 +48,12 @@
  *
  * Constituents are distinguished between cluster type (EMCAL/PHOS cluster) and particle
  * type (track / particle) constituents.
+ *
+ * The jet finder can store the constituents of all jets of the event in a
+ * PWG::JETFW::AliEmcalJetConstituentArena: the jet then only keeps the offset and the number
+ * of its constituents in the arena, and the constituent accessors (TrackAt(), ClusterAt(),
+ * GetParticleConstituents(), GetGhosts(), ...) read from it. Such jets are valid within the event;
+ * copies of the jet, or DetachFromArena(), take their own copy of the constituents.
  */
 class AliEmcalJet : public AliVParticle
 {
@@ -134,9 +141,9 @@ class AliEmcalJet : public AliVParticle
   Double_t          AreaE()                      const { return fAreaE                   ; }
   Double_t          AreaEmc()                    const { return fAreaEmc                 ; }
   Bool_t            AxisInEmcal()                const { return fAxisInEmcal             ; }
-  Int_t             ClusterAt(Int_t idx)         const { return fClusterIDs.At(idx)      ; }
-  UShort_t          GetNumberOfClusters()        const { return fClusterIDs.GetSize()    ; }
-  UShort_t          GetNumberOfTracks()          const { return fTrackIDs.GetSize()      ; }
+  Int_t             ClusterAt(Int_t idx)         const { return fArena ? fArena->GetIndex(fArenaOffset[kArenaCluster] + idx) : fClusterIDs.At(idx); }
+  UShort_t          GetNumberOfClusters()        const { return fArena ? fArenaN[kArenaCluster] : fClusterIDs.GetSize(); }
+  UShort_t          GetNumberOfTracks()          const { return fArena ? fArenaN[kArenaTrack] : fTrackIDs.GetSize()    ; }
   UShort_t          GetNumberOfConstituents()    const { return GetNumberOfClusters()+GetNumberOfTracks(); }
   Double_t          FracEmcalArea()              const { return fAreaEmc/fArea           ; }
   Bool_t            IsInsideEmcal()              const { return (fAreaEmc/fArea>0.999)   ; }
@@ -157,7 +164,7 @@ class AliEmcalJet : public AliVParticle
   Double_t          PtEmc()                      const { return fPtEmc                   ; }
   Double_t          PtSub()                      const { return fPtSub                   ; }
   Double_t          PtSubVect()                  const { return fPtSubVect               ; }
-  Int_t             TrackAt(Int_t idx)           const { return fTrackIDs.At(idx)        ; }
+  Int_t             TrackAt(Int_t idx)           const { return fArena ? fArena->GetIndex(fArenaOffset[kArenaTrack] + idx) : fTrackIDs.At(idx); }
 
   // Background subtraction
   Double_t          PtSub(Double_t rho, Bool_t save = kFALSE)          ;
@@ -181,25 +188,25 @@ class AliEmcalJet : public AliVParticle
    * @brief Get container with particle (track / MC particle) constituents
    * @return Container with constituents
    */
-  const std::vector<PWG::JETFW::AliEmcalParticleJetConstituent> &GetParticleConstituents() const { return fParticleConstituents; }
+  const std::vector<PWG::JETFW::AliEmcalParticleJetConstituent> &GetParticleConstituents() const { if (fArena) CreateArenaConstituents(); return fParticleConstituents; }
 
   /**
    * @brief Get container with cluster constituents
    * @return Container with constituents
    */
-  const std::vector<PWG::JETFW::AliEmcalClusterJetConstituent> &GetClusterConstituents() const { return fClusterConstituents; }
+  const std::vector<PWG::JETFW::AliEmcalClusterJetConstituent> &GetClusterConstituents() const { if (fArena) CreateArenaConstituents(); return fClusterConstituents; }
 
   /**
    * @brief Get the number of particle constituents assigned to the given jet
    * @return Number of particle constituents
    */
-  int GetNumberOfParticleConstituents() const { return fParticleConstituents.size(); }
+  int GetNumberOfParticleConstituents() const { return GetParticleConstituents().size(); }
 
   /**
    * @brief Get the number of cluster constituents
    * @return Number of cluster constituents
    */
-  int GetNumberOfClusterConstituents() const { return fClusterConstituents.size(); }
+  int GetNumberOfClusterConstituents() const { return GetClusterConstituents().size(); }
 
   /**
    * @brief Access to the \f$ i^{th}\f$-cluster constituent
@@ -262,8 +269,8 @@ class AliEmcalJet : public AliVParticle
   void              SetMaxNeutralPt(Double32_t t)      { fMaxNPt  = t;                     }
   void              SetMaxChargedPt(Double32_t t)      { fMaxCPt  = t;                     }
   void              SetNEF(Double_t nef)               { fNEF     = nef;                   }
-  void              SetNumberOfClusters(Int_t n)       { fClusterIDs.Set(n);               }
-  void              SetNumberOfTracks(Int_t n)         { fTrackIDs.Set(n);                 }
+  void              SetNumberOfClusters(Int_t n)       { DetachFromArena(); fClusterIDs.Set(n); }
+  void              SetNumberOfTracks(Int_t n)         { DetachFromArena(); fTrackIDs.Set(n);   }
   void              SetNumberOfCharged(Int_t n)        { fNch = n;                         }
   void              SetNumberOfNeutrals(Int_t n)       { fNn = n;                          }
   void              SetMCPt(Double_t p)                { fMCPt = p;                        }
@@ -271,8 +278,8 @@ class AliEmcalJet : public AliVParticle
   void              SetPtEmc(Double_t pt)              { fPtEmc          = pt;             }
   void              SetPtSub(Double_t ps)              { fPtSub          = ps;             }
   void              SetPtSubVect(Double_t ps)          { fPtSubVect      = ps;             }
-  void              AddClusterAt(Int_t clus, Int_t idx){ fClusterIDs.AddAt(clus, idx);     }
-  void              AddTrackAt(Int_t track, Int_t idx) { fTrackIDs.AddAt(track, idx);      }
+  void              AddClusterAt(Int_t clus, Int_t idx){ DetachFromArena(); fClusterIDs.AddAt(clus, idx); }
+  void              AddTrackAt(Int_t track, Int_t idx) { DetachFromArena(); fTrackIDs.AddAt(track, idx);  }
   void              Clear(Option_t */*option*/="");
 
   /**
@@ -354,7 +361,29 @@ class AliEmcalJet : public AliVParticle
   // Ghosts
   void AddGhost(const Double_t dPx, const Double_t dPy, const Double_t dPz, const Double_t dE);
   Bool_t HasGhost() const                               { return fHasGhost; }
-  const std::vector<TLorentzVector> GetGhosts()   const { return fGhosts  ; }
+  const std::vector<TLorentzVector> GetGhosts()   const;
+
+  // Constituent arena
+  /**
+   * @brief Attach the jet to the constituents stored in an event arena (called by the arena)
+   * @param[in] arena Arena holding the constituents
+   * @param[in] offsets Offset of the track, cluster and ghost constituents in the arena
+   * @param[in] counts Number of track, cluster and ghost constituents
+   */
+  void              SetConstituentArena(const PWG::JETFW::AliEmcalJetConstituentArena *arena, const UInt_t *offsets, const UInt_t *counts);
+
+  /**
+   * @brief Copy the constituents from the arena into the jet, which no longer refers to the arena
+   */
+  void              DetachFromArena()                        { if (fArena) CopyArenaConstituents(); }
+  const PWG::JETFW::AliEmcalJetConstituentArena *GetConstituentArena() const { return fArena; }
+
+  /**
+   * @brief Position of the first constituent of a type in the arena
+   * @param[in] type Constituent type (PWG::JETFW::AliEmcalJetConstituentArena::EConstituentType_t)
+   * @return Offset in the arena columns (0 if the jet does not use an arena)
+   */
+  UInt_t            GetConstituentArenaOffset(Int_t type)    const { return fArena ? fArenaOffset[type] : 0; }
 
   // Debug printouts
   void Print(Option_t* /*opt*/ = "") const;
@@ -433,10 +462,23 @@ class AliEmcalJet : public AliVParticle
   AliEmcalJetShapeProperties *fJetShapeProperties; //!<! Pointer to the jet shape properties
   UInt_t fJetAcceptanceType;    //!<!  Jet acceptance type (stored bitwise)
 
-  std::vector<PWG::JETFW::AliEmcalParticleJetConstituent>      fParticleConstituents;  ///< List of particle constituents
-  std::vector<PWG::JETFW::AliEmcalClusterJetConstituent>       fClusterConstituents;   ///< List of cluster constituents
+  mutable std::vector<PWG::JETFW::AliEmcalParticleJetConstituent> fParticleConstituents;  ///< List of particle constituents
+  mutable std::vector<PWG::JETFW::AliEmcalClusterJetConstituent>  fClusterConstituents;   ///< List of cluster constituents
+
+  const PWG::JETFW::AliEmcalJetConstituentArena *fArena;           //!<! Event arena holding the constituents (if any)
+  UInt_t            fArenaOffset[PWG::JETFW::AliEmcalJetConstituentArena::kNConstituentTypes]; //!<! Offset of the track, cluster and ghost constituents in the arena
+  UInt_t            fArenaN[PWG::JETFW::AliEmcalJetConstituentArena::kNConstituentTypes];      //!<! Number of track, cluster and ghost constituents in the arena
+  mutable Bool_t    fArenaConstituentsDone;                         //!<! Whether the constituent objects were created from the arena
+
+  void              ResetArena();
+  void              CreateArenaConstituents() const;
+  void              CopyArenaConstituents();
 
  private:
+  static const Int_t kArenaTrack   = PWG::JETFW::AliEmcalJetConstituentArena::kTrack;    ///< Track constituents in the arena
+  static const Int_t kArenaCluster = PWG::JETFW::AliEmcalJetConstituentArena::kCluster;  ///< Cluster constituents in the arena
+  static const Int_t kArenaGhost   = PWG::JETFW::AliEmcalJetConstituentArena::kGhost;    ///< Ghosts in the arena
+
   /**
    * @struct sort_descend
    * @brief Simple C structure to allow sorting in descending order
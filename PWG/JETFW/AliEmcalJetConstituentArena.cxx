@@ -0,0 +1,98 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include "AliEmcalJetConstituentArena.h"
+
+#include <algorithm>
+
+#include "AliEmcalJet.h"
+
+namespace PWG {
+namespace JETFW {
+
+AliEmcalJetConstituentArena::AliEmcalJetConstituentArena() :
+    fIndex(),
+    fPt(),
+    fEta(),
+    fPhi(),
+    fM(),
+    fEmbedded(),
+    fEnergyDefinition(),
+    fStaging(),
+    fConstituentObjects(kFALSE)
+{
+
+}
+
+void AliEmcalJetConstituentArena::Clear() {
+  fIndex.clear();
+  fPt.clear();
+  fEta.clear();
+  fPhi.clear();
+  fM.clear();
+  fEmbedded.clear();
+  fEnergyDefinition.clear();
+  for(auto &staging : fStaging) staging.clear();
+}
+
+void AliEmcalJetConstituentArena::StartJet() {
+  for(auto &staging : fStaging) staging.clear();
+}
+
+void AliEmcalJetConstituentArena::AddConstituent(EConstituentType_t type, Int_t index, Double_t pt, Double_t eta, Double_t phi, Double_t m,
+                                                 Bool_t isFromEmbeddedEvent, Int_t energyDefinition) {
+  Entry entry = {index, pt, eta, phi, m, static_cast<UChar_t>(isFromEmbeddedEvent), static_cast<Char_t>(energyDefinition)};
+  fStaging[type].push_back(entry);
+}
+
+void AliEmcalJetConstituentArena::FinishJet(AliEmcalJet *jet) {
+  UInt_t offsets[kNConstituentTypes] = {0};
+  UInt_t counts[kNConstituentTypes] = {0};
+  for(Int_t itype = 0; itype < kNConstituentTypes; itype++) {
+    // same order as AliEmcalJet::SortConstituents(); the ghosts keep the order of the jet finder
+    if(itype != kGhost) std::sort(fStaging[itype].begin(), fStaging[itype].end());
+    offsets[itype] = fIndex.size();
+    counts[itype] = fStaging[itype].size();
+    Append(fStaging[itype]);
+    fStaging[itype].clear();
+  }
+  if(jet) jet->SetConstituentArena(this, offsets, counts);
+}
+
+void AliEmcalJetConstituentArena::Append(const std::vector<Entry> &entries) {
+  for(const auto &entry : entries) {
+    fIndex.push_back(entry.fIndex);
+    fPt.push_back(entry.fPt);
+    fEta.push_back(entry.fEta);
+    fPhi.push_back(entry.fPhi);
+    fM.push_back(entry.fM);
+    fEmbedded.push_back(entry.fEmbedded);
+    fEnergyDefinition.push_back(entry.fEnergyDefinition);
+  }
+}
+
+}
+}
@@ -0,0 +1,169 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALJETCONSTITUENTARENA_H
+#define ALIEMCALJETCONSTITUENTARENA_H
+
+#include <vector>
+
+#include <Rtypes.h>
+
+class AliEmcalJet;
+
+namespace PWG {
+
+namespace JETFW {
+
+/**
+ * @class AliEmcalJetConstituentArena
+ * @brief Event-scoped storage of the constituents of jet collections
+ * @ingroup JETFW
+ *
+ * The constituents of all jets of an event are stored contiguously, as columns of
+ * global index, \f$ p_{T} \f$, \f$ \eta \f$, \f$ \phi \f$ and mass. Each jet keeps
+ * the offset and the number of its track, cluster and ghost constituents in the arena,
+ * instead of allocating its own index arrays, constituent objects and ghost vectors.
+ * The track and cluster constituents of a jet are ordered by index, as after
+ * AliEmcalJet::SortConstituents().
+ *
+ * The arena is owned by the jet finder and cleared (keeping its capacity) at the beginning
+ * of each event, so the jets pointing to it are only valid within the event. Copies of a jet
+ * (copy constructor, assignment) take their own copy of the constituents.
+ *
+ * ~~~{.cxx}
+ * arena.StartJet();
+ * arena.AddConstituent(AliEmcalJetConstituentArena::kTrack, globalIndex, pt, eta, phi, m);
+ * arena.FinishJet(jet);
+ * ~~~
+ */
+class AliEmcalJetConstituentArena {
+public:
+  /**
+   * @enum EConstituentType_t
+   * @brief Types of jet constituents
+   */
+  enum EConstituentType_t {
+    kTrack              = 0,   ///< Track / particle constituent
+    kCluster            = 1,   ///< Cluster constituent
+    kGhost              = 2,   ///< Ghost particle
+    kNConstituentTypes  = 3
+  };
+
+  AliEmcalJetConstituentArena();
+  virtual ~AliEmcalJetConstituentArena() {}
+
+  /**
+   * @brief Remove all constituents, keeping the allocated memory
+   */
+  void Clear();
+
+  /**
+   * @brief Start the constituents of a new jet
+   */
+  void StartJet();
+
+  /**
+   * @brief Add a constituent to the jet being filled
+   * @param[in] type Constituent type
+   * @param[in] index Global index of the constituent (-1 for ghosts)
+   * @param[in] pt Transverse momentum of the constituent
+   * @param[in] eta Pseudo-rapidity of the constituent
+   * @param[in] phi Azimuthal angle of the constituent
+   * @param[in] m Mass of the constituent
+   * @param[in] isFromEmbeddedEvent Flag whether the constituent is from the embedded event
+   * @param[in] energyDefinition Energy definition of the cluster constituents (AliVCluster::VCluUserDefEnergy_t)
+   */
+  void AddConstituent(EConstituentType_t type, Int_t index, Double_t pt, Double_t eta, Double_t phi, Double_t m,
+                      Bool_t isFromEmbeddedEvent = kFALSE, Int_t energyDefinition = -1);
+
+  /**
+   * @brief Store the constituents of the jet being filled and attach them to the jet
+   * @param[in] jet Jet owning the constituents
+   */
+  void FinishJet(AliEmcalJet *jet);
+
+  UInt_t          GetSize()                            const { return fIndex.size()             ; }
+  Int_t           GetIndex(UInt_t i)                   const { return fIndex[i]                 ; }
+  Double_t        GetPt(UInt_t i)                      const { return fPt[i]                    ; }
+  Double_t        GetEta(UInt_t i)                     const { return fEta[i]                   ; }
+  Double_t        GetPhi(UInt_t i)                     const { return fPhi[i]                   ; }
+  Double_t        GetM(UInt_t i)                       const { return fM[i]                     ; }
+  Bool_t          IsFromEmbeddedEvent(UInt_t i)        const { return fEmbedded[i] != 0         ; }
+  Int_t           GetEnergyDefinition(UInt_t i)        const { return fEnergyDefinition[i]      ; }
+
+  /// Columns of the arena, for loops over the constituents of a jet
+  const Int_t    *GetIndexes()                         const { return fIndex.data()             ; }
+  const Double_t *GetPts()                             const { return fPt.data()                ; }
+  const Double_t *GetEtas()                            const { return fEta.data()               ; }
+  const Double_t *GetPhis()                            const { return fPhi.data()               ; }
+  const Double_t *GetMasses()                          const { return fM.data()                 ; }
+
+  /**
+   * @brief Whether the jets create constituent objects (AliEmcalJet::GetParticleConstituents(),
+   * AliEmcalJet::GetClusterConstituents()) from the arena on request
+   */
+  Bool_t          GetConstituentObjects()              const { return fConstituentObjects       ; }
+  void            SetConstituentObjects(Bool_t b)            { fConstituentObjects = b          ; }
+
+protected:
+  /**
+   * @struct Entry
+   * @brief Constituent of the jet being filled
+   */
+  struct Entry {
+    Int_t     fIndex;              ///< Global index
+    Double_t  fPt;                 ///< Transverse momentum
+    Double_t  fEta;                ///< Pseudo-rapidity
+    Double_t  fPhi;                ///< Azimuthal angle
+    Double_t  fM;                  ///< Mass
+    UChar_t   fEmbedded;           ///< Whether from the embedded event
+    Char_t    fEnergyDefinition;   ///< Cluster energy definition
+
+    bool operator<(const Entry &other) const { return fIndex < other.fIndex; }
+  };
+
+  void Append(const std::vector<Entry> &entries);
+
+  std::vector<Int_t>      fIndex;                           ///< Global index of the constituents
+  std::vector<Double_t>   fPt;                              ///< Transverse momentum of the constituents
+  std::vector<Double_t>   fEta;                             ///< Pseudo-rapidity of the constituents
+  std::vector<Double_t>   fPhi;                             ///< Azimuthal angle of the constituents
+  std::vector<Double_t>   fM;                               ///< Mass of the constituents
+  std::vector<UChar_t>    fEmbedded;                        ///< Whether the constituents are from the embedded event
+  std::vector<Char_t>     fEnergyDefinition;                ///< Energy definition of the cluster constituents
+  std::vector<Entry>      fStaging[kNConstituentTypes];     ///< Constituents of the jet being filled, by type
+  Bool_t                  fConstituentObjects;              ///< Whether the jets create constituent objects on request
+
+private:
+  AliEmcalJetConstituentArena(const AliEmcalJetConstituentArena &);
+  AliEmcalJetConstituentArena &operator=(const AliEmcalJetConstituentArena &);
+};
+
+}
+
+}
+
+#endif
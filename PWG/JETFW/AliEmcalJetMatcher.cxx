@@ -0,0 +1,298 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include "AliEmcalJetMatcher.h"
+
+#include <algorithm>
+
+#include <TLorentzVector.h>
+#include <TMath.h>
+#include <TVector2.h>
+
+#include "AliEmcalJet.h"
+#include "AliEmcalJetConstituentArena.h"
+#include "AliJetContainer.h"
+#include "AliParticleContainer.h"
+#include "AliVCluster.h"
+#include "AliVParticle.h"
+
+namespace PWG {
+namespace JETFW {
+
+AliEmcalJetMatcher::AliEmcalJetMatcher() :
+    fCriterion(kBijectiveClosest),
+    fMaxDistance(0.3),
+    fMinSharedFraction(0.5),
+    fVertex(),
+    fSets(),
+    fTreeEta(),
+    fTreePhi(),
+    fTreeIndex(),
+    fTree(nullptr),
+    fCandidates(),
+    fBestIndex(),
+    fBestScore(),
+    fMatches()
+{
+  fVertex[0] = fVertex[1] = fVertex[2] = 0.;
+}
+
+AliEmcalJetMatcher::~AliEmcalJetMatcher() {
+  delete fTree;
+}
+
+void AliEmcalJetMatcher::SetVertex(const Double_t *vertex) {
+  for(Int_t i = 0; i < 3; i++) fVertex[i] = vertex[i];
+}
+
+void AliEmcalJetMatcher::ObjectSet::Clear() {
+  fObjects.clear();
+  fIsJet.clear();
+  fEta.clear();
+  fPhi.clear();
+  fMatchIndex.clear();
+  fConstOffset.clear();
+  fConstituents.clear();
+}
+
+void AliEmcalJetMatcher::Clear() {
+  for(auto &objects : fSets) objects.Clear();
+  fMatches.clear();
+}
+
+Int_t AliEmcalJetMatcher::LoadJets(Int_t set, const AliJetContainer &cont) {
+  fSets[set].Clear();
+  for(auto jet : cont.accepted()) AddJet(set, jet);
+  return GetNumberOfObjects(set);
+}
+
+Int_t AliEmcalJetMatcher::LoadParticles(Int_t set, const AliParticleContainer &cont) {
+  fSets[set].Clear();
+  for(auto part : cont.accepted()) AddParticle(set, part);
+  return GetNumberOfObjects(set);
+}
+
+Int_t AliEmcalJetMatcher::AddJet(Int_t set, AliEmcalJet *jet) {
+  Int_t index = AddParticle(set, jet);
+  fSets[set].fIsJet[index] = kTRUE;
+  return index;
+}
+
+Int_t AliEmcalJetMatcher::AddParticle(Int_t set, AliVParticle *part) {
+  // the matches of the previous call to Match() do not refer to the new objects
+  if(!fMatches.empty() || !fSets[0].fMatchIndex.empty() || !fSets[1].fMatchIndex.empty()) {
+    fMatches.clear();
+    for(auto &objects : fSets) objects.fMatchIndex.clear();
+  }
+  ObjectSet &objects = fSets[set];
+  objects.fObjects.push_back(part);
+  objects.fIsJet.push_back(kFALSE);
+  objects.fEta.push_back(part->Eta());
+  objects.fPhi.push_back(TVector2::Phi_0_2pi(part->Phi()));
+  return objects.fObjects.size() - 1;
+}
+
+AliEmcalJet *AliEmcalJetMatcher::GetJet(Int_t set, Int_t i) const {
+  return fSets[set].fIsJet[i] ? static_cast<AliEmcalJet *>(fSets[set].fObjects[i]) : nullptr;
+}
+
+Int_t AliEmcalJetMatcher::GetMatchIndex(Int_t set, Int_t i) const {
+  if(set < 0 || set > 1) return -1;
+  // fMatchIndex is filled by Match() and cleared when objects are added
+  const std::vector<Int_t> &matchIndex = fSets[set].fMatchIndex;
+  if(i < 0 || i >= static_cast<Int_t>(matchIndex.size())) return -1;
+  return matchIndex[i];
+}
+
+Int_t AliEmcalJetMatcher::Match() {
+  fMatches.clear();
+  for(auto &objects : fSets) objects.fMatchIndex.assign(objects.fObjects.size(), -1);
+
+  const Int_t kN1 = fSets[0].fObjects.size(), kN2 = fSets[1].fObjects.size();
+  if(!kN1 || !kN2 || fMaxDistance <= 0.) return 0;
+
+  const Bool_t useConstituents = fCriterion == kSharedConstituents;
+  if(useConstituents) {
+    for(auto &objects : fSets) BuildConstituents(objects);
+  }
+  BuildTree();
+
+  // all pairs within the maximum distance
+  for(Int_t i1 = 0; i1 < kN1; i1++) {
+    Double_t point[2] = {fSets[0].fEta[i1], fSets[0].fPhi[i1]};
+    fCandidates.clear();
+    fTree->FindInRange(point, fMaxDistance, fCandidates);
+    for(auto &candidate : fCandidates) candidate = fTreeIndex[candidate];
+    // objects close to the phi edges are in the tree twice
+    std::sort(fCandidates.begin(), fCandidates.end());
+    fCandidates.erase(std::unique(fCandidates.begin(), fCandidates.end()), fCandidates.end());
+
+    for(auto i2 : fCandidates) {
+      Double_t distance = Distance(i1, i2);
+      if(distance >= fMaxDistance) continue;
+      MatchPair match = {i1, i2, distance, 0., 0.};
+      if(useConstituents) {
+        Double_t sharedPt2 = 0.;
+        Double_t sharedPt1 = SharedPt(fSets[0], i1, fSets[1], i2, sharedPt2);
+        if(sharedPt1 <= 0. && sharedPt2 <= 0.) continue;
+        Double_t pt1 = fSets[0].fObjects[i1]->Pt(), pt2 = fSets[1].fObjects[i2]->Pt();
+        match.fSharedFraction1 = pt1 > 0. ? sharedPt1 / pt1 : 0.;
+        match.fSharedFraction2 = pt2 > 0. ? sharedPt2 / pt2 : 0.;
+      }
+      fMatches.push_back(match);
+    }
+  }
+
+  if(fCriterion == kAllWithinDistance) return fMatches.size();
+
+  // best partner of each object among the pairs; ties go to the lowest index
+  fBestIndex[0].assign(kN1, -1);
+  fBestIndex[1].assign(kN2, -1);
+  fBestScore[0].assign(kN1, 0.);
+  fBestScore[1].assign(kN2, 0.);
+  for(const auto &match : fMatches) {
+    Double_t score1 = useConstituents ? match.fSharedFraction1 : -match.fDistance,
+             score2 = useConstituents ? match.fSharedFraction2 : -match.fDistance;
+    if(fBestIndex[0][match.fIndex1] < 0 || score1 > fBestScore[0][match.fIndex1]) {
+      fBestIndex[0][match.fIndex1] = match.fIndex2;
+      fBestScore[0][match.fIndex1] = score1;
+    }
+    if(fBestIndex[1][match.fIndex2] < 0 || score2 > fBestScore[1][match.fIndex2]) {
+      fBestIndex[1][match.fIndex2] = match.fIndex1;
+      fBestScore[1][match.fIndex2] = score2;
+    }
+  }
+
+  // keep the pairs of mutual best partners
+  UInt_t nmatches = 0;
+  for(const auto &match : fMatches) {
+    if(fBestIndex[0][match.fIndex1] != match.fIndex2 || fBestIndex[1][match.fIndex2] != match.fIndex1) continue;
+    if(useConstituents && match.fSharedFraction1 < fMinSharedFraction) continue;
+    fSets[0].fMatchIndex[match.fIndex1] = match.fIndex2;
+    fSets[1].fMatchIndex[match.fIndex2] = match.fIndex1;
+    fMatches[nmatches++] = match;
+  }
+  fMatches.resize(nmatches);
+  return nmatches;
+}
+
+void AliEmcalJetMatcher::BuildTree() {
+  const ObjectSet &objects = fSets[1];
+  fTreeEta.clear();
+  fTreePhi.clear();
+  fTreeIndex.clear();
+  for(UInt_t i = 0; i < objects.fObjects.size(); i++) {
+    fTreeEta.push_back(objects.fEta[i]);
+    fTreePhi.push_back(objects.fPhi[i]);
+    fTreeIndex.push_back(i);
+    // copies across phi = 0, so that the range search finds the pairs on both sides of the edge
+    if(objects.fPhi[i] < fMaxDistance) {
+      fTreeEta.push_back(objects.fEta[i]);
+      fTreePhi.push_back(objects.fPhi[i] + TMath::TwoPi());
+      fTreeIndex.push_back(i);
+    }
+    if(objects.fPhi[i] > TMath::TwoPi() - fMaxDistance) {
+      fTreeEta.push_back(objects.fEta[i]);
+      fTreePhi.push_back(objects.fPhi[i] - TMath::TwoPi());
+      fTreeIndex.push_back(i);
+    }
+  }
+
+  // the tree does not own the coordinates, which are kept in fTreeEta / fTreePhi;
+  // TKDTree cannot be rebuilt on new data (cached node boundaries), so a new tree is built for each Match()
+  delete fTree;
+  fTree = new TKDTreeID(fTreeEta.size(), 2, 1);
+  fTree->SetData(0, fTreeEta.data());
+  fTree->SetData(1, fTreePhi.data());
+  fTree->Build();
+}
+
+void AliEmcalJetMatcher::BuildConstituents(ObjectSet &objects) const {
+  objects.fConstOffset.assign(1, 0);
+  objects.fConstituents.clear();
+  TLorentzVector mom;
+  for(UInt_t i = 0; i < objects.fObjects.size(); i++) {
+    if(objects.fIsJet[i]) {
+      const AliEmcalJet *jet = static_cast<const AliEmcalJet *>(objects.fObjects[i]);
+      const AliEmcalJetConstituentArena *arena = jet->GetConstituentArena();
+      UInt_t first = objects.fConstituents.size();
+      for(Int_t it = 0; it < jet->GetNumberOfTracks(); it++) {
+        Double_t pt = 0.;
+        if(arena) {
+          pt = arena->GetPt(jet->GetConstituentArenaOffset(AliEmcalJetConstituentArena::kTrack) + it);
+        } else {
+          AliVParticle *track = jet->Track(it);
+          if(!track) continue;
+          pt = track->Pt();
+        }
+        objects.fConstituents.push_back(std::make_pair(jet->TrackAt(it), pt));
+      }
+      for(Int_t ic = 0; ic < jet->GetNumberOfClusters(); ic++) {
+        Double_t pt = 0.;
+        if(arena) {
+          pt = arena->GetPt(jet->GetConstituentArenaOffset(AliEmcalJetConstituentArena::kCluster) + ic);
+        } else {
+          AliVCluster *clus = jet->Cluster(ic);
+          if(!clus) continue;
+          clus->GetMomentum(mom, fVertex);
+          pt = mom.Pt();
+        }
+        objects.fConstituents.push_back(std::make_pair(-1 - jet->ClusterAt(ic), pt));
+      }
+      std::sort(objects.fConstituents.begin() + first, objects.fConstituents.end());
+    }
+    objects.fConstOffset.push_back(objects.fConstituents.size());
+  }
+}
+
+Double_t AliEmcalJetMatcher::SharedPt(const ObjectSet &set1, Int_t i1, const ObjectSet &set2, Int_t i2, Double_t &sharedPt2) const {
+  Double_t sharedPt1 = 0.;
+  sharedPt2 = 0.;
+  auto it1 = set1.fConstituents.begin() + set1.fConstOffset[i1], end1 = set1.fConstituents.begin() + set1.fConstOffset[i1 + 1];
+  auto it2 = set2.fConstituents.begin() + set2.fConstOffset[i2], end2 = set2.fConstituents.begin() + set2.fConstOffset[i2 + 1];
+  while(it1 != end1 && it2 != end2) {
+    if(it1->first < it2->first) {
+      ++it1;
+    } else if(it2->first < it1->first) {
+      ++it2;
+    } else {
+      sharedPt1 += it1->second;
+      sharedPt2 += it2->second;
+      ++it1;
+      ++it2;
+    }
+  }
+  return sharedPt1;
+}
+
+Double_t AliEmcalJetMatcher::Distance(Int_t i1, Int_t i2) const {
+  Double_t deta = fSets[0].fEta[i1] - fSets[1].fEta[i2],
+           dphi = TVector2::Phi_mpi_pi(fSets[0].fPhi[i1] - fSets[1].fPhi[i2]);
+  return TMath::Sqrt(deta * deta + dphi * dphi);
+}
+
+}
+}
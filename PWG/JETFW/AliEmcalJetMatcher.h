@@ -0,0 +1,212 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALJETMATCHER_H
+#define ALIEMCALJETMATCHER_H
+
+#include <utility>
+#include <vector>
+
+#include <Rtypes.h>
+#include <TKDTree.h>
+
+class AliEmcalJet;
+class AliJetContainer;
+class AliParticleContainer;
+class AliVParticle;
+
+namespace PWG {
+
+namespace JETFW {
+
+/**
+ * @class AliEmcalJetMatcher
+ * @brief Geometrical and constituent matching of two sets of jets or particles
+ * @ingroup JETFW
+ *
+ * The objects of the second set are stored in a kd-tree in \f$ (\eta, \phi) \f$, and
+ * for each object of the first set only the objects of the second set within the maximum
+ * distance are considered, instead of all pairs. The objects closer than the maximum distance
+ * to the \f$ \phi \f$ edges are inserted a second time shifted by \f$ 2\pi \f$, so that the pairs across
+ * \f$ \phi = 0 \f$ are found, and the distances are computed with the \f$ \Delta\phi \f$ wrapped
+ * to \f$ [-\pi, \pi) \f$.
+ *
+ * Matching criteria:
+ * - kBijectiveClosest: pairs of objects that are the closest to each other
+ * - kAllWithinDistance: all pairs within the maximum distance
+ * - kSharedConstituents: pairs of jets within the maximum distance, each one being the jet of the other set
+ *   sharing the largest fraction of its \f$ p_{T} \f$, with a shared fraction of the jet of the first set above
+ *   the minimum. The constituents are compared by global index, so the two jet sets must be built from the same
+ *   track and cluster containers (e.g. detector level and hybrid jets in embedding).
+ *
+ * The storage (objects, coordinates, constituent lists, matches) is kept across events, the kd-tree
+ * is built again by each call to Match().
+ * Adding objects to a set removes the matches of the previous call to Match().
+ *
+ * ~~~{.cxx}
+ * matcher.SetMaxDistance(0.3);
+ * matcher.LoadJets(0, *jetsDetLevel);
+ * matcher.LoadJets(1, *jetsPartLevel);
+ * matcher.Match();
+ * for(auto &match : matcher.GetMatches()) {
+ *   AliEmcalJet *jet1 = matcher.GetJet(0, match.fIndex1), *jet2 = matcher.GetJet(1, match.fIndex2);
+ *   ...
+ * }
+ * ~~~
+ */
+class AliEmcalJetMatcher {
+public:
+  /**
+   * @enum EMatchingCriterion_t
+   * @brief Matching criteria
+   */
+  enum EMatchingCriterion_t {
+    kBijectiveClosest     = 0,   ///< Mutually closest objects within the maximum distance
+    kAllWithinDistance    = 1,   ///< All pairs within the maximum distance
+    kSharedConstituents   = 2    ///< Jets sharing the largest fraction of their constituent pt
+  };
+
+  /**
+   * @struct MatchPair
+   * @brief Pair of matched objects
+   */
+  struct MatchPair {
+    Int_t     fIndex1;             ///< Index of the object in the first set
+    Int_t     fIndex2;             ///< Index of the object in the second set
+    Double_t  fDistance;           ///< Distance in \f$ (\eta, \phi) \f$
+    Double_t  fSharedFraction1;    ///< Fraction of the pt of the first jet shared with the second jet (kSharedConstituents only)
+    Double_t  fSharedFraction2;    ///< Fraction of the pt of the second jet shared with the first jet (kSharedConstituents only)
+  };
+
+  AliEmcalJetMatcher();
+  virtual ~AliEmcalJetMatcher();
+
+  void                        SetCriterion(EMatchingCriterion_t c)             { fCriterion = c                 ; }
+  void                        SetMaxDistance(Double_t d)                       { fMaxDistance = d               ; }
+  void                        SetMinSharedFraction(Double_t f)                 { fMinSharedFraction = f         ; }
+  void                        SetVertex(const Double_t *vertex);
+
+  EMatchingCriterion_t        GetCriterion()                             const { return fCriterion              ; }
+  Double_t                    GetMaxDistance()                           const { return fMaxDistance            ; }
+  Double_t                    GetMinSharedFraction()                     const { return fMinSharedFraction      ; }
+
+  /**
+   * @brief Remove the objects of both sets and the matches, keeping the allocated memory
+   */
+  void Clear();
+
+  /**
+   * @brief Replace the objects of a set with the accepted jets of a container
+   * @param[in] set Set (0 or 1)
+   * @param[in] cont Jet container
+   * @return Number of jets in the set
+   */
+  Int_t LoadJets(Int_t set, const AliJetContainer &cont);
+
+  /**
+   * @brief Replace the objects of a set with the accepted particles of a container
+   * @param[in] set Set (0 or 1)
+   * @param[in] cont Particle container
+   * @return Number of particles in the set
+   */
+  Int_t LoadParticles(Int_t set, const AliParticleContainer &cont);
+
+  /**
+   * @brief Add a jet to a set
+   * @return Index of the jet in the set
+   */
+  Int_t AddJet(Int_t set, AliEmcalJet *jet);
+
+  /**
+   * @brief Add a particle to a set (not usable with kSharedConstituents)
+   * @return Index of the particle in the set
+   */
+  Int_t AddParticle(Int_t set, AliVParticle *part);
+
+  /**
+   * @brief Match the objects of the two sets with the current criterion
+   * @return Number of matches
+   */
+  Int_t Match();
+
+  const std::vector<MatchPair> &GetMatches()                               const { return fMatches                 ; }
+  Int_t                       GetNumberOfObjects(Int_t set)              const { return fSets[set].fObjects.size(); }
+  AliVParticle               *GetObject(Int_t set, Int_t i)              const { return fSets[set].fObjects[i]     ; }
+  AliEmcalJet                *GetJet(Int_t set, Int_t i)                 const;
+
+  /**
+   * @brief Index of the object of the other set matched to an object, for the bijective criteria
+   * @return Index in the other set, -1 if the object is not matched, the indices are out of range,
+   * Match() was not called since the objects were added (or for kAllWithinDistance)
+   */
+  Int_t                       GetMatchIndex(Int_t set, Int_t i)          const;
+
+protected:
+  /**
+   * @struct ObjectSet
+   * @brief Objects of one of the sets, with their coordinates and constituent lists
+   */
+  struct ObjectSet {
+    std::vector<AliVParticle*>  fObjects;             ///< Jets or particles
+    std::vector<Bool_t>         fIsJet;               ///< Whether the object is a jet
+    std::vector<Double_t>       fEta;                 ///< Pseudo-rapidity of the objects
+    std::vector<Double_t>       fPhi;                 ///< Azimuthal angle of the objects, in \f$ [0, 2\pi) \f$
+    std::vector<Int_t>          fMatchIndex;          ///< Index of the matched object in the other set
+    std::vector<UInt_t>         fConstOffset;         ///< Offset of the constituents of each object in fConstituents (size + 1)
+    std::vector<std::pair<Int_t, Double_t> > fConstituents; ///< Key (track index, or -1 - cluster index) and pt of the constituents, sorted by key for each jet
+
+    void Clear();
+  };
+
+  void          BuildTree();
+  void          BuildConstituents(ObjectSet &objects) const;
+  Double_t      SharedPt(const ObjectSet &set1, Int_t i1, const ObjectSet &set2, Int_t i2, Double_t &sharedPt2) const;
+  Double_t      Distance(Int_t i1, Int_t i2) const;
+
+  EMatchingCriterion_t        fCriterion;             ///< Matching criterion
+  Double_t                    fMaxDistance;           ///< Maximum distance in \f$ (\eta, \phi) \f$
+  Double_t                    fMinSharedFraction;     ///< Minimum shared pt fraction of the jet of the first set (kSharedConstituents)
+  Double_t                    fVertex[3];             ///< Primary vertex, for the cluster momenta
+  ObjectSet                   fSets[2];               ///< The two sets of objects
+  std::vector<Double_t>       fTreeEta;               ///< Pseudo-rapidity of the kd-tree points
+  std::vector<Double_t>       fTreePhi;               ///< Azimuthal angle of the kd-tree points
+  std::vector<Int_t>          fTreeIndex;             ///< Index in the second set of the kd-tree points
+  TKDTreeID                  *fTree;                  ///< kd-tree of the second set
+  std::vector<Int_t>          fCandidates;            ///< Candidates of the range search
+  std::vector<Int_t>          fBestIndex[2];          ///< Best partner of the objects of each set
+  std::vector<Double_t>       fBestScore[2];          ///< Score of the best partner (minus the distance, or shared fraction)
+  std::vector<MatchPair>      fMatches;               ///< Matches of the last call to Match()
+
+private:
+  AliEmcalJetMatcher(const AliEmcalJetMatcher &);
+  AliEmcalJetMatcher &operator=(const AliEmcalJetMatcher &);
+};
+
+}
+
+}
+
+#endif
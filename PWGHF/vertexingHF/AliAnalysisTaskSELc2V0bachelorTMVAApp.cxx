@@ -75,8 +75,10 @@
 #include <TMVA/Tools.h>
 #include <TMVA/Reader.h>
 #include <TMVA/MethodCuts.h>
+#include <TFile.h>
 
 #include "IClassifierReader.h"
+#include "AliHFTMVAFlatForest.h"
 
 using std::cout;
 using std::endl;
@@ -204,6 +206,7 @@ AliAnalysisTaskSELc2V0bachelorTMVAApp::AliAnalysisTaskSELc2V0bachelorTMVAApp():
   fBDTReader(0),
   fTMVAlibName(""),
   fTMVAlibPtBin(""),
+  fFlatForestFile(""),
   fNamesTMVAVar(""),
   fBDTHisto(0),
   fBDTHistoVsMassK0S(0),
@@ -372,6 +375,7 @@ AliAnalysisTaskSELc2V0bachelorTMVAApp::AliAnalysisTaskSELc2V0bachelorTMVAApp(con
   fBDTReader(0),
   fTMVAlibName(""),
   fTMVAlibPtBin(""),
+  fFlatForestFile(""),
   fNamesTMVAVar(""),
   fBDTHisto(0),
   fBDTHistoVsMassK0S(0),
@@ -1109,7 +1113,23 @@ void AliAnalysisTaskSELc2V0bachelorTMVAApp::UserCreateOutputObjects() {
       if (fUseXmlWeightsFile || fUseXmlFileFromCVMFS) fReader->AddSpectator(variable.Data(), &fVarsTMVASpectators[i]);
     }
     delete tokensSpectators;
-    if (fUseWeightsLibrary) {
+    if (fUseWeightsLibrary && !fFlatForestFile.IsNull()) {
+      AliHFTMVAFlatForest *forest = new AliHFTMVAFlatForest();
+      TString forestFile = fFlatForestFile;
+      if (forestFile.BeginsWith("alien://")) {
+        TFile::Cp(fFlatForestFile.Data(), gSystem->BaseName(fFlatForestFile.Data()));
+        forestFile = gSystem->BaseName(fFlatForestFile.Data());
+      }
+      Bool_t loaded = kFALSE;
+      if (forestFile.EndsWith(".xml")) loaded = forest->LoadXML(forestFile.Data());
+      else if (forestFile.EndsWith(".cxx")) loaded = forest->LoadClassFile(forestFile.Data());
+      else loaded = forest->LoadBinary(forestFile.Data());
+      if (!loaded || !forest->CheckInputVariables(inputNamesVec)) {
+        AliFatal(Form("Cannot use the BDT in %s", fFlatForestFile.Data()));
+      }
+      fBDTReader = forest;
+    }
+    else if (fUseWeightsLibrary) {
       void* lib = dlopen(fTMVAlibName.Data(), RTLD_NOW);
       void* p = dlsym(lib, Form("%s", fTMVAlibPtBin.Data()));
       IClassifierReader* (*maker1)(std::vector<std::string>&) = (IClassifierReader* (*)(std::vector<std::string>&)) p;
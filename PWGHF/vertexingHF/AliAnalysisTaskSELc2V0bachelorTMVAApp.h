@@ -179,6 +179,10 @@ class AliAnalysisTaskSELc2V0bachelorTMVAApp : public AliAnalysisTaskSE
   void SetUseWeightsLibrary(Bool_t flag) {fUseWeightsLibrary = flag;}
   Bool_t GetUseWeightsLibrary() const {return fUseWeightsLibrary;}
 
+  /// BDT evaluated at runtime by AliHFTMVAFlatForest from a TMVA xml, a generated class file or the compact binary
+  void SetFlatForestFile(TString fileName) {fFlatForestFile = fileName;}
+  TString GetFlatForestFile() const {return fFlatForestFile;}
+
   void SetXmlWeightsFile(TString fileName) {fXmlWeightsFile = fileName;}
   TString GetXmlWeightsFile() const {return fXmlWeightsFile;}
 
@@ -564,6 +568,7 @@ class AliAnalysisTaskSELc2V0bachelorTMVAApp : public AliAnalysisTaskSE
   IClassifierReader *fBDTReader;       //!<! BDT reader using BDT class
   TString fTMVAlibName;                /// Name of the library to load to have the TMVA weights
   TString fTMVAlibPtBin;               /// Pt bin that will be in the library to be loaded for the TMVA
+  TString fFlatForestFile;             /// file with the BDT for AliHFTMVAFlatForest (used instead of the library if set)
   TString fNamesTMVAVar;               /// vector of the names of the input variables
   TH2D *fBDTHisto;                     //!<!
   TH2D *fBDTHistoVsMassK0S;            //!<! BDT classifier vs mass (pi+pi-) pairs
@@ -624,7 +629,7 @@ class AliAnalysisTaskSELc2V0bachelorTMVAApp : public AliAnalysisTaskSE
   TH2F* fHistoVzVsNtrCorr;           //!<! hist. Vz vs corrected tracklets
   
   /// \cond CLASSIMP    
-  ClassDef(AliAnalysisTaskSELc2V0bachelorTMVAApp, 12); /// class for Lc->p K0
+  ClassDef(AliAnalysisTaskSELc2V0bachelorTMVAApp, 13); /// class for Lc->p K0
   /// \endcond    
 };
 
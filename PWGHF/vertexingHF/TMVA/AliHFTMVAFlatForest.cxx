@@ -0,0 +1,495 @@
+/**************************************************************************
+ * Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/////////////////////////////////////////////////////////////
+//
+// Runtime flattened-forest evaluator for TMVA BDTs
+//
+// The nodes of all the trees are stored in flat arrays (cut variable,
+// cut value, cut direction, children, leaf value), so that the
+// evaluation is a loop over integer indices instead of chasing BDTNode
+// pointers. GetMvaValues evaluates a block of candidates tree by tree,
+// which keeps each tree in cache for the whole block.
+//
+// The response is accumulated in the same order and with the same
+// operations as in the GetMvaValue__ of the generated classes, hence
+// a forest read from a class file gives bit-identical scores.
+//
+/////////////////////////////////////////////////////////////
+
+#include "AliHFTMVAFlatForest.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+  const char kBinaryMagic[8] = {'A', 'H', 'F', 'T', 'M', 'V', 'A', '1'};
+
+  bool ReadFile(const std::string &path, std::string &content) {
+    std::ifstream in(path.data(), std::ios::in | std::ios::binary);
+    if (!in.good()) {
+      std::cout << "AliHFTMVAFlatForest: cannot open " << path << std::endl;
+      return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    content = buffer.str();
+    return true;
+  }
+
+  bool EndsWith(const std::string &str, const std::string &suffix) {
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  /// value of attribute name in the xml tag, empty if not found
+  std::string GetAttribute(const std::string &tag, const char *name) {
+    std::string key = std::string(" ") + name + "=\"";
+    size_t start = tag.find(key);
+    if (start == std::string::npos) return "";
+    start += key.size();
+    size_t end = tag.find('"', start);
+    if (end == std::string::npos) return "";
+    return tag.substr(start, end - start);
+  }
+
+  /// text of the <Option name="..."> element
+  std::string GetOption(const std::string &xml, const char *name) {
+    std::string key = std::string("<Option name=\"") + name + "\"";
+    size_t start = xml.find(key);
+    if (start == std::string::npos) return "";
+    start = xml.find('>', start);
+    if (start == std::string::npos) return "";
+    size_t end = xml.find('<', start);
+    if (end == std::string::npos) return "";
+    return xml.substr(start + 1, end - start - 1);
+  }
+
+  void SkipBlanks(const std::string &code, size_t &pos) {
+    while (pos < code.size() && (isspace(code[pos]) || code[pos] == ',')) ++pos;
+  }
+
+  template <typename T> void WriteVector(std::ofstream &out, const std::vector<T> &vec) {
+    unsigned int size = vec.size();
+    out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    if (size) out.write(reinterpret_cast<const char *>(vec.data()), size * sizeof(T));
+  }
+
+  template <typename T> bool ReadVector(std::ifstream &in, std::vector<T> &vec) {
+    unsigned int size = 0;
+    if (!in.read(reinterpret_cast<char *>(&size), sizeof(size))) return false;
+    vec.resize(size);
+    if (size && !in.read(reinterpret_cast<char *>(vec.data()), size * sizeof(T))) return false;
+    return true;
+  }
+}
+
+//________________________________________________________________
+AliHFTMVAFlatForest::AliHFTMVAFlatForest() :
+  IClassifierReader(),
+  fResponseType(kYesNoLeaf),
+  fInputVars(),
+  fSelector(),
+  fCut(),
+  fCutType(),
+  fChild(),
+  fLeafValue(),
+  fRoots(),
+  fBoostWeights(),
+  fNorm(0.)
+{
+  //
+  // Default constructor, the forest is empty until one of the Load methods is called
+  //
+  fStatusIsClean = false;
+}
+
+//________________________________________________________________
+void AliHFTMVAFlatForest::Reset()
+{
+  fInputVars.clear();
+  fSelector.clear();
+  fCut.clear();
+  fCutType.clear();
+  fChild.clear();
+  fLeafValue.clear();
+  fRoots.clear();
+  fBoostWeights.clear();
+  fNorm = 0.;
+  fResponseType = kYesNoLeaf;
+  fStatusIsClean = false;
+}
+
+//________________________________________________________________
+int AliHFTMVAFlatForest::AddNode(int selector, double cut, bool cutType, int nodeType, double purity, double response)
+{
+  int node = fSelector.size();
+  // leaves of the generated classes have node type -1/1 and selector -1, internal nodes have node type 0
+  fSelector.push_back(nodeType == 0 ? selector : -1);
+  fCut.push_back(cut);
+  fCutType.push_back(cutType ? 1 : 0);
+  fChild.push_back(node);
+  fChild.push_back(node);
+  switch (fResponseType) {
+    case kPurityLeaf:
+      fLeafValue.push_back(purity);
+      break;
+    case kGradient:
+      fLeafValue.push_back(response);
+      break;
+    default:
+      fLeafValue.push_back(nodeType);
+      break;
+  }
+  return node;
+}
+
+//________________________________________________________________
+bool AliHFTMVAFlatForest::Finalise()
+{
+  if (fRoots.empty() || fRoots.size() != fBoostWeights.size()) {
+    std::cout << "AliHFTMVAFlatForest: inconsistent forest (" << fRoots.size() << " trees, "
+              << fBoostWeights.size() << " boost weights)" << std::endl;
+    Reset();
+    return false;
+  }
+  const int nNodes = fSelector.size();
+  if (fChild.size() != 2 * fSelector.size()) {
+    std::cout << "AliHFTMVAFlatForest: inconsistent node arrays" << std::endl;
+    Reset();
+    return false;
+  }
+  for (size_t iTree = 0; iTree < fRoots.size(); ++iTree) {
+    if (fRoots[iTree] < 0 || fRoots[iTree] >= nNodes) {
+      std::cout << "AliHFTMVAFlatForest: root of tree " << iTree << " out of range" << std::endl;
+      Reset();
+      return false;
+    }
+  }
+  for (int iNode = 0; iNode < nNodes; ++iNode) {
+    if (fSelector[iNode] >= (int)fInputVars.size() ||
+        fChild[2 * iNode] < 0 || fChild[2 * iNode] >= nNodes || fChild[2 * iNode + 1] < 0 || fChild[2 * iNode + 1] >= nNodes ||
+        (fSelector[iNode] >= 0 && (fChild[2 * iNode] == iNode || fChild[2 * iNode + 1] == iNode))) {
+      std::cout << "AliHFTMVAFlatForest: malformed node " << iNode << std::endl;
+      Reset();
+      return false;
+    }
+  }
+  // every tree must be acyclic: a tree cannot have more internal nodes than the forest
+  std::vector<int> stack;
+  for (size_t iTree = 0; iTree < fRoots.size(); ++iTree) {
+    int nVisited = 0;
+    stack.assign(1, fRoots[iTree]);
+    while (!stack.empty()) {
+      int node = stack.back();
+      stack.pop_back();
+      if (fSelector[node] < 0) continue;
+      if (++nVisited > nNodes) {
+        std::cout << "AliHFTMVAFlatForest: cycle in tree " << iTree << std::endl;
+        Reset();
+        return false;
+      }
+      stack.push_back(fChild[2 * node]);
+      stack.push_back(fChild[2 * node + 1]);
+    }
+  }
+  // same summation order as the generated classes
+  fNorm = 0.;
+  for (size_t iTree = 0; iTree < fBoostWeights.size(); ++iTree) fNorm += fBoostWeights[iTree];
+  fStatusIsClean = true;
+  return true;
+}
+
+//________________________________________________________________
+bool AliHFTMVAFlatForest::LoadXML(const std::string &path)
+{
+  Reset();
+  std::string xml;
+  if (!ReadFile(path, xml)) return false;
+
+  std::string boostType = GetOption(xml, "BoostType");
+  if (boostType == "Grad") fResponseType = kGradient;
+  else if (GetOption(xml, "UseYesNoLeaf") == "False") fResponseType = kPurityLeaf;
+
+  std::vector<int> stack;
+  size_t pos = 0;
+  while ((pos = xml.find('<', pos)) != std::string::npos) {
+    size_t end = xml.find('>', pos);
+    if (end == std::string::npos) break;
+    std::string tag = xml.substr(pos, end - pos + 1);
+    pos = end + 1;
+
+    if (tag.compare(0, 10, "<Variable ") == 0) {
+      fInputVars.push_back(GetAttribute(tag, "Expression"));
+    } else if (tag.compare(0, 12, "<BinaryTree ") == 0) {
+      fBoostWeights.push_back(std::atof(GetAttribute(tag, "boostWeight").data()));
+      stack.clear();
+    } else if (tag.compare(0, 6, "<Node ") == 0) {
+      int node = AddNode(std::atoi(GetAttribute(tag, "IVar").data()), std::atof(GetAttribute(tag, "Cut").data()),
+                         std::atoi(GetAttribute(tag, "cType").data()) != 0, std::atoi(GetAttribute(tag, "nType").data()),
+                         std::atof(GetAttribute(tag, "purity").data()), std::atof(GetAttribute(tag, "res").data()));
+      if (stack.empty()) {
+        fRoots.push_back(node);
+      } else {
+        fChild[2 * stack.back() + (GetAttribute(tag, "pos") == "r" ? 1 : 0)] = node;
+      }
+      if (tag[tag.size() - 2] != '/') stack.push_back(node);
+    } else if (tag.compare(0, 7, "</Node>") == 0) {
+      if (!stack.empty()) stack.pop_back();
+    }
+  }
+
+  return Finalise();
+}
+
+//________________________________________________________________
+bool AliHFTMVAFlatForest::ParseClassNode(const std::string &code, size_t &pos, int &node)
+{
+  // node = NN(left, right, selector, cutValue, cutType, nodeType, purity, response), or 0 for no daughter
+  SkipBlanks(code, pos);
+  if (code.compare(pos, 3, "NN(") != 0) {
+    if (pos < code.size() && code[pos] == '0') {
+      ++pos;
+      node = -1;
+      return true;
+    }
+    return false;
+  }
+  pos += 3;
+
+  int left = -1, right = -1;
+  if (!ParseClassNode(code, pos, left) || !ParseClassNode(code, pos, right)) return false;
+
+  double values[6];
+  for (int iVal = 0; iVal < 6; ++iVal) {
+    SkipBlanks(code, pos);
+    char *end = 0;
+    values[iVal] = std::strtod(code.data() + pos, &end);
+    if (end == code.data() + pos) return false;
+    pos = end - code.data();
+  }
+  SkipBlanks(code, pos);
+  if (pos >= code.size() || code[pos] != ')') return false;
+  ++pos;
+
+  node = AddNode((int)values[0], values[1], values[2] != 0, (int)values[3], values[4], values[5]);
+  if (left >= 0) fChild[2 * node] = left;
+  if (right >= 0) fChild[2 * node + 1] = right;
+  return true;
+}
+
+//________________________________________________________________
+bool AliHFTMVAFlatForest::LoadClassFile(const std::string &path)
+{
+  Reset();
+  std::string code;
+  if (!ReadFile(path, code)) return false;
+
+  size_t body = code.find("::GetMvaValue__");
+  size_t init = code.find("::Initialize()");
+  if (body == std::string::npos || init == std::string::npos) {
+    std::cout << "AliHFTMVAFlatForest: " << path << " is not a TMVA BDT class file" << std::endl;
+    return false;
+  }
+  std::string mva = code.substr(body, init > body ? init - body : std::string::npos);
+  if (mva.find("GetResponse()") != std::string::npos) fResponseType = kGradient;
+  else if (mva.find("GetPurity()") != std::string::npos) fResponseType = kPurityLeaf;
+
+  // input variables, from the header next to the class file if not in the file itself
+  std::string header = code;
+  if (header.find("inputVars[]") == std::string::npos && EndsWith(path, ".cxx")) {
+    ReadFile(path.substr(0, path.size() - 4) + ".h", header);
+  }
+  size_t vars = header.find("inputVars[]");
+  if (vars != std::string::npos) {
+    size_t begin = header.find('{', vars);
+    size_t end = header.find('}', begin);
+    for (size_t quote = header.find('"', begin); quote < end; quote = header.find('"', quote)) {
+      size_t close = header.find('"', quote + 1);
+      fInputVars.push_back(header.substr(quote + 1, close - quote - 1));
+      quote = close + 1;
+    }
+  }
+
+  const std::string weightKey = "fBoostWeights.push_back(";
+  const std::string treeKey = "fForest.push_back(";
+  size_t pos = init;
+  while (true) {
+    size_t weight = code.find(weightKey, pos);
+    size_t tree = code.find(treeKey, pos);
+    if (weight == std::string::npos && tree == std::string::npos) break;
+    if (weight < tree) {
+      fBoostWeights.push_back(std::strtod(code.data() + weight + weightKey.size(), 0));
+      pos = weight + weightKey.size();
+    } else {
+      pos = tree + treeKey.size();
+      int root = -1;
+      if (!ParseClassNode(code, pos, root) || root < 0) {
+        std::cout << "AliHFTMVAFlatForest: cannot parse tree " << fRoots.size() << " in " << path << std::endl;
+        Reset();
+        return false;
+      }
+      fRoots.push_back(root);
+    }
+  }
+
+  return Finalise();
+}
+
+//________________________________________________________________
+bool AliHFTMVAFlatForest::WriteBinary(const std::string &path) const
+{
+  std::ofstream out(path.data(), std::ios::out | std::ios::binary);
+  if (!out.good()) return false;
+  out.write(kBinaryMagic, sizeof(kBinaryMagic));
+  int type = fResponseType;
+  out.write(reinterpret_cast<const char *>(&type), sizeof(type));
+  unsigned int nVars = fInputVars.size();
+  out.write(reinterpret_cast<const char *>(&nVars), sizeof(nVars));
+  for (size_t iVar = 0; iVar < fInputVars.size(); ++iVar) {
+    std::vector<char> name(fInputVars[iVar].begin(), fInputVars[iVar].end());
+    WriteVector(out, name);
+  }
+  WriteVector(out, fSelector);
+  WriteVector(out, fCut);
+  WriteVector(out, fCutType);
+  WriteVector(out, fChild);
+  WriteVector(out, fLeafValue);
+  WriteVector(out, fRoots);
+  WriteVector(out, fBoostWeights);
+  return out.good();
+}
+
+//________________________________________________________________
+bool AliHFTMVAFlatForest::LoadBinary(const std::string &path)
+{
+  Reset();
+  std::ifstream in(path.data(), std::ios::in | std::ios::binary);
+  char magic[sizeof(kBinaryMagic)];
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kBinaryMagic, sizeof(magic)) != 0) {
+    std::cout << "AliHFTMVAFlatForest: " << path << " is not a flat forest binary file" << std::endl;
+    return false;
+  }
+  int type = 0;
+  unsigned int nVars = 0;
+  in.read(reinterpret_cast<char *>(&type), sizeof(type));
+  in.read(reinterpret_cast<char *>(&nVars), sizeof(nVars));
+  fResponseType = (EResponse)type;
+  bool ok = in.good();
+  for (unsigned int iVar = 0; ok && iVar < nVars; ++iVar) {
+    std::vector<char> name;
+    ok = ReadVector(in, name);
+    fInputVars.push_back(std::string(name.begin(), name.end()));
+  }
+  ok = ok && ReadVector(in, fSelector) && ReadVector(in, fCut) && ReadVector(in, fCutType) &&
+       ReadVector(in, fChild) && ReadVector(in, fLeafValue) && ReadVector(in, fRoots) && ReadVector(in, fBoostWeights);
+  if (!ok || fChild.size() != 2 * fSelector.size() || fCut.size() != fSelector.size() ||
+      fCutType.size() != fSelector.size() || fLeafValue.size() != fSelector.size()) {
+    std::cout << "AliHFTMVAFlatForest: corrupted binary file " << path << std::endl;
+    Reset();
+    return false;
+  }
+  return Finalise();
+}
+
+//________________________________________________________________
+bool AliHFTMVAFlatForest::ConvertToBinary(const std::string &in, const std::string &out)
+{
+  AliHFTMVAFlatForest forest;
+  bool loaded = false;
+  if (EndsWith(in, ".xml")) loaded = forest.LoadXML(in);
+  else if (EndsWith(in, ".cxx") || EndsWith(in, ".C")) loaded = forest.LoadClassFile(in);
+  else loaded = forest.LoadBinary(in);
+  return loaded && forest.WriteBinary(out);
+}
+
+//________________________________________________________________
+bool AliHFTMVAFlatForest::CheckInputVariables(const std::vector<std::string> &inputVars)
+{
+  if (inputVars.size() != fInputVars.size()) {
+    std::cout << "Problem in class \"AliHFTMVAFlatForest\": mismatch in number of input values: "
+              << inputVars.size() << " != " << fInputVars.size() << std::endl;
+    fStatusIsClean = false;
+    return false;
+  }
+  for (size_t iVar = 0; iVar < inputVars.size(); ++iVar) {
+    if (inputVars[iVar] != fInputVars[iVar]) {
+      std::cout << "Problem in class \"AliHFTMVAFlatForest\": mismatch in input variable names" << std::endl
+                << " for variable [" << iVar << "]: " << inputVars[iVar] << " != " << fInputVars[iVar] << std::endl;
+      fStatusIsClean = false;
+      return false;
+    }
+  }
+  return true;
+}
+
+//________________________________________________________________
+double AliHFTMVAFlatForest::Transform(double sum) const
+{
+  if (fResponseType == kGradient) return 2.0 / (1.0 + std::exp(-2.0 * sum)) - 1.0;
+  return sum /= fNorm;
+}
+
+//________________________________________________________________
+double AliHFTMVAFlatForest::GetMvaValue(const std::vector<double> &inputValues) const
+{
+  if (!IsStatusClean()) {
+    std::cout << "Problem in class \"AliHFTMVAFlatForest\": cannot return classifier response"
+              << " because status is dirty" << std::endl;
+    return 0.;
+  }
+  double value = 0.;
+  GetMvaValues(inputValues.data(), 1, &value);
+  return value;
+}
+
+//________________________________________________________________
+void AliHFTMVAFlatForest::GetMvaValues(const double *inputValues, int nRows, double *outValues) const
+{
+  const size_t nVars = fInputVars.size();
+  const int *selector = fSelector.data();
+  const double *cut = fCut.data();
+  const char *cutType = fCutType.data();
+  const int *child = fChild.data();
+  const double *leaf = fLeafValue.data();
+  const bool weighted = fResponseType != kGradient;
+  const int nNodes = fSelector.size();
+
+  for (int iRow = 0; iRow < nRows; ++iRow) outValues[iRow] = 0.;
+
+  // tree-major loop: the nodes of one tree stay in cache while all the candidates descend it
+  for (size_t iTree = 0; iTree < fRoots.size(); ++iTree) {
+    const int root = fRoots[iTree];
+    const double weight = fBoostWeights[iTree];
+    const double *row = inputValues;
+    for (int iRow = 0; iRow < nRows; ++iRow, row += nVars) {
+      // the step limit only guards against a corrupted forest, Finalise rejects cycles
+      int node = root;
+      for (int step = 0; step < nNodes && selector[node] >= 0; ++step) {
+        // branchless child selection: right if (x > cut) agrees with the cut type
+        int goesRight = (row[selector[node]] > cut[node]) == (cutType[node] != 0);
+        node = child[2 * node + goesRight];
+      }
+      if (weighted) outValues[iRow] += weight * leaf[node];
+      else outValues[iRow] += leaf[node];
+    }
+  }
+
+  for (int iRow = 0; iRow < nRows; ++iRow) outValues[iRow] = Transform(outValues[iRow]);
+}
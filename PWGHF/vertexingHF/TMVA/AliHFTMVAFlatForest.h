@@ -0,0 +1,85 @@
+#ifndef ALIHFTMVAFLATFOREST_H
+#define ALIHFTMVAFLATFOREST_H
+
+/* Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//*************************************************************************
+// \class AliHFTMVAFlatForest
+// \brief Runtime evaluator of TMVA BDTs, alternative to the generated
+//        *_TMVAClassification_BDT_*.class.cxx readers.
+//        The forest is loaded at runtime from the TMVA weights xml, from
+//        a generated class file or from a compact binary converted from
+//        them, and stored in a flat structure-of-arrays node layout.
+//        Models loaded from a class file give bit-identical scores to the
+//        compiled class (the xml carries more digits than the class file).
+/////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include "IClassifierReader.h"
+
+class AliHFTMVAFlatForest : public IClassifierReader
+{
+ public:
+
+  enum EResponse {
+    kYesNoLeaf,   // AdaBoost with UseYesNoLeaf: sum of boost weight * leaf type, normalised
+    kPurityLeaf,  // AdaBoost without UseYesNoLeaf: sum of boost weight * leaf purity, normalised
+    kGradient     // Grad: sum of leaf responses mapped to [-1, 1]
+  };
+
+  AliHFTMVAFlatForest();
+  virtual ~AliHFTMVAFlatForest() {}
+
+  /// load the forest from a TMVA weights xml file
+  bool LoadXML(const std::string &path);
+  /// load the forest from a class file generated by MethodBase::MakeClass
+  bool LoadClassFile(const std::string &path);
+  /// load / write the compact binary format
+  bool LoadBinary(const std::string &path);
+  bool WriteBinary(const std::string &path) const;
+  /// convert xml, class file or binary (chosen from the extension) to the compact binary format
+  static bool ConvertToBinary(const std::string &in, const std::string &out);
+
+  /// check the input variable names as done by the generated classes, flags the status as dirty if they differ
+  bool CheckInputVariables(const std::vector<std::string> &inputVars);
+
+  /// classifier response, same interface as the generated classes
+  virtual double GetMvaValue(const std::vector<double> &inputValues) const;
+  /// batch evaluation of nRows candidates stored row-major (nRows x GetNvar()) in inputValues
+  void GetMvaValues(const double *inputValues, int nRows, double *outValues) const;
+
+  size_t GetNvar() const { return fInputVars.size(); }
+  size_t GetNTrees() const { return fRoots.size(); }
+  size_t GetNNodes() const { return fSelector.size(); }
+  const std::vector<std::string> &GetInputVariables() const { return fInputVars; }
+
+ private:
+
+  void Reset();
+  bool Finalise();
+  /// index of the node with the given properties, children are filled later
+  int AddNode(int selector, double cut, bool cutType, int nodeType, double purity, double response);
+  bool ParseClassNode(const std::string &code, size_t &pos, int &node);
+  double LeafValue(int node) const;
+  double Transform(double sum) const;
+
+  EResponse fResponseType;               // how leaves are combined into the response
+  std::vector<std::string> fInputVars;   // names of the input variables, in order
+
+  // per-node arrays, children of node i are fChild[2i] (left) and fChild[2i+1] (right)
+  std::vector<int> fSelector;            // input variable of the cut, -1 for leaves
+  std::vector<double> fCut;              // cut value
+  std::vector<char> fCutType;            // 1 if events above the cut go right
+  std::vector<int> fChild;               // left and right child indices
+  std::vector<double> fLeafValue;        // leaf contribution (node type, purity or response)
+
+  // per-tree arrays
+  std::vector<int> fRoots;               // root node of each tree
+  std::vector<double> fBoostWeights;     // boost weight of each tree
+  double fNorm;                          // sum of the boost weights, in tree order as the generated classes
+};
+
+#endif
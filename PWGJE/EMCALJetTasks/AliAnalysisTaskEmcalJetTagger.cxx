@@ -53,6 +53,7 @@ AliAnalysisTaskEmcalJetTagger::AliAnalysisTaskEmcalJetTagger() :
   fExtraMarginAccBase(0.1),
   fExtraMarginAccTag(0.1),
   fInit(kFALSE),
+  fMatcher(),
   fh3PtJet1VsDeltaEtaDeltaPhi(nullptr),
   fh2PtJet1VsDeltaR(nullptr),
   fh2PtJet2VsFraction(nullptr),
@@ -81,6 +82,7 @@ AliAnalysisTaskEmcalJetTagger::AliAnalysisTaskEmcalJetTagger(const char *name) :
   fExtraMarginAccBase(0.1),
   fExtraMarginAccTag(0.1),
   fInit(kFALSE),
+  fMatcher(),
   fh3PtJet1VsDeltaEtaDeltaPhi(nullptr),
   fh2PtJet1VsDeltaR(nullptr),
   fh2PtJet2VsFraction(nullptr),
@@ -348,108 +350,37 @@ void AliAnalysisTaskEmcalJetTagger::MatchJetsGeo(Int_t c1, Int_t c2,
   }
   fMatchingDone = kFALSE;
 
-  TArrayI faMatchIndex1;
-  faMatchIndex1.Set(nJets2+1);
-  faMatchIndex1.Reset(-1);
-
-  TArrayI faMatchIndex2;
-  faMatchIndex2.Set(nJets1+1);
-  faMatchIndex2.Reset(-1);
-
-  static TArrayS iFlag(nJets1*nJets2);
-  if(iFlag.GetSize()<(nJets1*nJets2)){
-    iFlag.Set(nJets1*nJets2+1);
-  }
-  iFlag.Reset(0);
-
-  //AliJetContainer *cont1 = GetJetContainer(c1);
-  //AliJetContainer *cont2 = GetJetContainer(c2);
-  //Printf("eta cont 1 %f - %f", cont1->GetJetEtaMin(), cont1->GetJetEtaMax());
-  //Printf("phi cont 1 %f - %f", cont1->GetJetPhiMin(), cont1->GetJetPhiMax());
-  //if(type==1)
-  //  cont2->SetJetEtaLimits(cont2->GetJetEtaMin()-0.1,cont2->GetJetEtaMax()+0.1);
-  //else if(type==2) {
-  //  cont2->SetJetEtaLimits(cont2->GetJetEtaMin()-0.1,cont2->GetJetEtaMax()+0.1);
-  //  cont2->SetJetPhiLimits(cont2->GetJetPhiMin()-0.1,cont2->GetJetPhiMax()+0.1);
-  //} 
-  //else if(type==3) {
-  //  cont1->SetJetEtaLimits(cont1->GetJetEtaMin()-0.1,cont1->GetJetEtaMax()+0.1);
-  //  cont1->SetJetPhiLimits(cont1->GetJetPhiMin()-0.1,cont1->GetJetPhiMax()+0.1);
-  //  cont2->SetJetEtaLimits(cont2->GetJetEtaMin()-0.1,cont2->GetJetEtaMax()+0.1);
-  //  cont2->SetJetPhiLimits(cont2->GetJetPhiMin()-0.1,cont2->GetJetPhiMax()+0.1);
-  //}
-
-  // find the closest distance to the full jet
+  // mutually closest jets within maxDist (kd-tree search, including the pairs across phi = 0);
+  // ties go to the jet with the lowest index, as in a loop over all the pairs
+  fMatcher.Clear();
+  fMatcher.SetCriterion(PWG::JETFW::AliEmcalJetMatcher::kBijectiveClosest);
+  fMatcher.SetMaxDistance(maxDist);
   for(int i = 0;i<nJets1;i++){
-
     AliEmcalJet *jet1 = static_cast<AliEmcalJet*>(GetAcceptJetFromArray(i, c1));
-    if(!jet1) continue;
-
-    Float_t dist = maxDist;
-    
-    for(int j = 0;j <nJets2; j++){
-      AliEmcalJet *jet2 = static_cast<AliEmcalJet*>(GetAcceptJetFromArray(j, c2));
-      if(!jet2) continue;
-
-      Double_t dR = jet1->DeltaR(jet2);
-      if(dR<dist && dR<maxDist){
-	faMatchIndex2[i]=j;
-	dist = dR;
-      }
-    }//j jet loop
-    if(faMatchIndex2[i]>=0) {
-      iFlag[i*nJets2+faMatchIndex2[i]]+=1;//j closest to i
-      if(iDebug>10) Printf("Full Distance (%d)--(%d) %3.3f flag[%d] = %d",i,faMatchIndex2[i],dist,i*nJets2+faMatchIndex2[i],iFlag[i*nJets2+faMatchIndex2[i]]);
-    }
-  }//i jet loop
-
-  // other way around
+    if(jet1) fMatcher.AddJet(0, jet1);
+  }
   for(int j = 0;j<nJets2;j++){
     AliEmcalJet *jet2 = static_cast<AliEmcalJet*>(GetAcceptJetFromArray(j, c2));
-    if(!jet2)
-      continue;
+    if(jet2) fMatcher.AddJet(1, jet2);
+  }
+  fMatcher.Match();
 
-    Float_t dist = maxDist;
-    for(int i = 0;i<nJets1;i++){
-      AliEmcalJet *jet1 = static_cast<AliEmcalJet*>(GetAcceptJetFromArray(i, c1));
-      if(!jet1)	continue;
+  for(const auto &match : fMatcher.GetMatches()) {
+    AliEmcalJet *jet1 = fMatcher.GetJet(0, match.fIndex1);
+    AliEmcalJet *jet2 = fMatcher.GetJet(1, match.fIndex2);
+    Double_t dR = match.fDistance;
+    if(iDebug>1) Printf("closest jets %d  %d  dR =  %f",match.fIndex2,match.fIndex1,dR);
 
-      Double_t dR = jet1->DeltaR(jet2);
-      if(dR<dist && dR<maxDist){
-	faMatchIndex1[j]=i;
-        dist = dR;
-      }   
-    }
-    if(faMatchIndex1[j]>=0) {
-      iFlag[faMatchIndex1[j]*nJets2+j]+=2;//i closest to j
-      if(iDebug>10) Printf("Other way Distance (%d)--(%d) %3.3f flag[%d] = %d",faMatchIndex1[j],j,dist,faMatchIndex1[j]*nJets2+j,iFlag[faMatchIndex1[j]*nJets2+j]);
+    if(fJetTaggingType==kTag) {
+      jet1->SetTaggedJet(jet2);
+      jet1->SetTagStatus(1);
+
+      jet2->SetTaggedJet(jet1);
+      jet2->SetTagStatus(1);
     }
-  }
-    
-  // check for "true" correlations
-  for(int i = 0;i<nJets1;i++){
-    AliEmcalJet *jet1 = static_cast<AliEmcalJet*>(GetJetFromArray(i, c1));
-    for(int j = 0;j<nJets2;j++){
-      AliEmcalJet *jet2 = static_cast<AliEmcalJet*>(GetJetFromArray(j, c2));
-      AliDebug(11,Form("%s: Flag[%d][%d] %d ",GetName(),i,j,iFlag[i*nJets2+j]));
-      
-      // we have a uniqe correlation
-      if(iFlag[i*nJets2+j]==3) {
-        Double_t dR = jet1->DeltaR(jet2);
-	if(iDebug>1) Printf("closest jets %d  %d  dR =  %f",j,i,dR);
-	
-	if(fJetTaggingType==kTag) {
-	  jet1->SetTaggedJet(jet2);
-	  jet1->SetTagStatus(1);
-	  
-	  jet2->SetTaggedJet(jet1);
-	  jet2->SetTagStatus(1);
-	}
-	else if(fJetTaggingType==kClosest) {
-	  jet1->SetClosestJet(jet2,dR);
-	  jet2->SetClosestJet(jet1,dR);
-	}
-      }
+    else if(fJetTaggingType==kClosest) {
+      jet1->SetClosestJet(jet2,dR);
+      jet2->SetClosestJet(jet1,dR);
     }
   }
   fMatchingDone = kTRUE;
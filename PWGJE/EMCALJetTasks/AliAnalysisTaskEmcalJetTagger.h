@@ -33,6 +33,7 @@ class TH3;
 class AliJetContainer;
 
 #include "AliAnalysisTaskEmcalJet.h"
+#include "AliEmcalJetMatcher.h"
 
 /**
  * @class AliAnalysisTaskEmcalJetTagger
@@ -282,6 +283,7 @@ class AliAnalysisTaskEmcalJetTagger : public AliAnalysisTaskEmcalJet {
   Double_t                            fExtraMarginAccBase;         ///< Extra margin to be added to the acceptance for the different acceptance types (base jet container)
   Double_t                            fExtraMarginAccTag;          ///< Extra margin to be added to the acceptance for the different acceptance types (tag jet container)
   Bool_t                              fInit;                       ///< true when the containers are initialized
+  PWG::JETFW::AliEmcalJetMatcher      fMatcher;                    //!<! geometrical matching of the base and tag jets
   TH3                                 **fh3PtJet1VsDeltaEtaDeltaPhi; //!<! pt jet 1 vs deta vs dphi
   TH2                                 **fh2PtJet1VsDeltaR;         //!<! pt jet 1 vs dR
   TH2                                 **fh2PtJet2VsFraction;       //!<! pt jet 1 vs shared fraction
@@ -13,6 +13,9 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
 #include <TFile.h>
 #include <TF1.h>
 #include <TH1F.h>
@@ -133,19 +136,17 @@ void AliAnalysisTaskJetUE::SortJets()
     else {
       itSortedJets->second.clear();
     }
+    std::vector<AliEmcalJet*> jets;
     for (auto jet1 : jetCont.second->accepted()) {
       if (!jet1->IsGhost()) {
         fNjets[jetCont.first]++;
         fTotJetArea[jetCont.first] += jet1->Area();
       }
-      std::list<AliEmcalJet*>::iterator itJet2 = itSortedJets->second.begin();
-      while (itJet2 != itSortedJets->second.end()) {
-        AliEmcalJet* jet2 = *itJet2;
-        if (jet1->Pt() > jet2->Pt()) break;
-        itJet2++;
-      }
-      itSortedJets->second.insert(itJet2, jet1);
+      jets.push_back(jet1);
     }
+    // jets with the same momentum keep their order in the container
+    std::stable_sort(jets.begin(), jets.end(), [](const AliEmcalJet* jet1, const AliEmcalJet* jet2) { return jet1->Pt() > jet2->Pt(); });
+    itSortedJets->second.assign(jets.begin(), jets.end());
     if (!itSortedJets->second.empty()) fLeadingJet[jetCont.first] = *(itSortedJets->second.begin());
   }
 }
@@ -5,6 +5,7 @@
 
 #include "AliAnalysisManager.h"
 #include "AliEmcalJet.h"
+#include "AliJetRhoEngine.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
 #include "AliJetContainer.h"
@@ -46,63 +47,24 @@ Bool_t AliAnalysisTaskRho::Run()
 
   const Int_t Njets   = fJets->GetEntries();
 
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-	continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
-
-  // push all jets within selected acceptance into stack
+  AliJetRhoEngine::Selection selection;
+  selection.fJets = fJets;
+  selection.fNExclLeadJets = fNExclLeadJets;
+  selection.fAccepted.resize(Njets, kFALSE);
   for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
     AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
     if (!jet) {
       AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
       continue;
     } 
-
-    if (!AcceptJet(jet))
-      continue;
-
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
-    ++NjetAcc;
+    selection.fAccepted[iJets] = AcceptJet(jet);
   }
 
+  // median of all accepted jets, excluding the leading jets (shared with the other rho tasks)
+  Int_t NjetAcc = 0;
+  Double_t rho = AliJetRhoEngine::Instance().GetRho(selection, AliJetRhoEngine::kAllJets, &NjetAcc);
 
   if (NjetAcc > 0) {
-    //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
     fOutRho->SetVal(rho);
 
     if (fOutRhoScaled) {
@@ -34,6 +34,7 @@
 #include <AliAnalysisManager.h>
 
 #include "AliEmcalJet.h"
+#include "AliJetRhoEngine.h"
 #include "AliRhoParameter.h"
 #include "AliJetContainer.h"
 
@@ -69,34 +70,10 @@ void AliAnalysisTaskRhoDev::UserCreateOutputObjects()
   fOutput->Add(fHistOccCorrvsCent);
 }
 
-std::pair<AliEmcalJet*, AliEmcalJet*> AliAnalysisTaskRhoDev::GetLeadingJets()
-{
-  std::pair<AliEmcalJet*, AliEmcalJet*> maxJets = {nullptr, nullptr};
-  if (fNExclLeadJets <= 0) return maxJets;
-
-  auto itJet = fSortedJets["Background"].begin();
-
-  maxJets.first = *itJet;
-  if (fNExclLeadJets > 1) {
-    itJet++;
-    if (itJet != fSortedJets["Background"].end()) maxJets.second = *itJet;
-  }
-
-  return maxJets;
-}
-
 void AliAnalysisTaskRhoDev::CalculateRho()
 {
   if (fJetCollArray.empty()) return;
 
-  auto maxJets = GetLeadingJets();
-
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
-  Double_t TotaljetArea = 0; // Total area of background jets (including ghost jets)
-  Double_t TotaljetAreaPhys = 0; // Total area of physical background jets (excluding ghost jets)
-  // Ghost jet is a jet made only of ghost particles
-
   AliJetContainer* bkgJetCont = fJetCollArray["Background"];
   AliJetContainer* sigJetCont = nullptr;
   if (!fExclJetOverlap.IsNull()) {
@@ -104,33 +81,25 @@ void AliAnalysisTaskRhoDev::CalculateRho()
     if (sigJetContIt != fJetCollArray.end()) sigJetCont = sigJetContIt->second;
   }
 
-  // push all jets within selected acceptance into stack
-  for (auto jet : bkgJetCont->accepted()) {
-
-    TotaljetArea += jet->Area();
-
-    if (jet->IsGhost()) continue;
-
-    TotaljetAreaPhys += jet->Area();
-
-    // excluding leading jets
-    if (jet == maxJets.first || jet == maxJets.second) continue;
-
-    Bool_t overlapsWithSignal = kFALSE;
-    if (sigJetCont) {
-      for (auto sigJet : sigJetCont->accepted()) {
-        if (AreJetsOverlapping(jet, sigJet)) {
-          overlapsWithSignal = kTRUE;
-          break;
-        }
-      }
-    }
+  AliJetRhoEngine::Selection selection;
+  selection.fJets = bkgJetCont->GetArray();
+  selection.fNExclLeadJets = fNExclLeadJets;
+  selection.fAccepted.resize(bkgJetCont->GetNEntries(), kFALSE);
+  UInt_t rejectionReason = 0;
+  for (Int_t i = 0; i < bkgJetCont->GetNEntries(); i++) selection.fAccepted[i] = bkgJetCont->AcceptJet(i, rejectionReason);
+  if (sigJetCont) {
+    for (auto sigJet : sigJetCont->accepted()) selection.fSignalJets.push_back(sigJet);
+  }
 
-    if (overlapsWithSignal) continue;
+  // Median of the accepted non-ghost jets, excluding the leading jets and the jets overlapping with signal jets.
+  // Ghost jet is a jet made only of ghost particles. The computation is shared with the other rho tasks.
+  AliJetRhoEngine &engine = AliJetRhoEngine::Instance();
+  Int_t NjetAcc = 0;
+  Double_t rho = engine.GetRho(selection, AliJetRhoEngine::kNonGhostJets, &NjetAcc);
 
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
-    ++NjetAcc;
-  }
+  Double_t TotaljetArea = 0; // Total area of background jets (including ghost jets)
+  Double_t TotaljetAreaPhys = 0; // Total area of physical background jets (excluding ghost jets)
+  engine.GetAreas(selection, AliJetRhoEngine::kAreaAcceptedJets, TotaljetAreaPhys, TotaljetArea);
 
   // Occupancy correction for sparse event described in https://arxiv.org/abs/1207.2392
   if (TotaljetArea > 0) {
@@ -141,9 +110,6 @@ void AliAnalysisTaskRhoDev::CalculateRho()
   }
 
   if (NjetAcc > 0) {
-    //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
-
     if (fRhoSparse) rho = rho * fOccupancyFactor;
 
     fOutRho->SetVal(rho);
@@ -27,8 +27,6 @@
 #ifndef ALIANALYSISTASKRHODEV_H
 #define ALIANALYSISTASKRHODEV_H
 
-#include <utility>
-
 #include "AliAnalysisTaskRhoBaseDev.h"
 
 /** 
@@ -127,13 +125,6 @@ public:
    */
   Bool_t        VerifyContainers();
 
-  /**
-   * Finds the first two leading jets
-   * @return A pair with the leading and sub-leading jets respectively as first and second element
-   */
-  std::pair<AliEmcalJet*, AliEmcalJet*>
-                GetLeadingJets();
-
   UInt_t           fNExclLeadJets;                 ///< number of leading jets to be excluded from the median calculation
   Bool_t           fRhoSparse;                     ///< flag to run CMS method as described in https://arxiv.org/abs/1207.2392
   TString          fExclJetOverlap;                ///< name of the jet collection that should be used to reject jets that are considered "signal"
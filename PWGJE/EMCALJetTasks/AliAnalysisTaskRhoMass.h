@@ -28,6 +28,7 @@
 #define ALIANALYSISTASKRHOMASS_H
 
 #include "AliAnalysisTaskRhoMassBase.h"
+#include "AliJetRhoEngine.h"
 
 /**
  * @class AliAnalysisTaskRhoMass
@@ -88,6 +89,12 @@ class AliAnalysisTaskRhoMass : public AliAnalysisTaskRhoMassBase {
    */
   Double_t         GetMd(AliEmcalJet *jet);
 
+  /**
+   * @brief Get the settings of the md calculation, for the shared rho engine
+   * @return md settings of this task
+   */
+  AliJetRhoEngine::MassSettings GetMassSettings() const;
+
   UInt_t           fNExclLeadJets;                 ///< number of leading jets to be excluded from the median calculation
   JetRhoMassType   fJetRhoMassType;                ///< method for rho_m calculation
   Bool_t           fPionMassClusters;              ///< assume pion mass for clusters
@@ -14,6 +14,7 @@
 #include "AliAnalysisManager.h"
 #include <AliVEventHandler.h>
 #include "AliEmcalJet.h"
+#include "AliJetRhoEngine.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
 #include "AliJetContainer.h"
@@ -91,121 +92,51 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
   Int_t NjetsSig = 0;
   if (sigjets) NjetsSig = sigjets->GetNJets();
 
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
-      if (!jet) {
-        AliError(Form("%s: Could not receive jet %d", GetName(), ij));
-        continue;
-      } 
-
-      if (!AcceptJet(jet))
-        continue;
-
-      //Search the two leading KT jets
-      if (jet->Pt() > maxJetPts[0]) {
-        maxJetPts[1] = maxJetPts[0];
-        maxJetIds[1] = maxJetIds[0];
-        maxJetPts[0] = jet->Pt();
-        maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-        maxJetPts[1] = jet->Pt();
-        maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
-  Double_t TotaljetAreaPhys=0;
-  Double_t TotalAreaCovered=0;
-  Double_t TotalTPCArea=2*TMath::Pi()*0.9;
-
-  // push all jets within selected acceptance into stack
+  AliJetRhoEngine::Selection selection;
+  selection.fJets = fJets;
+  selection.fNExclLeadJets = fNExclLeadJets;
+  selection.fAccepted.resize(Njets, kFALSE);
   for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
     AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
     if (!jet) {
       AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
       continue;
     } 
-
-    // Take into account the area of real jets (no pure ghost jets)
-    // and also the area of later excluded jets.
-    // Some of these jets do not contribute to the rho calculation
-    // but to the factor with which this rho is scaled down
-    if (fExcludeAreaExcludedJets==0)
-    {
-      // Total area of physical jets that are used for the rho calculation
-      if(jet->GetNumberOfTracks()>0)
-      {
-       TotaljetAreaPhys+=jet->Area();
-      }
-      // Total area of all found jets ghost+phyical jets. This is a proxy
-      // for the available detector area in which the rho could have been calculated
-      TotalAreaCovered+=jet->Area();
-    }
-    // Exclude leading background jets (could be signal)
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
     // Exclude background jets that do not fullfill basic cuts defined in AliJetContainer
-    if (!AcceptJet(jet))
-      continue;
-
-    // Search for overlap with signal jets
-    Bool_t isOverlapping = kFALSE;
-    if (sigjets) {
-      for(Int_t j=0;j<NjetsSig;j++)
-      {
-        AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
-        if(!signalJet)
-          continue;
-        if(!IsJetSignal(signalJet))
-          continue;
-
-        if(IsJetOverlapping(signalJet, jet))
-        {
-          isOverlapping = kTRUE;
-          break;
-        }
-      }
-    }
-    // Exclude background jets that overlap with anti-kT signal jets
-    if(fExcludeOverlaps && isOverlapping)
-      continue;
-
-    // Take into account only real jets (no pure ghost jets) that also
-    // contribute to the rho calculation
-    if (fExcludeAreaExcludedJets==1)
-    {
-      // Total area of physical jets that are used for the rho calculation
-      if(jet->GetNumberOfTracks()>0)
-      {
-       TotaljetAreaPhys+=jet->Area();
-      }
-      // Total area of all found jets ghost+phyical jets. This is a proxy
-      // for the available detector area in which the rho could have been calculated
-      TotalAreaCovered+=jet->Area();
-    }
+    selection.fAccepted[iJets] = AcceptJet(jet);
+  }
 
-    // Exclude pure ghost jets from the rho calculation.
-    // Use only jets that fulfill your background jet selection
-    // for the rho calculation.
-    // Eg. real signal jets should not bias the background rho
-    if(jet->GetNumberOfTracks()>0)
+  // Exclude background jets that overlap with anti-kT signal jets
+  if (sigjets && fExcludeOverlaps) {
+    for(Int_t j=0;j<NjetsSig;j++)
     {
-      rhovec[NjetAcc] = jet->Pt() / jet->Area();
-      ++NjetAcc;
+      AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
+      if(!signalJet)
+        continue;
+      if(!IsJetSignal(signalJet))
+        continue;
+      selection.fSignalJets.push_back(signalJet);
     }
   }
 
+  // The leading background jets (could be signal) are excluded as well.
+  // Only real jets (no pure ghost jets) of the background jet selection
+  // are used for the rho calculation: eg. real signal jets should not bias the background rho.
+  // The computation is shared with the other rho tasks running on the same jets.
+  AliJetRhoEngine &engine = AliJetRhoEngine::Instance();
+  Int_t NjetAcc = 0;
+  Double_t rho = engine.GetRho(selection, AliJetRhoEngine::kJetsWithTracks, &NjetAcc);
+
+  // Area of real jets (no pure ghost jets) and area of all found jets ghost+physical jets.
+  // The latter is a proxy for the available detector area in which the rho could have been calculated.
+  // With fExcludeAreaExcludedJets==0 the area of later excluded jets is also taken into account:
+  // some of these jets do not contribute to the rho calculation but to the factor with which this rho is scaled down
+  Double_t TotaljetAreaPhys=0;
+  Double_t TotalAreaCovered=0;
+  Double_t TotalTPCArea=2*TMath::Pi()*0.9;
+  engine.GetAreas(selection, fExcludeAreaExcludedJets==1 ? AliJetRhoEngine::kAreaSelectedJets : AliJetRhoEngine::kAreaAllJets,
+                  TotaljetAreaPhys, TotalAreaCovered);
+
   Double_t OccCorr=1;
   //Use the total TPC area in which rho is calculated as denominater
   if(fUseTPCArea)
@@ -222,9 +153,6 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
 
   if (NjetAcc > 0) {
-    //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
-
     if(fRhoCMS){
       rho = rho * OccCorr;
     }
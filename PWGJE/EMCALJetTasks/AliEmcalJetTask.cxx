@@ -24,6 +24,8 @@
  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS      *
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
  **************************************************************************************/
+#include <atomic>
+#include <thread>
 #include <vector>
 
 #include <TClonesArray.h>
@@ -59,6 +61,7 @@ using std::cerr;
 
 /// \cond CLASSIMP
 ClassImp(AliEmcalJetTask);
+ClassImp(AliEmcalJetTask::AliEmcalJetDefinition);
 /// \endcond
 
 const Int_t AliEmcalJetTask::fgkConstIndexShift = 100000;
@@ -91,6 +94,12 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fRandom(0),
   fLocked(0),
   fFillConstituents(kTRUE),
+  fJetDefinitions(),
+  fNThreads(1),
+  fAreaMode(0),
+  fHybridAreaPtMin(5.),
+  fGhostSeed(12345),
+  fUseConstituentArena(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -101,7 +110,12 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fJets(0),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
   fClusterContainerIndexMap(),
-  fParticleContainerIndexMap()
+  fParticleContainerIndexMap(),
+  fDefinitionWrappers(),
+  fDefinitionJets(),
+  fInputCharges(),
+  fGhosts(),
+  fConstituentArena()
 {
 }
 
@@ -133,6 +147,12 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fRandom(0),
   fLocked(0),
   fFillConstituents(kTRUE),
+  fJetDefinitions(),
+  fNThreads(1),
+  fAreaMode(0),
+  fHybridAreaPtMin(5.),
+  fGhostSeed(12345),
+  fUseConstituentArena(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -143,7 +163,12 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fJets(0),
   fFastJetWrapper(name,name),
   fClusterContainerIndexMap(),
-  fParticleContainerIndexMap()
+  fParticleContainerIndexMap(),
+  fDefinitionWrappers(),
+  fDefinitionJets(),
+  fInputCharges(),
+  fGhosts(),
+  fConstituentArena()
 {
 }
 
@@ -152,6 +177,51 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  for (auto wrapper : fDefinitionWrappers) delete wrapper;
+}
+
+/**
+ * Default constructor. This constructor is only for ROOT I/O.
+ */
+AliEmcalJetTask::AliEmcalJetDefinition::AliEmcalJetDefinition() :
+  fJetType(AliJetContainer::kFullJet),
+  fJetAlgo(AliJetContainer::antikt_algorithm),
+  fRecombScheme(AliJetContainer::pt_scheme),
+  fRadius(0.4),
+  fJetsTag()
+{
+}
+
+/**
+ * Standard constructor.
+ * @param jetType full, charged or neutral
+ * @param jetAlgo jet finding algorithm (anti-kt, kt, etc.)
+ * @param recoScheme recombination scheme
+ * @param radius jet resolution parameter
+ * @param tag tag of the jet collection (empty: tag of the jet finder task)
+ */
+AliEmcalJetTask::AliEmcalJetDefinition::AliEmcalJetDefinition(EJetType_t jetType, EJetAlgo_t jetAlgo, ERecoScheme_t recoScheme, Double_t radius, const char *tag) :
+  fJetType(jetType),
+  fJetAlgo(jetAlgo),
+  fRecombScheme(recoScheme),
+  fRadius(radius),
+  fJetsTag(tag)
+{
+}
+
+/**
+ * Add a jet definition clustered on the constituents of this task. The jets are
+ * written to their own jet branch, named as for a jet finder task with these settings.
+ * @param jetType full, charged or neutral
+ * @param jetAlgo jet finding algorithm (anti-kt, kt, etc.)
+ * @param recoScheme recombination scheme
+ * @param radius jet resolution parameter
+ * @param tag tag of the jet collection (empty: tag of this task)
+ */
+void AliEmcalJetTask::AddJetDefinition(EJetType_t jetType, EJetAlgo_t jetAlgo, ERecoScheme_t recoScheme, Double_t radius, const char *tag)
+{
+  if (IsLocked()) return;
+  fJetDefinitions.push_back(AliEmcalJetDefinition(jetType, jetAlgo, recoScheme, radius, tag));
 }
 
 /**
@@ -235,6 +305,12 @@ Bool_t AliEmcalJetTask::Run()
   InitEvent();
   // clear the jet array (normally a null operation)
   fJets->Delete();
+  for (auto jets : fDefinitionJets) {
+    if (jets) jets->Delete();
+  }
+  // the jets of the previous event referring to the arena are deleted
+  fConstituentArena.Clear();
+  fConstituentArena.SetConstituentObjects(fFillConstituents);
   Int_t n = FindJets();
 
   if (n == 0) return kFALSE;
@@ -259,6 +335,7 @@ Int_t AliEmcalJetTask::FindJets()
   }
 
   fFastJetWrapper.Clear();
+  fInputCharges.clear();
 
   AliDebug(2,Form("Jet type = %d", fJetType));
 
@@ -302,6 +379,7 @@ Int_t AliEmcalJetTask::FindJets()
       AliDebug(2,Form("Track %d accepted (label = %d, pt = %f, eta = %f, phi = %f, E = %f, m = %f, px = %f, py = %f, pz = %f)", it.current_index(), it->second->GetLabel(), pvec.Pt(), pvec.Eta(), pvec.Phi(), pvec.E(), it->first.M(), pvec.Px(), pvec.Py(), pvec.Pz()));
       Int_t uid = it.current_index() + fgkConstIndexShift * iColl;
       fFastJetWrapper.AddInputVector(pvec.Px(), pvec.Py(), pvec.Pz(), pvec.E(), uid);
+      if (!fJetDefinitions.empty()) fInputCharges.push_back(it->second->Charge());
     }
     iColl++;
   }
@@ -316,18 +394,72 @@ Int_t AliEmcalJetTask::FindJets()
       AliDebug(2,Form("Cluster %d accepted (label = %d, energy = %.3f)", it.current_index(), it->second->GetLabel(), it->first.E()));
       Int_t uid = -it.current_index() - fgkConstIndexShift * iColl;
       fFastJetWrapper.AddInputVector(it->first.Px(), it->first.Py(), it->first.Pz(), it->first.E(), uid);
+      if (!fJetDefinitions.empty()) fInputCharges.push_back(0);
     }
     iColl++;
   }
 
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
 
+  if (!fJetDefinitions.empty()) return RunJetDefinitions();
+
   // run jet finder
   fFastJetWrapper.Run();
 
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * This method runs the jet finder for the main and the additional jet definitions on the
+ * input vectors collected by FindJets(). The ghosts are generated once and shared by all
+ * definitions (the main definition generates its own ghosts if utilities are attached, as they
+ * may need the full cluster sequence with area). Charged and neutral definitions get the
+ * corresponding subset of the input vectors. With more than one thread the definitions are
+ * clustered in parallel, which requires a FastJet library built with thread safety.
+ * @return Total number of jets found.
+ */
+Int_t AliEmcalJetTask::RunJetDefinitions()
+{
+  Double_t ghostArea = fFastJetWrapper.GenerateGhosts(fGhosts);
+  if (fUtilities && fUtilities->GetEntriesFast() > 0) fFastJetWrapper.SetSharedGhosts(0, 0);
+  else fFastJetWrapper.SetSharedGhosts(&fGhosts, ghostArea);
+
+  std::vector<AliFJWrapper*> wrappers(1, &fFastJetWrapper);
+  const std::vector<fastjet::PseudoJet>& inputs = fFastJetWrapper.GetInputVectors();
+  for (UInt_t idef = 0; idef < fJetDefinitions.size(); idef++) {
+    if (!fDefinitionJets[idef]) continue;
+    AliFJWrapper *wrapper = fDefinitionWrappers[idef];
+    wrapper->Clear();
+    wrapper->SetSharedGhosts(&fGhosts, ghostArea);
+    EJetType_t jetType = fJetDefinitions[idef].fJetType;
+    for (UInt_t i = 0; i < inputs.size(); i++) {
+      if (jetType == AliJetContainer::kChargedJet && fInputCharges[i] == 0) continue;
+      if (jetType == AliJetContainer::kNeutralJet && fInputCharges[i] != 0) continue;
+      wrapper->AddInputVector(inputs[i], inputs[i].user_index());
+    }
+    if (wrapper->GetInputVectors().size() > 0) wrappers.push_back(wrapper);
+  }
+
+  Int_t nThreads = TMath::Min<Int_t>(fNThreads, wrappers.size());
+  if (nThreads <= 1) {
+    for (auto wrapper : wrappers) wrapper->Run();
+  }
+  else {
+    // the threads take the next definition to cluster until all are done
+    std::atomic<UInt_t> next(0);
+    auto worker = [&wrappers, &next]() {
+      for (UInt_t i = next++; i < wrappers.size(); i = next++) wrappers[i]->Run();
+    };
+    std::vector<std::thread> threads;
+    for (Int_t i = 0; i < nThreads; i++) threads.push_back(std::thread(worker));
+    for (auto &thread : threads) thread.join();
+  }
+
+  Int_t n = 0;
+  for (auto wrapper : wrappers) n += wrapper->GetInclusiveJets().size();
+  return n;
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -335,10 +467,27 @@ Int_t AliEmcalJetTask::FindJets()
  */
 void AliEmcalJetTask::FillJetBranch()
 {
-  PrepareUtilities();
+  FillJetBranch(fFastJetWrapper, fJets, fRadius, kTRUE);
+
+  for (UInt_t idef = 0; idef < fDefinitionJets.size(); idef++) {
+    if (!fDefinitionJets[idef] || fDefinitionWrappers[idef]->GetInputVectors().size() == 0) continue;
+    FillJetBranch(*fDefinitionWrappers[idef], fDefinitionJets[idef], fJetDefinitions[idef].fRadius, kFALSE);
+  }
+}
+
+/**
+ * This method fills a jet output branch with the jets found by a FastJet wrapper.
+ * @param wrapper FastJet wrapper which ran the jet finding
+ * @param jets Output jet branch
+ * @param radius Jet radius, used for the fiducial acceptance
+ * @param withUtilities If true the utilities of the task are executed
+ */
+void AliEmcalJetTask::FillJetBranch(AliFJWrapper& wrapper, TClonesArray *jets, Double_t radius, Bool_t withUtilities)
+{
+  if (withUtilities) PrepareUtilities();
 
   // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  std::vector<fastjet::PseudoJet> jets_incl = wrapper.GetInclusiveJets();
   // sort jets according to jet pt
   static Int_t indexes[9999] = {-1};
   GetSortedArray(indexes, jets_incl);
@@ -346,27 +495,28 @@ void AliEmcalJetTask::FillJetBranch()
   AliDebug(1,Form("%d jets found", (Int_t)jets_incl.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
     Int_t ij = indexes[ijet];
-    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
+    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), wrapper.GetJetArea(ij)));
 
     if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
+    // in the hybrid area mode the soft jets only have the nominal area, the area cut is applied to the exact areas
+    if (wrapper.IsJetAreaExact(ij) && wrapper.GetJetArea(ij) < fMinJetArea) continue;
     if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
 
-    AliEmcalJet *jet = new ((*fJets)[jetCount])
+    AliEmcalJet *jet = new ((*jets)[jetCount])
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
     jet->SetLabel(ij);
 
-    fastjet::PseudoJet area(fFastJetWrapper.GetJetAreaVector(ij));
+    fastjet::PseudoJet area(wrapper.GetJetAreaVector(ij));
     jet->SetArea(area.perp());
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
     jet->SetAreaE(area.E());
-    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
+    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), radius));
 
     // Fill constituent info
-    std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
+    std::vector<fastjet::PseudoJet> constituents(wrapper.GetJetConstituents(ij));
     FillJetConstituents(jet, constituents, constituents);
 
     if (fGeom) {
@@ -377,13 +527,13 @@ void AliEmcalJetTask::FillJetBranch()
         jet->SetAxisInEmcal(kTRUE);
     }
 
-    ExecuteUtilities(jet, ij);
+    if (withUtilities) ExecuteUtilities(jet, ij);
 
     AliDebug(2,Form("Added jet n. %d, pt = %f, area = %f, constituents = %d", jetCount, jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
     jetCount++;
   }
 
-  TerminateUtilities();
+  if (withUtilities) TerminateUtilities();
 }
 
 /**
@@ -467,6 +617,19 @@ void AliEmcalJetTask::ExecOnce()
   fFastJetWrapper.SetAlgorithm(ConvertToFJAlgo(fJetAlgo));
   fFastJetWrapper.SetRecombScheme(ConvertToFJRecoScheme(fRecombScheme));
   fFastJetWrapper.SetMaxRap(1);
+  fFastJetWrapper.SetAreaMode(fAreaMode);
+  fFastJetWrapper.SetHybridAreaPtMin(fHybridAreaPtMin);
+  fFastJetWrapper.SetGhostSeed(fGhostSeed);
+  if (fAreaMode == AliFJWrapper::kHybridArea && fJetAlgo != AliJetContainer::antikt_algorithm) {
+    // the jets of the other algorithms are not contained in a cone around their axis
+    AliWarning(Form("%s: the hybrid area mode is only valid for anti-kt jets, the ghost grid area is used for the main jet definition", GetName()));
+    fFastJetWrapper.SetAreaMode(AliFJWrapper::kGhostGridArea);
+  }
+  if (fAreaMode != AliFJWrapper::kStandardArea && fUtilities && fUtilities->GetEntriesFast() > 0) {
+    // the utilities need the cluster sequence with area of FastJet
+    AliWarning(Form("%s: the ghost grid area modes are not available with jet utilities, the standard area is used for the main jet definition", GetName()));
+    fFastJetWrapper.SetAreaMode(AliFJWrapper::kStandardArea);
+  }
  
 
   // setting legacy mode
@@ -474,6 +637,42 @@ void AliEmcalJetTask::ExecOnce()
     fFastJetWrapper.SetLegacyMode(kTRUE);
   }
 
+  // setup the additional jet definitions, with the same settings as the main wrapper
+  for (UInt_t idef = 0; idef < fJetDefinitions.size(); idef++) {
+    const AliEmcalJetDefinition &def = fJetDefinitions[idef];
+    if (fJetType != AliJetContainer::kFullJet && def.fJetType != fJetType) {
+      AliWarning(Form("%s: jet definition %d is of type %d, but the constituents are selected for jet type %d", GetName(), idef, def.fJetType, fJetType));
+    }
+
+    TString jetsName = AliJetContainer::GenerateJetName(def.fJetType, def.fJetAlgo, def.fRecombScheme, def.fRadius, GetParticleContainer(0), GetClusterContainer(0),
+                                                        def.fJetsTag.IsNull() ? fJetsTag : def.fJetsTag);
+    TClonesArray *jets = 0;
+    if (!(InputEvent()->FindListObject(jetsName))) {
+      jets = new TClonesArray("AliEmcalJet");
+      jets->SetName(jetsName);
+      ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", jetsName.Data());
+      InputEvent()->AddObject(jets);
+    }
+    else {
+      AliError(Form("%s: Object with name %s already in event! Jet definition %d is not run", GetName(), jetsName.Data(), idef));
+    }
+
+    AliFJWrapper *wrapper = new AliFJWrapper(jetsName, jetsName);
+    wrapper->CopySettingsFrom(fFastJetWrapper);
+    wrapper->SetR(def.fRadius);
+    wrapper->SetAlgorithm(ConvertToFJAlgo(def.fJetAlgo));
+    wrapper->SetRecombScheme(ConvertToFJRecoScheme(def.fRecombScheme));
+    wrapper->SetAreaMode(fAreaMode);
+    if (fAreaMode == AliFJWrapper::kHybridArea && def.fJetAlgo != AliJetContainer::antikt_algorithm) {
+      AliWarning(Form("%s: the hybrid area mode is only valid for anti-kt jets, the ghost grid area is used for jet definition %d", GetName(), idef));
+      wrapper->SetAreaMode(AliFJWrapper::kGhostGridArea);
+    }
+    fDefinitionWrappers.push_back(wrapper);
+    fDefinitionJets.push_back(jets);
+  }
+  // print the FastJet banner before clustering in parallel threads
+  if (!fJetDefinitions.empty() && fNThreads > 1) fastjet::ClusterSequence::print_banner();
+
   InitUtilities();
 
   AliAnalysisTaskEmcal::ExecOnce();
@@ -512,8 +711,13 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
 
   Int_t uid   = -1;
 
-  jet->SetNumberOfTracks(constituents.size());
-  jet->SetNumberOfClusters(constituents.size());
+  if (fUseConstituentArena) {
+    fConstituentArena.StartJet();
+  }
+  else {
+    jet->SetNumberOfTracks(constituents.size());
+    jet->SetNumberOfClusters(constituents.size());
+  }
 
   for (UInt_t ic = 0; ic < constituents.size(); ++ic) {
 
@@ -546,7 +750,11 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
           ++gemc;
       }
 
-      if (fFillGhost) jet->AddGhost(constituents[ic].px(),
+      if (fFillGhost && fUseConstituentArena) {
+        fConstituentArena.AddConstituent(PWG::JETFW::AliEmcalJetConstituentArena::kGhost, -1, constituents[ic].perp(),
+            constituents[ic].eta(), constituents[ic].phi(), constituents[ic].m());
+      }
+      else if (fFillGhost) jet->AddGhost(constituents[ic].px(),
           constituents[ic].py(),
           constituents[ic].pz(),
           constituents[ic].e());
@@ -596,7 +804,11 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
         }
       }
 
-      if (flag == 0 || particlesSubName == "") {
+      if (fUseConstituentArena && (flag == 0 || particlesSubName == "")) {
+        fConstituentArena.AddConstituent(PWG::JETFW::AliEmcalJetConstituentArena::kTrack, fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, tid),
+            t->Pt(), t->Eta(), t->Phi(), t->M(), partCont->GetIsEmbedding());
+      }
+      else if (flag == 0 || particlesSubName == "") {
         jet->AddTrackAt(fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, tid), nt);
         if(fFillConstituents){
           jet->AddParticleConstituent(t, partCont->GetIsEmbedding(), fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, tid));
@@ -610,8 +822,14 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
         Int_t part_sub_id = particles_sub->GetEntriesFast();
         AliEmcalParticle* part_sub = new ((*particles_sub)[part_sub_id]) AliEmcalParticle(dynamic_cast<AliVTrack*>(t));   // SA: probably need to be fixed!!
         part_sub->SetPtEtaPhiM(constituents[ic].perp(),constituents[ic].eta(),constituents[ic].phi(),constituents[ic].m());
-        jet->AddTrackAt(fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, part_sub_id), nt);
-        if(fFillConstituents){
+        if (fUseConstituentArena) {
+          fConstituentArena.AddConstituent(PWG::JETFW::AliEmcalJetConstituentArena::kTrack, fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, part_sub_id),
+              part_sub->Pt(), part_sub->Eta(), part_sub->Phi(), part_sub->M(), partCont->GetIsEmbedding());
+        }
+        else {
+          jet->AddTrackAt(fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, part_sub_id), nt);
+        }
+        if(fFillConstituents && !fUseConstituentArena){
           jet->AddParticleConstituent(part_sub, partCont->GetIsEmbedding(), fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, part_sub_id));
         }
       }
@@ -652,7 +870,11 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
         }
       }
 
-      if (flag == 0 || particlesSubName == "") {
+      if (fUseConstituentArena && (flag == 0 || particlesSubName == "")) {
+        fConstituentArena.AddConstituent(PWG::JETFW::AliEmcalJetConstituentArena::kCluster, fClusterContainerIndexMap.GlobalIndexFromLocalIndex(clusCont, cid),
+            cPt, nP.Eta(), nP.Phi(), nP.M(), clusCont->GetIsEmbedding(), clusCont->GetDefaultClusterEnergy());
+      }
+      else if (flag == 0 || particlesSubName == "") {
         jet->AddClusterAt(fClusterContainerIndexMap.GlobalIndexFromLocalIndex(clusCont, cid), nc);
 
         if(fFillConstituents) {
@@ -668,7 +890,13 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
         Int_t part_sub_id = particles_sub->GetEntriesFast();
         AliEmcalParticle* part_sub = new ((*particles_sub)[part_sub_id]) AliEmcalParticle(c);
         part_sub->SetPtEtaPhiM(constituents[ic].perp(),constituents[ic].eta(),constituents[ic].phi(),constituents[ic].m());
-        jet->AddClusterAt(fClusterContainerIndexMap.GlobalIndexFromLocalIndex(clusCont, part_sub_id), nc);
+        if (fUseConstituentArena) {
+          fConstituentArena.AddConstituent(PWG::JETFW::AliEmcalJetConstituentArena::kCluster, fClusterContainerIndexMap.GlobalIndexFromLocalIndex(clusCont, part_sub_id),
+              part_sub->Pt(), part_sub->Eta(), part_sub->Phi(), part_sub->M(), clusCont->GetIsEmbedding(), clusCont->GetDefaultClusterEnergy());
+        }
+        else {
+          jet->AddClusterAt(fClusterContainerIndexMap.GlobalIndexFromLocalIndex(clusCont, part_sub_id), nc);
+        }
 
         if(fFillConstituents) {
           // NOTE: The ClusterConstituent constructor won't work here because we're not passing an AliVCluster.
@@ -690,8 +918,14 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
     }
   }
 
-  jet->SetNumberOfTracks(nt);
-  jet->SetNumberOfClusters(nc);
+  if (fUseConstituentArena) {
+    // the arena sorts the constituents by index
+    fConstituentArena.FinishJet(jet);
+  }
+  else {
+    jet->SetNumberOfTracks(nt);
+    jet->SetNumberOfClusters(nc);
+  }
   jet->SetNEF(neutralE / jet->E());
   jet->SetMaxChargedPt(maxCh);
   jet->SetMaxNeutralPt(maxNe);
@@ -702,7 +936,7 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
   jet->SetNumberOfNeutrals(nneutral);
   jet->SetMCPt(mcpt);
   jet->SetPtEmc(emcpt);
-  jet->SortConstituents();
+  jet->SortConstituents();     // no-op for the jets in the arena
 }
 
 /**
@@ -71,6 +71,30 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Additional jet definitions (algorithm, radius, jet type, recombination scheme) can be run on the
+ * same constituents via AddJetDefinition(). The constituents and the ghosts are then built once per
+ * event and clustered for each definition, optionally in parallel threads (SetNThreads()). Each
+ * definition fills its own jet branch, with the same name as the branch of an individual jet finder
+ * task with the same settings and containers. Charged (neutral) definitions only use the charged
+ * (neutral) constituents, so the containers of the task have to provide the widest set of constituents.
+ * The jet selection of the task (minimum pt and area, acceptance) applies to all definitions,
+ * the utilities only to the main definition.
+ *
+ * The clustering of the ghosts dominates the jet finding time in Pb-Pb collisions. With SetAreaMode()
+ * the ghost grid is built once per job and only jittered in each event, from a random stream with
+ * a fixed seed (AliFJWrapper::kGhostGridArea). In the hybrid mode (AliFJWrapper::kHybridArea) only the
+ * ghosts around the jets above SetHybridAreaPtMin() are clustered: these jets get the exact area
+ * (anti-kt), the other jets the nominal area \f$ \pi R^{2} \f$. The minimum area cut (SetMinJetArea())
+ * is then only applied to the jets with an exact area. The hybrid mode is only valid for anti-kt:
+ * the definitions with another algorithm fall back to the ghost grid mode, with a warning. The macro
+ * macros/validateFastJetArea.C measures the speedup and the area bias of these modes.
+ *
+ * With SetUseConstituentArena() the constituents (index, pt, eta, phi, mass) and the ghosts of all jets
+ * of the event are stored contiguously in a PWG::JETFW::AliEmcalJetConstituentArena owned by the task,
+ * instead of arrays allocated by each jet. The constituent accessors of AliEmcalJet are unchanged, but the
+ * jets refer to the arena of the current event: they cannot be written to an output tree as they are
+ * (AliEmcalJet::DetachFromArena() or a copy of the jet restores the self-contained jet).
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -84,6 +108,28 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   typedef fastjet::RecombinationScheme FJRecoScheme;
 #endif
 
+  /**
+   * @class AliEmcalJetDefinition
+   * @brief Additional jet definition run on the constituents of the jet finder task
+   */
+  class AliEmcalJetDefinition {
+  public:
+    AliEmcalJetDefinition();
+    AliEmcalJetDefinition(EJetType_t jetType, EJetAlgo_t jetAlgo, ERecoScheme_t recoScheme, Double_t radius, const char *tag);
+    virtual ~AliEmcalJetDefinition() {}
+
+    EJetType_t           fJetType;                ///< jet type (full, charged, neutral)
+    EJetAlgo_t           fJetAlgo;                ///< jet algorithm (kt, akt, etc)
+    ERecoScheme_t        fRecombScheme;           ///< recombination scheme used by fastjet
+    Double_t             fRadius;                 ///< jet radius
+    TString              fJetsTag;                ///< tag of jet collection (empty: tag of the task)
+
+  private:
+    /// \cond CLASSIMP
+    ClassDef(AliEmcalJetDefinition, 1);
+    /// \endcond
+  };
+
   AliEmcalJetTask();
   AliEmcalJetTask(const char *name);
   virtual ~AliEmcalJetTask();
@@ -108,6 +154,11 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   SetNThreads(Int_t n)                       { if (IsLocked()) return; fNThreads         = n     ; }
+  void                   SetAreaMode(Int_t mode)                    { if (IsLocked()) return; fAreaMode         = mode  ; }
+  void                   SetHybridAreaPtMin(Double_t pt)            { if (IsLocked()) return; fHybridAreaPtMin  = pt    ; }
+  void                   SetGhostSeed(UInt_t seed)                  { if (IsLocked()) return; fGhostSeed        = seed  ; }
+  void                   SetUseConstituentArena(Bool_t b=kTRUE)     { if (IsLocked()) return; fUseConstituentArena = b  ; }
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -116,6 +167,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetPhiRange(Double_t pmi, Double_t pma);
 
   AliEmcalJetUtility*    AddUtility(AliEmcalJetUtility* utility);
+  void                   AddJetDefinition(EJetType_t jetType, EJetAlgo_t jetAlgo, ERecoScheme_t recoScheme, Double_t radius, const char *tag = "");
 
   Double_t               GetGhostArea()                   { return fGhostArea         ; }
   const char*            GetJetsName()                    { return fJetsName.Data()   ; }
@@ -134,6 +186,10 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Int_t                  GetRecombScheme()                { return fRecombScheme      ; }
   Double_t               GetTrackEfficiency()             { return fTrackEfficiency   ; }
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
+  Int_t                  GetNJetDefinitions()       const { return fJetDefinitions.size(); }
+  Int_t                  GetNThreads()              const { return fNThreads          ; }
+  Int_t                  GetAreaMode()              const { return fAreaMode          ; }
+  Double_t               GetHybridAreaPtMin()       const { return fHybridAreaPtMin   ; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
@@ -184,6 +240,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   Int_t                  FindJets();
   void                   FillJetBranch();
+  void                   FillJetBranch(AliFJWrapper& wrapper, TClonesArray *jets, Double_t radius, Bool_t withUtilities);
+  Int_t                  RunJetDefinitions();
   void                   ExecOnce();
   void                   InitEvent();
   void                   InitUtilities();
@@ -219,6 +277,12 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   TRandom3               fRandom;                 //!<! Random number generator for artificial tracking efficiency
   Bool_t                 fLocked;                 ///< true if lock is set
   Bool_t	               fFillConstituents;		 ///< If true jet consituents will be filled to the AliEmcalJet
+  std::vector<AliEmcalJetDefinition> fJetDefinitions; ///< additional jet definitions run on the same constituents
+  Int_t                  fNThreads;               ///< number of threads used to cluster the jet definitions
+  Int_t                  fAreaMode;               ///< generation of the ghosts for the jet areas (AliFJWrapper::EAreaMode_t)
+  Double_t               fHybridAreaPtMin;        ///< hybrid area mode: minimum pt of the jets with an exact area
+  UInt_t                 fGhostSeed;              ///< seed of the ghost jitter in the ghost grid area modes
+  Bool_t                 fUseConstituentArena;    ///< store the jet constituents in an event arena instead of each jet (jets valid within the event)
 
   TString                fJetsName;               //!<!name of jet collection
   Bool_t                 fIsInit;                 //!<!=true if already initialized
@@ -237,6 +301,12 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   // Handle mapping between index and containers
   AliEmcalContainerIndexMap <AliClusterContainer, AliVCluster> fClusterContainerIndexMap;    //!<! Mapping between index and cluster containers
   AliEmcalContainerIndexMap <AliParticleContainer, AliVParticle> fParticleContainerIndexMap; //!<! Mapping between index and particle containers
+
+  std::vector<AliFJWrapper*>      fDefinitionWrappers; //!<! fastjet wrappers of the additional jet definitions
+  std::vector<TClonesArray*>      fDefinitionJets;     //!<! jet collections of the additional jet definitions
+  std::vector<Short_t>            fInputCharges;       //!<! charge of the input vectors of the main wrapper (0 for clusters)
+  std::vector<fastjet::PseudoJet> fGhosts;             //!<! ghosts shared by all jet definitions
+  PWG::JETFW::AliEmcalJetConstituentArena fConstituentArena; //!<! constituents of the jets of the event (if fUseConstituentArena)
 #endif
 
  private:
@@ -244,7 +314,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 30);
+  ClassDef(AliEmcalJetTask, 33);
   /// \endcond
 };
 #endif
@@ -18,7 +18,8 @@ AliEmcalJetUtilityConstSubtractor::AliEmcalJetUtilityConstSubtractor() :
   fJetsSub(0x0),
   fParticlesSub(0x0),
   fRhoParam(0),
-  fRhomParam(0)
+  fRhomParam(0),
+  fConstSubMode(AliFJWrapper::kContribConstSub)
 {
   // Dummy constructor.
 
@@ -38,6 +39,7 @@ AliEmcalJetUtilityConstSubtractor::AliEmcalJetUtilityConstSubtractor(const char*
   fParticlesSub(0x0),
   fRhoParam(0),
   fRhomParam(0),
+  fConstSubMode(AliFJWrapper::kContribConstSub),
   fAlpha(0),
   fMaxDelR(-1)
 {
@@ -58,6 +60,7 @@ AliEmcalJetUtilityConstSubtractor::AliEmcalJetUtilityConstSubtractor(const AliEm
   fParticlesSub(other.fParticlesSub),
   fRhoParam(other.fRhoParam),
   fRhomParam(other.fRhomParam),
+  fConstSubMode(other.fConstSubMode),
   fAlpha(0),
   fMaxDelR(-1)
 {
@@ -82,6 +85,7 @@ AliEmcalJetUtilityConstSubtractor& AliEmcalJetUtilityConstSubtractor::operator=(
   fParticlesSub = other.fParticlesSub;
   fRhoParam = other.fRhoParam;
   fRhomParam = other.fRhomParam;
+  fConstSubMode = other.fConstSubMode;
   return *this;
 }
 
@@ -136,6 +140,13 @@ void AliEmcalJetUtilityConstSubtractor::Init()
   // will be empty until after jet finding.
   fJetTask->AddParticleContainer(fParticlesSubName);
 
+  if (fConstSubMode != AliFJWrapper::kContribConstSub && !fUseExternalBkg) {
+    AliWarning(Form("%s: The native constituent subtraction needs an external background, the FastJet contrib is used", GetName()));
+  }
+  else if (fConstSubMode != AliFJWrapper::kContribConstSub && fMaxDelR <= 0) {
+    AliWarning(Form("%s: No maximum distance set with SetMaxDelR(): the native constituent subtraction pairs every particle with every ghost", GetName()));
+  }
+
   fInit = kTRUE;
 }
 
@@ -168,6 +179,7 @@ void AliEmcalJetUtilityConstSubtractor::Prepare(AliFJWrapper& fjw)
   fjw.SetUseExternalBkg(fUseExternalBkg, fRho, fRhom);
   fjw.SetAlpha(fAlpha);
   fjw.SetMaxDelR(fMaxDelR);
+  fjw.SetConstSubMode(fConstSubMode);
   fjw.DoConstituentSubtraction();
 }
 
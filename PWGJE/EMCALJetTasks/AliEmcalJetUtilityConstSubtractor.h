@@ -28,6 +28,7 @@ class AliEmcalJetUtilityConstSubtractor : public AliEmcalJetUtility
 
   void                   SetJetsSubName(const char *n)       { fJetsSubName      = n     ; }
   void                   SetParticlesSubName(const char *n)  { fParticlesSubName = n     ; }
+  void                   SetConstSubMode(Int_t m)            { fConstSubMode     = m     ; }
   void                   SetAlpha(const Double_t a)            { fAlpha            = a     ; }
   void                   SetMaxDelR(const Double_t r)          { fMaxDelR          = r     ; }
 
@@ -53,7 +54,8 @@ class AliEmcalJetUtilityConstSubtractor : public AliEmcalJetUtility
   TClonesArray          *fParticlesSub;                       //!subtracted particle collection
   AliRhoParameter       *fRhoParam;                           //!event rho
   AliRhoParameter       *fRhomParam;                          //!event rhom
+  Int_t                  fConstSubMode;                       // implementation of the subtraction (AliFJWrapper::EConstSubMode_t)
 
-  ClassDef(AliEmcalJetUtilityConstSubtractor, 2) // Emcal jet utility that implements the constituent subtractor form the fastjet contrib
+  ClassDef(AliEmcalJetUtilityConstSubtractor, 3) // Emcal jet utility that implements the constituent subtractor form the fastjet contrib
 };
 #endif
@@ -19,6 +19,7 @@ AliEmcalJetUtilityEventSubtractor::AliEmcalJetUtilityEventSubtractor() :
   fParticlesSub(0x0),
   fRhoParam(0),
   fRhomParam(0),
+  fConstSubMode(AliFJWrapper::kContribConstSub),
   fMaxDelR(0)
 {
   // Dummy constructor.
@@ -39,6 +40,7 @@ AliEmcalJetUtilityEventSubtractor::AliEmcalJetUtilityEventSubtractor(const char*
   fParticlesSub(0x0),
   fRhoParam(0),
   fRhomParam(0),
+  fConstSubMode(AliFJWrapper::kContribConstSub),
   fMaxDelR(0)
 {
   // Default constructor.
@@ -57,7 +59,8 @@ AliEmcalJetUtilityEventSubtractor::AliEmcalJetUtilityEventSubtractor(const AliEm
   fJetsSub(other.fJetsSub),
   fParticlesSub(other.fParticlesSub),
   fRhoParam(other.fRhoParam),
-  fRhomParam(other.fRhomParam)
+  fRhomParam(other.fRhomParam),
+  fConstSubMode(other.fConstSubMode)
 {
   // Copy constructor.
 }
@@ -80,6 +83,7 @@ AliEmcalJetUtilityEventSubtractor& AliEmcalJetUtilityEventSubtractor::operator=(
   fParticlesSub = other.fParticlesSub;
   fRhoParam = other.fRhoParam;
   fRhomParam = other.fRhomParam;
+  fConstSubMode = other.fConstSubMode;
   return *this;
 }
 
@@ -134,6 +138,13 @@ void AliEmcalJetUtilityEventSubtractor::Init()
   // will be empty until after jet finding.
   fJetTask->AddParticleContainer(fParticlesSubName);
 
+  if (fConstSubMode != AliFJWrapper::kContribConstSub && !fUseExternalBkg) {
+    AliWarning(Form("%s: The native constituent subtraction needs an external background, the FastJet contrib is used", GetName()));
+  }
+  else if (fConstSubMode != AliFJWrapper::kContribConstSub && fMaxDelR <= 0) {
+    AliWarning(Form("%s: No maximum distance set with SetMaxDelR(): the native constituent subtraction pairs every particle with every ghost", GetName()));
+  }
+
   fInit = kTRUE;
 }
 
@@ -154,6 +165,7 @@ void AliEmcalJetUtilityEventSubtractor::InitEvent(AliFJWrapper& fjw)
   if (fJetsSub) fJetsSub->Delete();
   fjw.SetEventSub(kTRUE);
   fjw.SetMaxDelR(fMaxDelR);
+  fjw.SetConstSubMode(fConstSubMode);
   fjw.SetUseExternalBkg(fUseExternalBkg, fRho, fRhom);
 }
 
@@ -29,6 +29,7 @@ class AliEmcalJetUtilityEventSubtractor : public AliEmcalJetUtility
 
   void                   SetJetsSubName(const char *n)       { fJetsSubName      = n     ; }
   void                   SetParticlesSubName(const char *n)  { fParticlesSubName = n     ; }
+  void                   SetConstSubMode(Int_t m)            { fConstSubMode     = m     ; }
 
   void Init();
   void InitEvent(AliFJWrapper& fjw);
@@ -51,7 +52,8 @@ class AliEmcalJetUtilityEventSubtractor : public AliEmcalJetUtility
   TClonesArray          *fParticlesSub;                       //!subtracted particle collection
   AliRhoParameter       *fRhoParam;                           //!event rho
   AliRhoParameter       *fRhomParam;                          //!event rhom
+  Int_t                  fConstSubMode;                       // implementation of the subtraction (AliFJWrapper::EConstSubMode_t)
 
-  ClassDef(AliEmcalJetUtilityEventSubtractor, 1) // Emcal jet utility that implements the constituent subtractor form the fastjet contrib
+  ClassDef(AliEmcalJetUtilityEventSubtractor, 2) // Emcal jet utility that implements the constituent subtractor form the fastjet contrib
 };
 #endif
@@ -6,6 +6,8 @@
 
 #if !defined(__CINT__)
 
+#include <random>
+
 #include "AliLog.h"
 #include "FJ_includes.h"
 #include "AliJetShape.h"
@@ -13,6 +15,20 @@
 class AliFJWrapper
 {
  public:
+  /// Generation of the ghosts for the jet areas (active area with explicit ghosts only)
+  enum EAreaMode_t {
+    kStandardArea  = 0,   ///< ghosts generated by FastJet in each event
+    kGhostGridArea = 1,   ///< ghost grid built once, with a jitter drawn from a seeded stream in each event
+    kHybridArea    = 2    ///< ghost grid, but only the ghosts around the jets above a pt threshold are clustered
+  };
+
+  /// Implementation of the constituent subtraction (jet-wise and event-wide)
+  enum EConstSubMode_t {
+    kContribConstSub = 0,   ///< ConstituentSubtractor of the FastJet contrib
+    kNativeConstSub  = 1,   ///< native implementation with (rap, phi) cells and contiguous arrays (external background only)
+    kCompareConstSub = 2    ///< both: the contrib result is kept and compared with the native one
+  };
+
   AliFJWrapper(const char *name, const char *title);
   virtual ~AliFJWrapper();
 
@@ -25,6 +41,7 @@ class AliFJWrapper
   virtual void  ClearMemory();
   virtual void  CopySettingsFrom (const AliFJWrapper& wrapper);
   virtual void  GetMedianAndSigma(Double_t& median, Double_t& sigma, Int_t remove = 0) const;
+  virtual Double_t GenerateGhosts(std::vector<fastjet::PseudoJet>& ghosts);
   fastjet::ClusterSequenceArea*           GetClusterSequence() const   { return fClustSeq;                 }
   fastjet::ClusterSequence*               GetClusterSequenceSA() const { return fClustSeqSA;               }
   fastjet::ClusterSequenceActiveAreaExplicitGhosts* GetClusterSequenceGhosts() const { return fClustSeqActGhosts; }
@@ -50,6 +67,13 @@ class AliFJWrapper
   virtual std::vector<double>             GetSubtractedJetsPts(Double_t median_pt = -1, Bool_t sorted = kFALSE);
   Bool_t                                  GetLegacyMode()            { return fLegacyMode; }
   Bool_t                                  GetDoFilterArea()          { return fDoFilterArea; }
+  Int_t                                   GetAreaMode()        const { return fAreaMode;                   }
+  Double_t                                GetHybridAreaPtMin() const { return fHybridAreaPtMin;            }
+  Int_t                                   GetConstSubMode()    const { return fConstSubMode;               }
+  Int_t                                   GetConstSubNCompared()  const { return fConstSubNCompared;       }
+  Int_t                                   GetConstSubNDifferent() const { return fConstSubNDifferent;      }
+  Double_t                                GetConstSubMaxDiff()    const { return fConstSubMaxDiff;         }
+  Bool_t                                  IsJetAreaExact     (UInt_t idx) const;
   Double_t                                NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
   Double32_t                              NSubjettinessDerivativeSub(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Double_t JetR, fastjet::PseudoJet jet, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
 #ifdef FASTJET_VERSION
@@ -143,6 +167,11 @@ class AliFJWrapper
   void SetEventSub(Bool_t b) {fEventSub = b;}
   void SetMaxDelR(Double_t r)  {fMaxDelR = r;}
   void SetAlpha(Double_t a)  {fAlpha = a;}
+  void SetSharedGhosts(const std::vector<fastjet::PseudoJet>* ghosts, Double_t ghostArea) { fSharedGhosts = ghosts; fSharedGhostArea = ghostArea; }
+  void SetAreaMode(Int_t mode)          { fAreaMode       = mode;    }
+  void SetHybridAreaPtMin(Double_t pt)  { fHybridAreaPtMin = pt;     }
+  void SetGhostSeed(UInt_t seed)        { fGhostSeed      = seed; fGhostRandom.seed(seed); }
+  void SetConstSubMode(Int_t mode)      { fConstSubMode   = mode;    }
 
 
  protected:
@@ -236,8 +265,67 @@ class AliFJWrapper
   std::vector<double>                      fGRDenominator;    //!
   std::vector<double>                      fGRNumeratorSub;   //!
   std::vector<double>                      fGRDenominatorSub; //!
+  const std::vector<fastjet::PseudoJet>   *fSharedGhosts;     //! explicit ghosts shared with other wrappers (not owned)
+  Double_t                                 fSharedGhostArea;  //! actual area of the shared ghosts
+  Int_t                                    fAreaMode;         //! generation of the ghosts (EAreaMode_t)
+  Double_t                                 fHybridAreaPtMin;  //! hybrid area mode: minimum pt of the jets with an exact area
+  UInt_t                                   fGhostSeed;        //! seed of the random stream of the ghost jitter
+  std::mt19937                             fGhostRandom;      //! random stream of the ghost jitter
+  std::vector<Double_t>                    fGhostGridRap;     //! rapidity of the ghost grid points
+  std::vector<Double_t>                    fGhostGridPhi;     //! azimuth of the ghost grid points
+  Double_t                                 fGhostGridDRap;    //! rapidity size of the ghost grid cells
+  Double_t                                 fGhostGridDPhi;    //! azimuthal size of the ghost grid cells
+  Double_t                                 fGhostGridArea;    //! actual area of the grid ghosts
+  Double_t                                 fGhostGridMaxRap;  //! maximum rapidity the ghost grid was built for
+  Double_t                                 fGhostGridReqArea; //! ghost area the ghost grid was built for
+  Bool_t                                   fGhostGridLegacy;  //! whether the ghost grid has the FastJet 2 placement
+  std::vector<fastjet::PseudoJet>          fGridGhosts;       //! jittered grid ghosts of the current event
+  std::vector<fastjet::PseudoJet>          fHybridGhosts;     //! ghosts around the hard jets of the current event
+  Bool_t                                   fHybridAreaRun;    //! whether the last Run() used the hybrid area mode
+
+  /// Particle-ghost pair of the native constituent subtraction
+  struct ConstSubPair {
+    Double_t fDist;    ///< ordering distance: deltaR^2 * pt^(2 alpha)
+    UInt_t   fPart;    ///< particle index
+    UInt_t   fGhost;   ///< ghost index
+
+    bool operator<(const ConstSubPair& other) const {
+      if (fDist != other.fDist) return fDist < other.fDist;
+      if (fPart != other.fPart) return fPart < other.fPart;
+      return fGhost < other.fGhost;
+    }
+  };
+
+  Int_t                                    fConstSubMode;        //! implementation of the constituent subtraction (EConstSubMode_t)
+  Double_t                                 fConstSubGhostArea;   //! ghost area of the native event-wide subtraction (contrib default)
+  std::vector<fastjet::PseudoJet>          fCSInput;             //! particles of the native subtraction
+  std::vector<Double_t>                    fCSPt;                //! pt of the particles, subtracted in place
+  std::vector<Double_t>                    fCSMtMinusPt;         //! mt - pt of the particles, subtracted in place
+  std::vector<Double_t>                    fCSRap;               //! rapidity of the particles
+  std::vector<Double_t>                    fCSPhi;               //! azimuth of the particles
+  std::vector<Double_t>                    fCSGhostPt;           //! pt of the ghosts (rho * area), subtracted in place
+  std::vector<Double_t>                    fCSGhostMtMinusPt;    //! mt - pt of the ghosts (rhom * area), subtracted in place
+  std::vector<Double_t>                    fCSGhostRap;          //! rapidity of the ghosts
+  std::vector<Double_t>                    fCSGhostPhi;          //! azimuth of the ghosts
+  std::vector<UInt_t>                      fCSCellStart;         //! offset of the ghosts of each (rap, phi) cell in fCSCellGhosts
+  std::vector<UInt_t>                      fCSCellGhosts;        //! ghost indices ordered by cell
+  std::vector<UInt_t>                      fCSGhostCell;         //! (rap, phi) cell of each ghost
+  std::vector<UInt_t>                      fCSCellFill;          //! next free slot of each cell while fCSCellGhosts is filled
+  std::vector<ConstSubPair>                fCSPairs;             //! particle-ghost pairs within fMaxDelR
+  std::vector<fastjet::PseudoJet>          fCSCompare;           //! native result in the comparison mode
+  Int_t                                    fConstSubNCompared;   //! comparison mode: number of compared jets / particles
+  Int_t                                    fConstSubNDifferent;  //! comparison mode: number of jets / particles with a different pt or mass
+  Double_t                                 fConstSubMaxDiff;     //! comparison mode: largest pt or mass difference
 
   virtual void   SubtractBackground(const Double_t median_pt = -1);
+  const fastjet::ClusterSequenceAreaBase*  GetAreaClusterSequence() const;
+  void           BuildGhostGrid();
+  Double_t       JitterGhostGrid(std::vector<fastjet::PseudoJet>& ghosts);
+  void           SelectHybridGhosts(const std::vector<fastjet::PseudoJet>& ghosts, std::vector<fastjet::PseudoJet>& selected);
+  fastjet::PseudoJet NativeJetConstituentSubtraction(const fastjet::PseudoJet& jet);
+  void           NativeEventConstituentSubtraction(std::vector<fastjet::PseudoJet>& subtracted);
+  void           NativeConstituentSubtraction(const std::vector<fastjet::PseudoJet>& particles, std::vector<fastjet::PseudoJet>& subtracted);
+  void           CompareConstituentSubtraction(const std::vector<fastjet::PseudoJet>& contrib, std::vector<fastjet::PseudoJet>& native, Bool_t byUserIndex);
 
  private:
   AliFJWrapper();
@@ -340,6 +428,43 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fGRDenominator()
   , fGRNumeratorSub()
   , fGRDenominatorSub()
+  , fSharedGhosts(0)
+  , fSharedGhostArea(0)
+  , fAreaMode(kStandardArea)
+  , fHybridAreaPtMin(5.)
+  , fGhostSeed(12345)
+  , fGhostRandom(12345)
+  , fGhostGridRap()
+  , fGhostGridPhi()
+  , fGhostGridDRap(0)
+  , fGhostGridDPhi(0)
+  , fGhostGridArea(0)
+  , fGhostGridMaxRap(0)
+  , fGhostGridReqArea(0)
+  , fGhostGridLegacy(kFALSE)
+  , fGridGhosts()
+  , fHybridGhosts()
+  , fHybridAreaRun(kFALSE)
+  , fConstSubMode(kContribConstSub)
+  , fConstSubGhostArea(0.01)
+  , fCSInput()
+  , fCSPt()
+  , fCSMtMinusPt()
+  , fCSRap()
+  , fCSPhi()
+  , fCSGhostPt()
+  , fCSGhostMtMinusPt()
+  , fCSGhostRap()
+  , fCSGhostPhi()
+  , fCSCellStart()
+  , fCSCellGhosts()
+  , fCSGhostCell()
+  , fCSCellFill()
+  , fCSPairs()
+  , fCSCompare()
+  , fConstSubNCompared(0)
+  , fConstSubNDifferent(0)
+  , fConstSubMaxDiff(0)
 {
   // Constructor.
 }
@@ -399,6 +524,10 @@ void AliFJWrapper::CopySettingsFrom(const AliFJWrapper& wrapper)
   fUseExternalBkg   = wrapper.fUseExternalBkg;
   fRho              = wrapper.fRho;
   fRhom             = wrapper.fRhom;
+  fAreaMode         = wrapper.fAreaMode;
+  fHybridAreaPtMin  = wrapper.fHybridAreaPtMin;
+  SetGhostSeed(wrapper.fGhostSeed);
+  fConstSubMode     = wrapper.fConstSubMode;
 }
 
 //_________________________________________________________________________________________________
@@ -514,7 +643,8 @@ Double_t AliFJWrapper::GetJetArea(UInt_t idx) const
 
   Double_t retval = -1; // really wrong area..
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->area(fInclusiveJets[idx]);
+    if (!IsJetAreaExact(idx)) return TMath::Pi() * fR * fR;
+    retval = GetAreaClusterSequence()->area(fInclusiveJets[idx]);
   } else {
     AliError(Form("[e] ::GetJetArea wrong index: %d",idx));
   }
@@ -554,7 +684,8 @@ fastjet::PseudoJet AliFJWrapper::GetJetAreaVector(UInt_t idx) const
   // Get the jet area as vector.
   fastjet::PseudoJet retval;
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->area_4vector(fInclusiveJets[idx]);
+    if (!IsJetAreaExact(idx)) return fj::PtYPhiM(TMath::Pi() * fR * fR, fInclusiveJets[idx].rap(), fInclusiveJets[idx].phi());
+    retval = GetAreaClusterSequence()->area_4vector(fInclusiveJets[idx]);
   } else {
     AliError(Form("[e] ::GetJetArea wrong index: %d",idx));
   }
@@ -621,7 +752,7 @@ AliFJWrapper::GetJetConstituents(UInt_t idx) const
   std::vector<fastjet::PseudoJet> retval;
 
   if ( idx < fInclusiveJets.size() ) {
-    retval = fClustSeq->constituents(fInclusiveJets[idx]);
+    retval = GetAreaClusterSequence()->constituents(fInclusiveJets[idx]);
   } else {
     AliError(Form("[e] ::GetJetConstituents wrong index: %d",idx));
   }
@@ -692,6 +823,119 @@ void AliFJWrapper::GetMedianAndSigma(Double_t &median, Double_t &sigma, Int_t re
   }
 }
 
+//_________________________________________________________________________________________________
+Double_t AliFJWrapper::GenerateGhosts(std::vector<fastjet::PseudoJet>& ghosts)
+{
+  // Generate the explicit ghosts that FastJet adds with the current area settings.
+  // The ghosts can be shared by several wrappers (SetSharedGhosts) running on the same event,
+  // which then do not generate their own ghosts. Returns the actual ghost area.
+  // With the ghost grid area modes the ghosts are taken from the jittered ghost grid.
+
+  if (fAreaMode != kStandardArea) return JitterGhostGrid(ghosts);
+
+  fj::GhostedAreaSpec ghostSpec(fMaxRap, 1, fGhostArea, fGridScatter, fKtScatter, fMeanGhostKt);
+#ifdef FASTJET_VERSION
+  if (fLegacyMode) ghostSpec.set_fj2_placement(kTRUE);
+#endif
+  ghosts.clear();
+  ghostSpec.add_ghosts(ghosts);
+  return ghostSpec.actual_ghost_area();
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::BuildGhostGrid()
+{
+  // Build the ghost grid once (and again only if the area settings changed): the ghosts are placed
+  // by FastJet without scatter, such that the grid is the same as the one of GhostedAreaSpec.
+
+  if (!fGhostGridRap.empty() && fGhostGridMaxRap == fMaxRap && fGhostGridReqArea == fGhostArea && fGhostGridLegacy == fLegacyMode) return;
+
+  fj::GhostedAreaSpec ghostSpec(fMaxRap, 1, fGhostArea, 0., 0., fMeanGhostKt);
+#ifdef FASTJET_VERSION
+  if (fLegacyMode) ghostSpec.set_fj2_placement(kTRUE);
+#endif
+  std::vector<fj::PseudoJet> grid;
+  ghostSpec.add_ghosts(grid);
+
+  fGhostGridRap.resize(grid.size());
+  fGhostGridPhi.resize(grid.size());
+  UInt_t nphi = 0;
+  for (UInt_t i = 0; i < grid.size(); i++) {
+    fGhostGridRap[i] = grid[i].rap();
+    fGhostGridPhi[i] = grid[i].phi();
+    if (TMath::Abs(fGhostGridRap[i] - fGhostGridRap[0]) < 1e-9) nphi++; // points in the first rapidity row
+  }
+  fGhostGridArea   = ghostSpec.actual_ghost_area();
+  fGhostGridDPhi   = nphi > 0 ? TMath::TwoPi() / nphi : 0;
+  fGhostGridDRap   = fGhostGridDPhi > 0 ? fGhostGridArea / fGhostGridDPhi : 0;
+  fGhostGridMaxRap = fMaxRap;
+  fGhostGridReqArea = fGhostArea;
+  fGhostGridLegacy = fLegacyMode;
+}
+
+//_________________________________________________________________________________________________
+Double_t AliFJWrapper::JitterGhostGrid(std::vector<fastjet::PseudoJet>& ghosts)
+{
+  // Ghosts of the event from the ghost grid: each grid point is moved within its cell and gets a
+  // transverse momentum around the mean ghost kt, as GhostedAreaSpec does with the grid and kt scatter.
+  // The random numbers come from the seeded stream of the wrapper (SetGhostSeed). Returns the actual ghost area.
+
+  BuildGhostGrid();
+
+  std::uniform_real_distribution<Double_t> uniform(-0.5, 0.5);
+  ghosts.resize(fGhostGridRap.size());
+  for (UInt_t i = 0; i < fGhostGridRap.size(); i++) {
+    Double_t phi = fGhostGridPhi[i] + fGhostGridDPhi * fGridScatter * uniform(fGhostRandom);
+    Double_t rap = fGhostGridRap[i] + fGhostGridDRap * fGridScatter * uniform(fGhostRandom);
+    Double_t pt  = fMeanGhostKt * (1 + fKtScatter * uniform(fGhostRandom));
+    ghosts[i].reset_PtYPhiM(pt, rap, phi);
+  }
+  return fGhostGridArea;
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::SelectHybridGhosts(const std::vector<fastjet::PseudoJet>& ghosts, std::vector<fastjet::PseudoJet>& selected)
+{
+  // Hybrid area mode: select the ghosts within 2R of the axis of the jets above fHybridAreaPtMin,
+  // found by a clustering of the input vectors without ghosts. With anti-kt the ghosts clustered into
+  // these jets are the same as with the full ghost grid, as long as the jet constituents are within R
+  // of the axis; the areas of the other jets are not computed.
+
+  selected.clear();
+  fj::ClusterSequence hardSeq(fInputVectors, *fJetDef);
+  std::vector<fj::PseudoJet> hardJets = hardSeq.inclusive_jets(fHybridAreaPtMin);
+  if (hardJets.empty()) return;
+
+  const Double_t maxDist2 = 4 * fR * fR;
+  for (UInt_t i = 0; i < ghosts.size(); i++) {
+    for (UInt_t ijet = 0; ijet < hardJets.size(); ijet++) {
+      if (ghosts[i].squared_distance(hardJets[ijet]) < maxDist2) {
+        selected.push_back(ghosts[i]);
+        break;
+      }
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliFJWrapper::IsJetAreaExact(UInt_t idx) const
+{
+  // In the hybrid area mode only the jets above fHybridAreaPtMin have an area computed with ghosts,
+  // the other jets get the nominal area pi R^2.
+
+  if (!fHybridAreaRun) return kTRUE;
+  return idx < fInclusiveJets.size() && fInclusiveJets[idx].perp() >= fHybridAreaPtMin;
+}
+
+//_________________________________________________________________________________________________
+const fastjet::ClusterSequenceAreaBase* AliFJWrapper::GetAreaClusterSequence() const
+{
+  // Cluster sequence of the last Run(): with shared ghosts the explicit ghost cluster sequence is used.
+
+  if (fClustSeq) return fClustSeq;
+  return fClustSeqActGhosts;
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::Run()
 {
@@ -746,8 +990,26 @@ Int_t AliFJWrapper::Run()
     fJetDef = new fj::JetDefinition(fAlgor, fR, fScheme, fStrategy);
   }
 
+  fHybridAreaRun = kFALSE;
   try {
-    fClustSeq = new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
+    if ((fSharedGhosts || fAreaMode != kStandardArea) && fAreaType == fj::active_area_explicit_ghosts && !fEventSub) {
+      // same clustering as ClusterSequenceArea with explicit ghosts, but with the ghosts provided by the caller
+      // or taken from the ghost grid
+      const std::vector<fj::PseudoJet> *ghosts = fSharedGhosts;
+      Double_t ghostArea = fSharedGhostArea;
+      if (!ghosts) {
+        ghostArea = JitterGhostGrid(fGridGhosts);
+        ghosts = &fGridGhosts;
+      }
+      if (fAreaMode == kHybridArea) {
+        SelectHybridGhosts(*ghosts, fHybridGhosts);
+        ghosts = &fHybridGhosts;
+        fHybridAreaRun = kTRUE;
+      }
+      fClustSeqActGhosts = new fj::ClusterSequenceActiveAreaExplicitGhosts(fInputVectors, *fJetDef, *ghosts, ghostArea);
+    } else {
+      fClustSeq = new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
+    }
     if(fEventSub){
       DoEventConstituentSubtraction();
       fClustSeqES = new fj::ClusterSequenceArea(fEventSubCorrectedVectors, *fJetDef, *fAreaDef);
@@ -767,7 +1029,7 @@ Int_t AliFJWrapper::Run()
   // inclusive jets:
   fInclusiveJets.clear();
   fEventSubJets.clear();
-  fInclusiveJets = fClustSeq->inclusive_jets(0.0);
+  fInclusiveJets = GetAreaClusterSequence()->inclusive_jets(0.0);
   if(fEventSub) fEventSubJets  = fClustSeqES->inclusive_jets(0.0);
 
   return 0;
@@ -1231,19 +1493,37 @@ Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_onepassca() {
 Int_t AliFJWrapper::DoConstituentSubtraction() {
   //Do constituent subtraction
 #ifdef FASTJET_VERSION
-  CreateConstituentSub();
-  // fConstituentSubtractor->set_alpha(/* double alpha */);
-  // fConstituentSubtractor->set_max_deltaR(/* double max_deltaR */);
+  // the native subtraction only supports the external background (rho, rhom)
+  const Bool_t useNative  = fConstSubMode != kContribConstSub && fUseExternalBkg;
+  const Bool_t useContrib = fConstSubMode != kNativeConstSub || !useNative;
 
   //clear constituent subtracted jets
   fConstituentSubtrJets.clear();
-  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
-    fj::PseudoJet subtracted_jet(0.,0.,0.,0.);
-    if(fInclusiveJets[i].perp()>0.)
-      subtracted_jet = (*fConstituentSubtractor)(fInclusiveJets[i]);
-    fConstituentSubtrJets.push_back(subtracted_jet);
+  if (useContrib) {
+    CreateConstituentSub();
+    // fConstituentSubtractor->set_alpha(/* double alpha */);
+    // fConstituentSubtractor->set_max_deltaR(/* double max_deltaR */);
+
+    for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
+      fj::PseudoJet subtracted_jet(0.,0.,0.,0.);
+      if(fInclusiveJets[i].perp()>0.)
+        subtracted_jet = (*fConstituentSubtractor)(fInclusiveJets[i]);
+      fConstituentSubtrJets.push_back(subtracted_jet);
+    }
+    if(fConstituentSubtractor) { delete fConstituentSubtractor; fConstituentSubtractor = NULL; }
+  }
+
+  if (useNative) {
+    std::vector<fj::PseudoJet>& nativeJets = useContrib ? fCSCompare : fConstituentSubtrJets;
+    nativeJets.clear();
+    for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
+      fj::PseudoJet subtracted_jet(0.,0.,0.,0.);
+      if(fInclusiveJets[i].perp()>0.)
+        subtracted_jet = NativeJetConstituentSubtraction(fInclusiveJets[i]);
+      nativeJets.push_back(subtracted_jet);
+    }
+    if (useContrib) CompareConstituentSubtraction(fConstituentSubtrJets, fCSCompare, kFALSE);
   }
-  if(fConstituentSubtractor) { delete fConstituentSubtractor; fConstituentSubtractor = NULL; }
 
 #endif
   return 0;
@@ -1253,15 +1533,268 @@ Int_t AliFJWrapper::DoConstituentSubtraction() {
 Int_t AliFJWrapper::DoEventConstituentSubtraction() {
   //Do constituent subtraction
 #ifdef FASTJET_VERSION
-  CreateEventConstituentSub();
-  fEventSubCorrectedVectors = fEventConstituentSubtractor->subtract_event(fEventSubInputVectors,fMaxRap); //second argument max rap?
-  //clear constituent subtracted jets
-  if(fEventConstituentSubtractor) { delete fEventConstituentSubtractor; fEventConstituentSubtractor = NULL; }
+  // the native subtraction only supports the external background (rho, rhom)
+  const Bool_t useNative  = fConstSubMode != kContribConstSub && fUseExternalBkg;
+  const Bool_t useContrib = fConstSubMode != kNativeConstSub || !useNative;
+
+  if (useContrib) {
+    CreateEventConstituentSub();
+    fEventSubCorrectedVectors = fEventConstituentSubtractor->subtract_event(fEventSubInputVectors,fMaxRap); //second argument max rap?
+    //clear constituent subtracted jets
+    if(fEventConstituentSubtractor) { delete fEventConstituentSubtractor; fEventConstituentSubtractor = NULL; }
+  }
+
+  if (useNative) {
+    if (useContrib) {
+      NativeEventConstituentSubtraction(fCSCompare);
+      CompareConstituentSubtraction(fEventSubCorrectedVectors, fCSCompare, kTRUE);
+    }
+    else {
+      NativeEventConstituentSubtraction(fEventSubCorrectedVectors);
+    }
+  }
   
 #endif
   return 0;
 }
 
+//_________________________________________________________________________________________________
+fj::PseudoJet AliFJWrapper::NativeJetConstituentSubtraction(const fj::PseudoJet& jet)
+{
+  // Native jet-wise constituent subtraction: the explicit ghosts of the jet carry
+  // rho * area and rhom * area, and are shared among the real constituents of the jet.
+
+  fCSInput.clear();
+  fCSGhostPt.clear();
+  fCSGhostMtMinusPt.clear();
+  fCSGhostRap.clear();
+  fCSGhostPhi.clear();
+
+  std::vector<fj::PseudoJet> constituents = jet.constituents();
+  for (UInt_t i = 0; i < constituents.size(); i++) {
+    if (constituents[i].is_pure_ghost()) {
+      Double_t area = constituents[i].area();
+      fCSGhostPt.push_back(fRho * area);
+      fCSGhostMtMinusPt.push_back(fRhom * area);
+      fCSGhostRap.push_back(constituents[i].rap());
+      fCSGhostPhi.push_back(constituents[i].phi());
+    }
+    else {
+      fCSInput.push_back(constituents[i]);
+    }
+  }
+  if (fCSInput.empty()) return fj::PseudoJet(0.,0.,0.,0.);
+
+  std::vector<fj::PseudoJet> subtracted;
+  NativeConstituentSubtraction(fCSInput, subtracted);
+  if (subtracted.empty()) return fj::PseudoJet(0.,0.,0.,0.);
+  return fj::join(subtracted);
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::NativeEventConstituentSubtraction(std::vector<fj::PseudoJet>& subtracted)
+{
+  // Native event-wide constituent subtraction: the ghosts are placed at the centres of a grid
+  // of cells of area fConstSubGhostArea in |rap| < fMaxRap, and the particles in the same range are subtracted.
+
+  const Double_t side = TMath::Sqrt(fConstSubGhostArea);
+  const Int_t nRap = TMath::Max(1, TMath::Nint(2 * fMaxRap / side));
+  const Int_t nPhi = TMath::Max(1, TMath::Nint(TMath::TwoPi() / side));
+  const Double_t dRap = 2 * fMaxRap / nRap;
+  const Double_t dPhi = TMath::TwoPi() / nPhi;
+  const Double_t area = dRap * dPhi;
+
+  fCSGhostPt.assign(nRap * nPhi, fRho * area);
+  fCSGhostMtMinusPt.assign(nRap * nPhi, fRhom * area);
+  fCSGhostRap.resize(nRap * nPhi);
+  fCSGhostPhi.resize(nRap * nPhi);
+  for (Int_t irap = 0; irap < nRap; irap++) {
+    for (Int_t iphi = 0; iphi < nPhi; iphi++) {
+      fCSGhostRap[irap * nPhi + iphi] = -fMaxRap + (irap + 0.5) * dRap;
+      fCSGhostPhi[irap * nPhi + iphi] = (iphi + 0.5) * dPhi;
+    }
+  }
+
+  fCSInput.clear();
+  for (UInt_t i = 0; i < fEventSubInputVectors.size(); i++) {
+    if (TMath::Abs(fEventSubInputVectors[i].rap()) <= fMaxRap) fCSInput.push_back(fEventSubInputVectors[i]);
+  }
+
+  NativeConstituentSubtraction(fCSInput, subtracted);
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::NativeConstituentSubtraction(const std::vector<fj::PseudoJet>& particles, std::vector<fj::PseudoJet>& subtracted)
+{
+  // Share the ghosts (fCSGhost*) among the particles, pairing them in increasing order of deltaR^2 * pt^(2 alpha),
+  // as the ConstituentSubtractor of the FastJet contrib. Only the pairs with deltaR <= fMaxDelR are considered
+  // (all pairs if fMaxDelR <= 0): the ghosts are binned in (rap, phi) cells of size >= fMaxDelR, and each particle
+  // is paired with the ghosts of its cell and of the neighbouring cells.
+
+  subtracted.clear();
+
+  const UInt_t nPart = particles.size();
+  const UInt_t nGhosts = fCSGhostPt.size();
+  if (nPart == 0) return;
+
+  fCSPt.resize(nPart);
+  fCSMtMinusPt.resize(nPart);
+  fCSRap.resize(nPart);
+  fCSPhi.resize(nPart);
+  Double_t rapMin = 0, rapMax = 0;
+  for (UInt_t i = 0; i < nPart; i++) {
+    fCSPt[i] = particles[i].perp();
+    fCSMtMinusPt[i] = particles[i].mt() - fCSPt[i];
+    fCSRap[i] = particles[i].rap();
+    fCSPhi[i] = particles[i].phi();
+    if (i == 0 || fCSRap[i] < rapMin) rapMin = fCSRap[i];
+    if (i == 0 || fCSRap[i] > rapMax) rapMax = fCSRap[i];
+  }
+  for (UInt_t j = 0; j < nGhosts; j++) {
+    if (fCSGhostRap[j] < rapMin) rapMin = fCSGhostRap[j];
+    if (fCSGhostRap[j] > rapMax) rapMax = fCSGhostRap[j];
+  }
+
+  // cells of the ghosts
+  const Bool_t useCells = fMaxDelR > 0;
+  Int_t nCellRap = 1, nCellPhi = 1;
+  if (useCells) {
+    nCellRap = TMath::Max(1, Int_t((rapMax - rapMin) / fMaxDelR));
+    nCellPhi = TMath::Max(1, Int_t(TMath::TwoPi() / fMaxDelR));
+  }
+  const Double_t cellRap = (rapMax - rapMin) / nCellRap;
+  const Double_t cellPhi = TMath::TwoPi() / nCellPhi;
+  const Int_t nCells = nCellRap * nCellPhi;
+
+  fCSGhostCell.resize(nGhosts);
+  fCSCellStart.assign(nCells + 1, 0);
+  for (UInt_t j = 0; j < nGhosts; j++) {
+    Int_t irap = cellRap > 0 ? TMath::Min(nCellRap - 1, Int_t((fCSGhostRap[j] - rapMin) / cellRap)) : 0;
+    Int_t iphi = TMath::Min(nCellPhi - 1, Int_t(fCSGhostPhi[j] / cellPhi));
+    fCSGhostCell[j] = irap * nCellPhi + iphi;
+    fCSCellStart[fCSGhostCell[j] + 1]++;
+  }
+  for (Int_t icell = 0; icell < nCells; icell++) fCSCellStart[icell + 1] += fCSCellStart[icell];
+  fCSCellGhosts.resize(nGhosts);
+  fCSCellFill.assign(fCSCellStart.begin(), fCSCellStart.end() - 1);
+  for (UInt_t j = 0; j < nGhosts; j++) fCSCellGhosts[fCSCellFill[fCSGhostCell[j]]++] = j;
+
+  // particle-ghost pairs within fMaxDelR
+  const Double_t maxDelR2 = fMaxDelR * fMaxDelR;
+  const Double_t alphaTimesTwo = 2 * fAlpha;
+  const Int_t nPhiNeighbours = TMath::Min(nCellPhi, 3);
+  fCSPairs.clear();
+  for (UInt_t i = 0; i < nPart; i++) {
+    const Double_t ptFactor = TMath::Abs(alphaTimesTwo) > 1e-5 ? TMath::Power(fCSPt[i], alphaTimesTwo) : 1.;
+    const Int_t irap = cellRap > 0 ? TMath::Min(nCellRap - 1, Int_t((fCSRap[i] - rapMin) / cellRap)) : 0;
+    const Int_t iphi = TMath::Min(nCellPhi - 1, Int_t(fCSPhi[i] / cellPhi));
+    for (Int_t jrap = TMath::Max(0, irap - 1); jrap <= TMath::Min(nCellRap - 1, irap + 1); jrap++) {
+      for (Int_t k = 0; k < nPhiNeighbours; k++) {
+        const Int_t jphi = (iphi + k - (nPhiNeighbours == 3 ? 1 : 0) + nCellPhi) % nCellPhi;
+        const Int_t jcell = jrap * nCellPhi + jphi;
+        for (UInt_t ig = fCSCellStart[jcell]; ig < fCSCellStart[jcell + 1]; ig++) {
+          const UInt_t j = fCSCellGhosts[ig];
+          const Double_t drap = fCSRap[i] - fCSGhostRap[j];
+          Double_t dphi = TMath::Abs(fCSPhi[i] - fCSGhostPhi[j]);
+          if (dphi > TMath::Pi()) dphi = TMath::TwoPi() - dphi;
+          const Double_t dr2 = drap * drap + dphi * dphi;
+          if (useCells && dr2 > maxDelR2) continue;
+          ConstSubPair pair = {dr2 * ptFactor, i, j};
+          fCSPairs.push_back(pair);
+        }
+      }
+    }
+  }
+  std::sort(fCSPairs.begin(), fCSPairs.end());
+
+  // share the ghosts, closest pairs first
+  for (UInt_t ipair = 0; ipair < fCSPairs.size(); ipair++) {
+    const UInt_t i = fCSPairs[ipair].fPart;
+    const UInt_t j = fCSPairs[ipair].fGhost;
+    if (fCSGhostPt[j] > 0 && fCSPt[i] > 0) {
+      if (fCSPt[i] >= fCSGhostPt[j]) {
+        fCSPt[i] -= fCSGhostPt[j];
+        fCSGhostPt[j] = 0;
+      }
+      else {
+        fCSGhostPt[j] -= fCSPt[i];
+        fCSPt[i] = 0;
+      }
+    }
+    if (fCSGhostMtMinusPt[j] > 0 && fCSMtMinusPt[i] > 0) {
+      if (fCSMtMinusPt[i] >= fCSGhostMtMinusPt[j]) {
+        fCSMtMinusPt[i] -= fCSGhostMtMinusPt[j];
+        fCSGhostMtMinusPt[j] = 0;
+      }
+      else {
+        fCSGhostMtMinusPt[j] -= fCSMtMinusPt[i];
+        fCSMtMinusPt[i] = 0;
+      }
+    }
+  }
+
+  for (UInt_t i = 0; i < nPart; i++) {
+    if (fCSPt[i] <= 0) continue;
+    const Double_t mt = fCSPt[i] + fCSMtMinusPt[i];
+    const Double_t m = TMath::Sqrt(TMath::Max(0., mt * mt - fCSPt[i] * fCSPt[i]));
+    fj::PseudoJet part = fj::PtYPhiM(fCSPt[i], fCSRap[i], fCSPhi[i], m);
+    part.set_user_index(particles[i].user_index());
+    subtracted.push_back(part);
+  }
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::CompareConstituentSubtraction(const std::vector<fj::PseudoJet>& contrib, std::vector<fj::PseudoJet>& native, Bool_t byUserIndex)
+{
+  // Comparison mode: count the jets (same order) or particles (matched by user index)
+  // of the native subtraction whose pt or mass differ from the contrib result.
+
+  const Double_t tolerance = 1e-6;
+  Int_t nDifferent = 0;
+  Double_t maxDiff = 0;
+
+  std::vector<fj::PseudoJet> reference(contrib);
+  if (byUserIndex) {
+    std::sort(reference.begin(), reference.end(), [](const fj::PseudoJet& a, const fj::PseudoJet& b) { return a.user_index() < b.user_index(); });
+    std::sort(native.begin(), native.end(), [](const fj::PseudoJet& a, const fj::PseudoJet& b) { return a.user_index() < b.user_index(); });
+  }
+
+  UInt_t i = 0, j = 0;
+  while (i < reference.size() || j < native.size()) {
+    if (j >= native.size() || (byUserIndex && i < reference.size() && reference[i].user_index() < native[j].user_index())) {
+      // missing in the native result
+      maxDiff = TMath::Max(maxDiff, reference[i].perp());
+      nDifferent++;
+      i++;
+      continue;
+    }
+    if (i >= reference.size() || (byUserIndex && native[j].user_index() < reference[i].user_index())) {
+      // missing in the contrib result
+      maxDiff = TMath::Max(maxDiff, native[j].perp());
+      nDifferent++;
+      j++;
+      continue;
+    }
+    Double_t diff = TMath::Max(TMath::Abs(reference[i].perp() - native[j].perp()), TMath::Abs(reference[i].m() - native[j].m()));
+    maxDiff = TMath::Max(maxDiff, diff);
+    if (diff > tolerance * TMath::Max(1., reference[i].perp())) nDifferent++;
+    i++;
+    j++;
+  }
+
+  fConstSubNCompared += TMath::Max(reference.size(), native.size());
+  fConstSubNDifferent += nDifferent;
+  fConstSubMaxDiff = TMath::Max(fConstSubMaxDiff, maxDiff);
+
+  if (nDifferent > 0) {
+    AliInfo(Form("Native constituent subtraction: %d of %d %s differ from the contrib (largest difference %g GeV)",
+        nDifferent, Int_t(TMath::Max(reference.size(), native.size())), byUserIndex ? "particles" : "jets", maxDiff));
+  }
+  else {
+    AliDebug(1, Form("Native constituent subtraction: %d %s agree with the contrib", Int_t(reference.size()), byUserIndex ? "particles" : "jets"));
+  }
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoSoftDrop() {
   //Do grooming
@@ -19,6 +19,8 @@
 
 #include "AliJetResponseMaker.h"
 
+#include <algorithm>
+
 #include <TClonesArray.h>
 #include <TH2F.h>
 #include <THnSparse.h>
@@ -46,6 +48,7 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fGeoPreMatchMaxDist(0),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -59,6 +62,9 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fPtgAxis(0),
   fDBCAxis(0),
   fJetRelativeEPAngle(0),
+  fSharedPtMaps1(),
+  fSharedPtMaps2(),
+  fGeoPreMatcher(),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
@@ -135,6 +141,7 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fGeoPreMatchMaxDist(0),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -148,6 +155,9 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fPtgAxis(0),
   fDBCAxis(0),
   fJetRelativeEPAngle(0),
+  fSharedPtMaps1(),
+  fSharedPtMaps2(),
+  fGeoPreMatcher(),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
@@ -1367,6 +1377,11 @@ void AliJetResponseMaker::ExecOnce()
 Bool_t AliJetResponseMaker::Run()
 {
   // Find the closest jets
+
+  // The constituent maps are valid only within the event
+  fSharedPtMaps1.clear();
+  fSharedPtMaps2.clear();
+
   if (fMatching == kNoMatching) 
     return kTRUE;
   else
@@ -1426,8 +1441,22 @@ void AliJetResponseMaker::DoJetLoop()
   AliEmcalJet* jet1 = 0;
   AliEmcalJet* jet2 = 0;
 
+  std::vector<AliEmcalJet*> accJets2;
   jets2->ResetCurrentID();
-  while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
+  while ((jet2 = jets2->GetNextJet())) {
+    jet2->ResetMatching();
+    accJets2.push_back(jet2);
+  }
+
+  // With the geometrical pre-matching, only the jet pairs closer than fGeoPreMatchMaxDist
+  // (kd-tree search of the matcher, including the pairs across phi = 0) are tested.
+  const Bool_t preMatch = fGeoPreMatchMaxDist > 0 && !accJets2.empty();
+  if (preMatch) {
+    fGeoPreMatcher.Clear();
+    fGeoPreMatcher.SetCriterion(PWG::JETFW::AliEmcalJetMatcher::kAllWithinDistance);
+    fGeoPreMatcher.SetMaxDistance(fGeoPreMatchMaxDist);
+    for (UInt_t i = 0; i < accJets2.size(); i++) fGeoPreMatcher.AddJet(1, accJets2[i]);
+  }
 
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
@@ -1435,11 +1464,21 @@ void AliJetResponseMaker::DoJetLoop()
 
     if (jet1->MCPt() < fMinJetMCPt) continue;
 
-    jets2->ResetCurrentID();
-    while ((jet2 = jets2->GetNextJet())) {
-      SetMatchingLevel(jet1, jet2, fMatching);
-    } // jet2 loop
+    if (!preMatch) {
+      for (UInt_t i = 0; i < accJets2.size(); i++) SetMatchingLevel(jet1, accJets2[i], fMatching);
+      continue;
+    }
+
+    fGeoPreMatcher.AddJet(0, jet1);
   } // jet1 loop
+
+  if (!preMatch) return;
+
+  // the pairs are ordered by jet 1 and jet 2 index, as in the jet loops, so that ties are resolved as without the pre-matching
+  fGeoPreMatcher.Match();
+  for (const auto &match : fGeoPreMatcher.GetMatches()) {
+    SetMatchingLevel(fGeoPreMatcher.GetJet(0, match.fIndex1), accJets2[match.fIndex2], fMatching);
+  }
 }
 
 //________________________________________________________________________
@@ -1456,41 +1495,176 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
 
   if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
 
-  // tracks1 just serves as a proxy to ensure that tracks are in jets1
+  // The constituents of jet1 are keyed by the index of their MC particle in the particle container of jets2,
+  // and the constituents of jet2 by their index: the common particles are found with a merge of the two sorted maps
+  const JetSharedPtMap &map1 = GetSharedPtMap(jet1, kMCLabel, 1);
+  const JetSharedPtMap &map2 = GetSharedPtMap(jet2, kMCLabel, 2);
+
+  // d1 and d2 represent the matching level: 0 = maximum level of matching, 1 = the two jets are completely unrelated
+  // the total pt of the reconstructed jet is cleaned from the constituents that are not MC particles (label == 0)
+  Double_t totalPt1 = jet1->Pt() - map1.fNonMCPt;
+  d1 = totalPt1;
+  d2 = jet2->Pt();
+
+  Double_t shared1 = 0;
+  Double_t shared2 = 0;
+  MergeSharedPt(map1.fTracks, map2.fTracks, shared1, shared2);
+  d1 -= shared1;
+  d2 -= shared2;
+
+  if (d1 < 0)
+    d1 = 0;
+
+  if (d2 < 0)
+    d2 = 0;
+
+  if (totalPt1 < 1)
+    d1 = -1;
+  else
+    d1 /= totalPt1;
+
+  if (jet2->Pt() < 1)
+    d2 = -1;
+  else
+    d2 /= jet2->Pt();
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const
+{ 
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
+
+  // All of the containers are simply used as proxies for whether tracks or clusters are in a jet
   AliParticleContainer *tracks1   = jets1->GetParticleContainer();
-  // tracks2 is used to retrieve MC labels associated with tracks in the container
-  // NOTE: For multiple containers, this would need to be generalized!
+  AliClusterContainer  *clusters1 = jets1->GetClusterContainer();
   AliParticleContainer *tracks2   = jets2->GetParticleContainer();
+  AliClusterContainer  *clusters2 = jets2->GetClusterContainer();
+
+  const JetSharedPtMap &map1 = GetSharedPtMap(jet1, kSameCollections, 1);
+  const JetSharedPtMap &map2 = GetSharedPtMap(jet2, kSameCollections, 2);
 
   // d1 and d2 represent the matching level: 0 = maximum level of matching, 1 = the two jets are completely unrelated
   d1 = jet1->Pt();
   d2 = jet2->Pt();
-  Double_t totalPt1 = d1; // the total pt of the reconstructed jet will be cleaned from the background
-
-  // remove completely tracks that are not MC particles (label == 0)
-  if (tracks1 && tracks1->GetArray()) {
-    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
-      AliVParticle *track = jet1->Track(iTrack);
-      if (!track) {
-        AliWarning(Form("Could not find track %d!", iTrack));
-        continue;
-      }
 
-      Int_t MClabel = TMath::Abs(track->GetLabel());
-      MClabel -= fMCLabelShift;
-      if (MClabel != 0) continue;
+  Double_t shared1 = 0;
+  Double_t shared2 = 0;
+
+  if (tracks1 && tracks2) {
+    MergeSharedPt(map1.fTracks, map2.fTracks, shared1, shared2);
+  }
+
+  if (clusters1 && clusters2) {
+    if (fUseCellsToMatch && fCaloCells) {
+      // Note: this section of the code needs to be revised and tested heavily
+      // While fixing some inconsistencies in AliAnalysisTaskEMCALClusterizeFast
+      // some issues came up, e.g. memory leaks (fixed) and inconsistent use of
+      // fCaloCells. In principle the two cluster collections may use cells
+      // from different sources (embedding / non-embedding). This is not handled
+      // correctly in the current version of this code.
+      AliWarning("ATTENTION ATTENTION ATTENTION: this section of the AliJetResponseMaker code needs to be revised and tested before using it for physics!!!");
+    }
+    MergeSharedPt(map1.fClusters, map2.fClusters, shared1, shared2);
+  }
 
+  d1 -= shared1;
+  d2 -= shared2;
+
+  if (d1 < 0)
+    d1 = 0;
+
+  if (d2 < 0)
+    d2 = 0;
+
+  if (jet1->Pt() > 0)
+    d1 /= jet1->Pt();
+  else
+    d1 = -1;
+
+  if (jet2->Pt() > 0)
+    d2 /= jet2->Pt();
+  else
+    d2 = -1;
+}
+
+//________________________________________________________________________
+const AliJetResponseMaker::JetSharedPtMap &AliJetResponseMaker::GetSharedPtMap(AliEmcalJet *jet, MatchingType matching, Int_t set) const
+{
+  // Return the constituent map of a jet of the collection set (1 or 2) for the matching type,
+  // building it the first time it is requested in the event.
+
+  std::unordered_map<const AliEmcalJet*, JetSharedPtMap> &maps = set == 1 ? fSharedPtMaps1 : fSharedPtMaps2;
+
+  auto it = maps.find(jet);
+  if (it != maps.end() && it->second.fType == matching) return it->second;
+
+  JetSharedPtMap &map = maps[jet];
+  map = JetSharedPtMap();
+  map.fType = matching;
+
+  if (matching == kMCLabel) {
+    if (set == 1) FillDetectorLevelSharedPtMap(jet, map);
+    else FillParticleLevelSharedPtMap(jet, map);
+  }
+  else {
+    FillSameCollectionsSharedPtMap(jet, set, map);
+  }
+
+  return map;
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::FillDetectorLevelSharedPtMap(AliEmcalJet *jet, JetSharedPtMap &map) const
+{
+  // Fill the map of a detector level jet for the MC label matching: all the constituents are keyed
+  // by the index of their MC particle in the particle container of jets2. The weight is the fraction
+  // of the MC particle pt shared with the jet: the cell fraction of the first constituent found
+  // (tracks come first), as in the original constituent loops.
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  // tracks1 just serves as a proxy to ensure that tracks are in jets1
+  AliParticleContainer *tracks1   = jets1->GetParticleContainer();
+  // tracks2 is used to retrieve MC labels associated with tracks in the container
+  // NOTE: For multiple containers, this would need to be generalized!
+  AliParticleContainer *tracks2   = jets2->GetParticleContainer();
+
+  std::vector<SharedPtEntry> &entries = map.fTracks;
+
+  for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) {
+    AliVParticle *track = jet->Track(iTrack);
+    if (!track) {
+      AliWarning(Form("Could not find track %d!", iTrack));
+      continue;
+    }
+
+    Int_t MClabel = TMath::Abs(track->GetLabel());
+    MClabel -= fMCLabelShift;
+    if (MClabel == 0) {
       // this is not a MC particle; remove it completely
       AliDebug(3,Form("Track %d (pT = %f) is not a MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
-      totalPt1 -= track->Pt();
-      d1 -= track->Pt();
+      if (tracks1 && tracks1->GetArray()) map.fNonMCPt += track->Pt();
+      continue;
     }
+    if (MClabel < 0 || !tracks2) continue;
+
+    Int_t index = tracks2->GetIndexFromLabel(MClabel);
+    if (index < 0) {
+      AliDebug(2,Form("Track %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+      continue;
+    }
+
+    SharedPtEntry entry = {index, track->Pt(), 1.};
+    entries.push_back(entry);
   }
 
-  // remove completely clusters that are not MC particles (label == 0)
-  if (fUseCellsToMatch && fCaloCells) { 
-    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-      AliVCluster *clus = jet1->Cluster(iClus);
+  if (fUseCellsToMatch && fCaloCells) { // if the cell colection is available, look for cells with a matched MC particle
+    for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) {
+      AliVCluster *clus = jet->Cluster(iClus);
       if (!clus) {
         AliWarning(Form("Could not find cluster %d!", iClus));
         continue;
@@ -1504,18 +1678,28 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
 
         Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
         MClabel -= fMCLabelShift;
-        if (MClabel != 0) continue;
+        if (MClabel == 0) {
+          // this is not a MC particle; remove it completely
+          AliDebug(3,Form("Cell %d (frac = %f) is not a MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
+          map.fNonMCPt += part.Pt() * cellFrac;
+          continue;
+        }
+        if (MClabel < 0 || !tracks2) continue;
 
-        // this is not a MC particle; remove it completely
-        AliDebug(3,Form("Cell %d (frac = %f) is not a MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
-        totalPt1 -= part.Pt() * cellFrac;
-        d1 -= part.Pt() * cellFrac;
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
+        if (index < 0) {
+          AliDebug(3,Form("Cell %d (frac = %f) does not have an associated MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
+          continue;
+        }
+
+        SharedPtEntry entry = {index, part.Pt() * cellFrac, cellFrac};
+        entries.push_back(entry);
       }
     }
   }
-  else {
-    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-      AliVCluster *clus = jet1->Cluster(iClus);
+  else { //otherwise look for the first contributor to the cluster
+    for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) {
+      AliVCluster *clus = jet->Cluster(iClus);
       if (!clus) {
         AliWarning(Form("Could not find cluster %d!", iClus));
         continue;
@@ -1525,344 +1709,156 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
 
       Int_t MClabel = TMath::Abs(clus->GetLabel());
       MClabel -= fMCLabelShift;
-      if (MClabel != 0) continue;
-
-      // this is not a MC particle; remove it completely
-      AliDebug(3,Form("Cluster %d (pT = %f) is not a MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
-      totalPt1 -= part.Pt();
-      d1 -= part.Pt();
-    }
-  }
-
-  for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
-    Bool_t track2Found = kFALSE;
-    Int_t index2 = jet2->TrackAt(iTrack2);
-
-    // now look for common particles in the track array
-    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
-      AliVParticle *track = jet1->Track(iTrack);
-      if (!track) {
-        AliWarning(Form("Could not find track %d!", iTrack));
+      if (MClabel == 0) {
+        // this is not a MC particle; remove it completely
+        AliDebug(3,Form("Cluster %d (pT = %f) is not a MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
+        map.fNonMCPt += part.Pt();
         continue;
       }
-      Int_t MClabel = TMath::Abs(track->GetLabel());
-      MClabel -= fMCLabelShift;	  
-      if (MClabel <= 0) continue;
+      if (MClabel < 0 || !tracks2) continue;
 
-      Int_t index = -1;
-      index = tracks2->GetIndexFromLabel(MClabel);
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
       if (index < 0) {
-        AliDebug(2,Form("Track %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+        AliDebug(3,Form("Cluster %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
         continue;
       }
 
-      if (index2 != index) continue;
-
-      // found common particle
-      d1 -= track->Pt();
-
-      if (!track2Found) {
-        AliVParticle *MCpart = jet2->Track(iTrack2);
-        AliDebug(3,Form("Track %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-            iTrack,track->Pt(),track->Eta(),track->Phi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-        d2 -= MCpart->Pt();
-      }
-
-      track2Found = kTRUE;
+      SharedPtEntry entry = {index, part.Pt(), 1.};
+      entries.push_back(entry);
     }
+  }
 
-    // now look for common particles in the cluster array
-    if (fUseCellsToMatch && fCaloCells) { // if the cell colection is available, look for cells with a matched MC particle
-      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-        AliVCluster *clus = jet1->Cluster(iClus);
-        if (!clus) {
-          AliWarning(Form("Could not find cluster %d!", iClus));
-          continue;
-        }
-        AliTLorentzVector part;
-        clus->GetMomentum(part, fVertex);
-
-        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
-          Int_t cellId = clus->GetCellAbsId(iCell);
-          Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
-
-          Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
-          MClabel -= fMCLabelShift;
-          if (MClabel <= 0) continue;
-
-          Int_t index1 = -1;
-          index1 = tracks2->GetIndexFromLabel(MClabel);
-          if (index1 < 0) {
-            AliDebug(3,Form("Cell %d (frac = %f) does not have an associated MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
-            continue;
-          }
-
-          if (index2 != index1) continue;
-
-          // found common particle
-          d1 -= part.Pt() * cellFrac;
-
-          if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-            AliVParticle *MCpart = jet2->Track(iTrack2);
-            AliDebug(3,Form("Cell %d belonging to cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-                iCell,iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-            d2 -= MCpart->Pt() * cellFrac;
-          }
-
-          track2Found = kTRUE;
-        }
-      }
-    }
-    else { //otherwise look for the first contributor to the cluster, and if matched to a MC label remove it
-      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-        AliVCluster *clus = jet1->Cluster(iClus);
-        if (!clus) {
-          AliWarning(Form("Could not find cluster %d!", iClus));
-          continue;
-        }
-        AliTLorentzVector part;
-        clus->GetMomentum(part, fVertex);
-
-        Int_t MClabel = TMath::Abs(clus->GetLabel());
-        MClabel -= fMCLabelShift;
-        if (MClabel <= 0) continue;
-
-        Int_t index = -1;
-        index = tracks2->GetIndexFromLabel(MClabel);
-
-        if (index < 0) {
-          AliDebug(3,Form("Cluster %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
-          continue;
-        }
-
-        if (index2 != index) continue;
-
-        // found common particle
-        d1 -= part.Pt();
-
-        if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-          AliVParticle *MCpart = jet2->Track(iTrack2);
-          AliDebug(3,Form("Cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-              iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
+  SortSharedPt(entries, kFALSE);
+}
 
-          d2 -= MCpart->Pt();
-        }
+//________________________________________________________________________
+void AliJetResponseMaker::FillParticleLevelSharedPtMap(AliEmcalJet *jet, JetSharedPtMap &map) const
+{
+  // Fill the map of a particle level jet for the MC label matching: the MC particles are keyed by their index.
 
-        track2Found = kTRUE;
-      }
+  for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) {
+    AliVParticle *MCpart = jet->Track(iTrack);
+    if (!MCpart) {
+      AliWarning(Form("Could not find track %d!", jet->TrackAt(iTrack)));
+      continue;
     }
+    SharedPtEntry entry = {jet->TrackAt(iTrack), MCpart->Pt(), 1.};
+    map.fTracks.push_back(entry);
   }
 
-  if (d1 < 0)
-    d1 = 0;
-
-  if (d2 < 0)
-    d2 = 0;
-
-  if (totalPt1 < 1)
-    d1 = -1;
-  else
-    d1 /= totalPt1;
-
-  if (jet2->Pt() < 1)
-    d2 = -1;
-  else
-    d2 /= jet2->Pt();
+  SortSharedPt(map.fTracks, kFALSE);
 }
 
 //________________________________________________________________________
-void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const
-{ 
-  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
-  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
-
-  if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
-
-  // All of the containers are simply used as proxies for whether tracks or clusters are in a jet
-  AliParticleContainer *tracks1   = jets1->GetParticleContainer();
-  AliClusterContainer  *clusters1 = jets1->GetClusterContainer();
-  AliParticleContainer *tracks2   = jets2->GetParticleContainer();
-  AliClusterContainer  *clusters2 = jets2->GetClusterContainer();
+void AliJetResponseMaker::FillSameCollectionsSharedPtMap(AliEmcalJet *jet, Int_t set, JetSharedPtMap &map) const
+{
+  // Fill the map of a jet for the same collections matching: tracks and clusters are keyed by their global index.
+  // If the cells are used, the clusters are replaced by their cells: the pt of a cell is summed over the clusters
+  // of the jet sharing it, and the weight is the number of such clusters.
+
+  AliJetContainer *jets = static_cast<AliJetContainer*>(fJetCollArray.At(set - 1));
+  AliClusterContainer *clusters = jets->GetClusterContainer();
+
+  for (Int_t iTrack = 0; iTrack < jet->GetNumberOfTracks(); iTrack++) {
+    Int_t index = jet->TrackAt(iTrack);
+    AliVParticle *part = jet->Track(iTrack);
+    if (!part) {
+      AliWarning(Form("Could not find track %d!", index));
+      continue;
+    }
+    SharedPtEntry entry = {index, part->Pt(), 1.};
+    map.fTracks.push_back(entry);
+  }
+  SortSharedPt(map.fTracks, kFALSE);
 
-  // d1 and d2 represent the matching level: 0 = maximum level of matching, 1 = the two jets are completely unrelated
-  d1 = jet1->Pt();
-  d2 = jet2->Pt();
+  if (fUseCellsToMatch && fCaloCells) {
+    if (!clusters) return;
 
-  if (tracks1 && tracks2) {
+    const Int_t maxNcells = 11520;
+    for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) {
+      Int_t index = jet->ClusterAt(iClus);
+      AliVCluster *clus = clusters->GetCluster(index);
+      if (!clus) {
+        AliWarning(Form("Could not find cluster %d!", index));
+        continue;
+      }
+      Int_t ncells = clus->GetNCells();
+      if (ncells >= maxNcells) {
+        AliError(Form("Number of cells in the cluster %d >= %d",ncells,maxNcells));
+        continue;
+      }
+      TLorentzVector part;
+      clus->GetMomentum(part, fVertex);
 
-    for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
-      Int_t index2 = jet2->TrackAt(iTrack2);
-      for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) {
-        Int_t index1 = jet1->TrackAt(iTrack1);
-        if (index2 == index1) { // found common particle
-          AliVParticle *part1 = jet1->Track(iTrack1);
-          if (!part1) {
-            AliWarning(Form("Could not find track %d!", index1));
-            continue;
-          }
-          AliVParticle *part2 = jet2->Track(iTrack2);
-          if (!part2) {
-            AliWarning(Form("Could not find track %d!", index2));
-            continue;
-          }
-
-          d1 -= part1->Pt();
-          d2 -= part2->Pt();
-          break;
-        }
+      for (Int_t iCell = 0; iCell < ncells; iCell++) {
+        Int_t cellId = clus->GetCellAbsId(iCell);
+        Double_t cellClusFrac = fCaloCells->GetCellAmplitude(cellId) / clus->E();
+        SharedPtEntry entry = {cellId, clus->GetCellAmplitudeFraction(iCell) * cellClusFrac * part.Pt(), 1.};
+        map.fClusters.push_back(entry);
       }
     }
-
+    SortSharedPt(map.fClusters, kTRUE);
   }
-
-  if (clusters1 && clusters2) {
-
-    if (fUseCellsToMatch && fCaloCells) {
-      // Note: this section of the code needs to be revised and tested heavily
-      // While fixing some inconsistencies in AliAnalysisTaskEMCALClusterizeFast
-      // some issues came up, e.g. memory leaks (fixed) and inconsistent use of
-      // fCaloCells. In principle the two cluster collections may use cells
-      // from different sources (embedding / non-embedding). This is not handled
-      // correctly in the current version of this code.
-      AliWarning("ATTENTION ATTENTION ATTENTION: this section of the AliJetResponseMaker code needs to be revised and tested before using it for physics!!!");
-      const Int_t nClus1 = jet1->GetNumberOfClusters();
-
-      Int_t ncells1[nClus1];
-      UShort_t *cellsId1[nClus1];
-      Double_t *cellsFrac1[nClus1];
-      Double_t *cellsClusFrac1[nClus1];
-      Int_t *sortedIndexes1[nClus1];
-      Double_t ptClus1[nClus1];
-      for (Int_t iClus1 = 0; iClus1 < nClus1; iClus1++) {
-        Int_t index1 = jet1->ClusterAt(iClus1);
-        AliVCluster *clus1 = clusters1->GetCluster(index1);
-        if (!clus1) {
-          AliWarning(Form("Could not find cluster %d!", index1));
-          ncells1[iClus1] = 0;
-          cellsId1[iClus1] = 0;
-          cellsFrac1[iClus1] = 0;
-          cellsClusFrac1[iClus1] = 0;
-          sortedIndexes1[iClus1] = 0;
-          ptClus1[iClus1] = 0;
-          continue;
-        }
-        TLorentzVector part1;
-        clus1->GetMomentum(part1, fVertex);
-
-        ncells1[iClus1] = clus1->GetNCells();
-        cellsId1[iClus1] = clus1->GetCellsAbsId();
-        cellsFrac1[iClus1] = clus1->GetCellsAmplitudeFraction();
-        cellsClusFrac1[iClus1] = new Double_t[ncells1[iClus1]];
-        sortedIndexes1[iClus1] = new Int_t[ncells1[iClus1]];
-        ptClus1[iClus1] = part1.Pt();
-
-        for (Int_t iCell = 0; iCell < ncells1[iClus1]; iCell++) {
-          cellsClusFrac1[iClus1][iCell] = fCaloCells->GetCellAmplitude(cellsId1[iClus1][iCell]) / clus1->E();
-        }
-
-        TMath::Sort(ncells1[iClus1], cellsId1[iClus1], sortedIndexes1[iClus1], kFALSE);
+  else {
+    for (Int_t iClus = 0; iClus < jet->GetNumberOfClusters(); iClus++) {
+      Int_t index = jet->ClusterAt(iClus);
+      AliVCluster *clus = jet->Cluster(iClus);
+      if (!clus) {
+        AliWarning(Form("Could not find cluster %d!", index));
+        continue;
       }
+      TLorentzVector part;
+      clus->GetMomentum(part, fVertex);
 
-      const Int_t nClus2 = jet2->GetNumberOfClusters();
+      SharedPtEntry entry = {index, part.Pt(), 1.};
+      map.fClusters.push_back(entry);
+    }
+    SortSharedPt(map.fClusters, kFALSE);
+  }
+}
 
-      const Int_t maxNcells2 = 11520;
-      Int_t sortedIndexes2[maxNcells2];
-      for (Int_t iClus2 = 0; iClus2 < nClus2; iClus2++) {
-        Int_t index2 = jet2->ClusterAt(iClus2);
-        AliVCluster *clus2 =  clusters2->GetCluster(index2);
-        if (!clus2) {
-          AliWarning(Form("Could not find cluster %d!", index2));
-          continue;
-        }
-        Int_t ncells2 = clus2->GetNCells();
-        if (ncells2 >= maxNcells2) {
-          AliError(Form("Number of cells in the cluster %d >= %d",ncells2,maxNcells2));
-          continue;
-        }
-        UShort_t *cellsId2 = clus2->GetCellsAbsId();
-        Double_t *cellsFrac2 = clus2->GetCellsAmplitudeFraction();
-        Double_t *cellsClusFrac2 = new Double_t[ncells2];
+//________________________________________________________________________
+void AliJetResponseMaker::SortSharedPt(std::vector<SharedPtEntry> &entries, Bool_t sumWeights)
+{
+  // Sort the entries by key and merge the entries with the same key: the pt are summed,
+  // the weights are summed if sumWeights is true, otherwise the weight of the first entry is kept.
 
-        for (Int_t iCell = 0; iCell < ncells2; iCell++) {
-          cellsClusFrac2[iCell] = fCaloCells->GetCellAmplitude(cellsId2[iCell]) / clus2->E();
-        }
+  std::stable_sort(entries.begin(), entries.end());
 
-        TLorentzVector part2;
-        clus2->GetMomentum(part2, fVertex);
-        Double_t ptClus2 = part2.Pt();
-
-        TMath::Sort(ncells2, cellsId2, sortedIndexes2, kFALSE);
-
-        for (Int_t iClus1 = 0; iClus1 < nClus1; iClus1++) {
-          if (sortedIndexes1[iClus1] == 0)
-            continue;
-          Int_t iCell1 = 0, iCell2 = 0;
-          while (iCell1 < ncells1[iClus1] && iCell2 < ncells2) {
-            if (cellsId1[iClus1][sortedIndexes1[iClus1][iCell1]] == cellsId2[sortedIndexes2[iCell2]]) { // found a common cell
-              d1 -= cellsFrac1[iClus1][sortedIndexes1[iClus1][iCell1]] * cellsClusFrac1[iClus1][sortedIndexes1[iClus1][iCell1]] * ptClus1[iClus1];
-              d2 -= cellsFrac2[sortedIndexes2[iCell2]] * cellsClusFrac2[sortedIndexes2[iCell2]] * ptClus2;
-              iCell1++;
-              iCell2++;
-            }
-            else if (cellsId1[iClus1][sortedIndexes1[iClus1][iCell1]] > cellsId2[sortedIndexes2[iCell2]]) {
-              iCell2++;
-            }
-            else {
-              iCell1++;
-            }
-          }
-        }
-        delete[] cellsClusFrac2;
-      }
-      for (Int_t iClus1 = 0; iClus1 < nClus1; iClus1++) {
-        delete[] cellsClusFrac1[iClus1];
-        delete[] sortedIndexes1[iClus1];
-      }
+  UInt_t n = 0;
+  for (UInt_t i = 0; i < entries.size(); i++) {
+    if (n > 0 && entries[n-1].fKey == entries[i].fKey) {
+      entries[n-1].fPt += entries[i].fPt;
+      if (sumWeights) entries[n-1].fWeight += entries[i].fWeight;
     }
     else {
-      for (Int_t iClus2 = 0; iClus2 < jet2->GetNumberOfClusters(); iClus2++) {
-        Int_t index2 = jet2->ClusterAt(iClus2);
-        for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) {
-          Int_t index1 = jet1->ClusterAt(iClus1);
-          if (index2 == index1) { // found common particle
-            AliVCluster *clus1 = jet1->Cluster(iClus1);
-            if (!clus1) {
-              AliWarning(Form("Could not find cluster %d!", index1));
-              continue;
-            }
-            AliVCluster *clus2 =  jet2->Cluster(iClus2);
-            if (!clus2) {
-              AliWarning(Form("Could not find cluster %d!", index2));
-              continue;
-            }
-            TLorentzVector part1, part2;
-            clus1->GetMomentum(part1, fVertex);
-            clus2->GetMomentum(part2, fVertex);
-
-            d1 -= part1.Pt();
-            d2 -= part2.Pt();
-            break;
-          }
-        }
-      }
+      entries[n++] = entries[i];
     }
   }
+  entries.resize(n);
+}
 
-  if (d1 < 0)
-    d1 = 0;
-
-  if (d2 < 0)
-    d2 = 0;
-
-  if (jet1->Pt() > 0)
-    d1 /= jet1->Pt();
-  else
-    d1 = -1;
+//________________________________________________________________________
+void AliJetResponseMaker::MergeSharedPt(const std::vector<SharedPtEntry> &entries1, const std::vector<SharedPtEntry> &entries2, Double_t &shared1, Double_t &shared2)
+{
+  // Add the pt shared by two sorted maps: for each common key, the pt of one jet is weighted by the entry of the other jet.
 
-  if (jet2->Pt() > 0)
-    d2 /= jet2->Pt();
-  else
-    d2 = -1;
+  std::vector<SharedPtEntry>::const_iterator it1 = entries1.begin();
+  std::vector<SharedPtEntry>::const_iterator it2 = entries2.begin();
+  while (it1 != entries1.end() && it2 != entries2.end()) {
+    if (it1->fKey < it2->fKey) {
+      ++it1;
+    }
+    else if (it2->fKey < it1->fKey) {
+      ++it2;
+    }
+    else { // found a common constituent
+      shared1 += it1->fPt * it2->fWeight;
+      shared2 += it2->fPt * it1->fWeight;
+      ++it1;
+      ++it2;
+    }
+  }
 }
 
 //________________________________________________________________________
@@ -24,7 +24,11 @@ class TH2;
 class THnSparse;
 class AliNamedArrayI;
 
+#include <unordered_map>
+#include <vector>
+
 #include "AliEmcalJet.h"
+#include "AliEmcalJetMatcher.h"
 #include "AliAnalysisTaskEmcalJet.h"
 #include "AliEmcalEmbeddingQA.h"
 
@@ -46,6 +50,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        SetMatching(MatchingType t, Double_t p1=1, Double_t p2=1)       { fMatching = t; fMatchingPar1 = p1; fMatchingPar2 = p2; }
   void                        SetPtHardBin(Int_t b)                                           { fSelectPtHardBin   = b         ; }
   void                        SetUseCellsToMatch(Bool_t i)                                    { fUseCellsToMatch   = i         ; }
+  void                        SetGeometricalPreMatching(Double_t d)                           { fGeoPreMatchMaxDist = d        ; }
   void                        SetMinJetMCPt(Float_t pt)                                       { fMinJetMCPt        = pt        ; }
   void                        SetHistoType(Int_t b)                                           { fHistoType         = b         ; }
   void                        SetDeltaPtAxis(Int_t b)                                         { fDeltaPtAxis       = b         ; }
@@ -91,6 +96,25 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
       const Double_t    maxTrackPt         = 100);
 
  protected:
+  /// Constituent of a jet shared with the jets of the other collection, identified by its key
+  struct SharedPtEntry {
+    Int_t                     fKey;                                    ///< track/cluster global index, MC particle index or cell ID
+    Double_t                  fPt;                                     ///< pt of the constituents with this key
+    Double_t                  fWeight;                                 ///< weight of the pt of the other jet (cells: number of clusters; MC label: fraction of the MC particle)
+
+    bool operator<(const SharedPtEntry &other) const { return fKey < other.fKey; }
+  };
+
+  /// Constituents of a jet sorted by key, built once per event for the matching levels
+  struct JetSharedPtMap {
+    JetSharedPtMap() : fType(kNoMatching), fTracks(), fClusters(), fNonMCPt(0) {}
+
+    MatchingType                fType;                                 ///< matching type the map was built for
+    std::vector<SharedPtEntry>  fTracks;                               ///< tracks, or all constituents by MC particle index (MC label matching)
+    std::vector<SharedPtEntry>  fClusters;                             ///< clusters or cells
+    Double_t                    fNonMCPt;                              ///< pt of the constituents that are not MC particles (MC label matching)
+  };
+
   void                        ExecOnce();
   void                        DoJetLoop();
   Bool_t                      FillHistograms();
@@ -100,6 +124,12 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const;
   void                        GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
   void                        GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
+  const JetSharedPtMap       &GetSharedPtMap(AliEmcalJet *jet, MatchingType matching, Int_t set) const;
+  void                        FillDetectorLevelSharedPtMap(AliEmcalJet *jet, JetSharedPtMap &map) const;
+  void                        FillParticleLevelSharedPtMap(AliEmcalJet *jet, JetSharedPtMap &map) const;
+  void                        FillSameCollectionsSharedPtMap(AliEmcalJet *jet, Int_t set, JetSharedPtMap &map) const;
+  static void                 SortSharedPt(std::vector<SharedPtEntry> &entries, Bool_t sumWeights);
+  static void                 MergeSharedPt(const std::vector<SharedPtEntry> &entries1, const std::vector<SharedPtEntry> &entries2, Double_t &shared1, Double_t &shared2);
   void                        FillMatchingHistos(AliEmcalJet* jet1, AliEmcalJet* jet2, Double_t d, Double_t CE1, Double_t CE2);
   void                        FillJetHisto(AliEmcalJet* jet, Int_t Set);
   void                        AllocateTH2();
@@ -111,6 +141,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Double_t                    fMatchingPar2;                           // matching parameter for jet2-jet1 matching
   Bool_t                      fUseCellsToMatch;                        // use cells instead of clusters to match jets (slower but sometimes needed)
   Double_t                    fMinJetMCPt;                             // minimum jet MC pt
+  Double_t                    fGeoPreMatchMaxDist;                     ///< if > 0, only the jet pairs closer than this distance (kd-tree search) are tested in the matching
   AliEmcalEmbeddingQA         fEmbeddingQA;                            //!<! Embedding QA hists (will only be added if embedding)
   Int_t                       fHistoType;                              // histogram type (0=TH2, 1=THnSparse)
   Int_t                       fDeltaPtAxis;                            // add delta pt axis in THnSparse (default=0)
@@ -125,6 +156,10 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Int_t                       fDBCAxis;                                // add DBC (number of soft dropped branches) axis in matching THnSparse (default=0)
   Int_t                       fJetRelativeEPAngle;                     ///< add jet angle relative to the EP in matching THnSparse (default=0)
 
+  mutable std::unordered_map<const AliEmcalJet*, JetSharedPtMap> fSharedPtMaps1; //!<! constituent maps of the jets 1 in the current event
+  mutable std::unordered_map<const AliEmcalJet*, JetSharedPtMap> fSharedPtMaps2; //!<! constituent maps of the jets 2 in the current event
+  PWG::JETFW::AliEmcalJetMatcher fGeoPreMatcher;                     //!<! kd-tree search of the jet pairs of the geometrical pre-matching
+
   Bool_t                      fIsJet1Rho;                              //!whether the jet1 collection has to be average subtracted
   Bool_t                      fIsJet2Rho;                              //!whether the jet2 collection has to be average subtracted
 
@@ -204,6 +239,6 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
@@ -0,0 +1,336 @@
+//
+// Per-event cache of the background density shared by the rho tasks
+//
+
+#include "AliJetRhoEngine.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <TClonesArray.h>
+#include <TLorentzVector.h>
+#include <TMath.h>
+#include <TTree.h>
+
+#include <AliAnalysisManager.h>
+#include <AliVCluster.h>
+#include <AliVParticle.h>
+
+#include "AliAnalysisTaskRhoMass.h"
+#include "AliEmcalJet.h"
+
+/**
+ * Compare two background selections.
+ * @param other selection to compare to
+ * @return true if the selections are identical
+ */
+bool AliJetRhoEngine::Selection::operator==(const Selection &other) const
+{
+  return fJets == other.fJets && TMath::Min(fNExclLeadJets, 2u) == TMath::Min(other.fNExclLeadJets, 2u) &&
+      fAccepted == other.fAccepted && fSignalJets == other.fSignalJets;
+}
+
+/**
+ * Compare two sets of mass settings.
+ * @param other settings to compare to
+ * @return true if all settings are identical
+ */
+bool AliJetRhoEngine::MassSettings::operator==(const MassSettings &other) const
+{
+  return fMassType == other.fMassType && fPionMassClusters == other.fPionMassClusters && fTracks == other.fTracks && fClusters == other.fClusters &&
+      fVertex[0] == other.fVertex[0] && fVertex[1] == other.fVertex[1] && fVertex[2] == other.fVertex[2];
+}
+
+/**
+ * Constructor: empty background.
+ */
+AliJetRhoEngine::Background::Background() :
+  fMassJets(),
+  fMassSettings(),
+  fMassResults()
+{
+  for (Int_t i = 0; i < kNJetSelections; i++) {
+    fRho[i] = 0;
+    fRhoDone[i] = kFALSE;
+  }
+  for (Int_t i = 0; i < kNAreaSums; i++) {
+    fAreaPhysical[i] = 0;
+    fAreaTotal[i] = 0;
+  }
+}
+
+/**
+ * Constructor: empty cache.
+ */
+AliJetRhoEngine::AliJetRhoEngine() :
+  fSelections(),
+  fBackgrounds(),
+  fEntry(-1),
+  fTree(0),
+  fNPasses(0),
+  fNCacheHits(0)
+{
+}
+
+/**
+ * Access to the cache shared by all tasks.
+ * @return the cache
+ */
+AliJetRhoEngine &AliJetRhoEngine::Instance()
+{
+  static AliJetRhoEngine instance;
+  return instance;
+}
+
+/**
+ * Remove all cached backgrounds.
+ */
+void AliJetRhoEngine::Reset()
+{
+  fSelections.clear();
+  fBackgrounds.clear();
+}
+
+/**
+ * Clear the cache if the analysis manager moved to another event.
+ */
+void AliJetRhoEngine::CheckEvent()
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr) return;
+  Long64_t entry = mgr->GetCurrentEntry();
+  const TTree *tree = mgr->GetTree();
+  if (entry != fEntry || tree != fTree) {
+    Reset();
+    fEntry = entry;
+    fTree = tree;
+  }
+}
+
+/**
+ * Get the background quantities of a selection, computing them if they are not in the cache.
+ * @param selection background selection
+ * @return background quantities
+ */
+AliJetRhoEngine::Background &AliJetRhoEngine::GetBackground(const Selection &selection)
+{
+  CheckEvent();
+  for (UInt_t i = 0; i < fSelections.size(); i++) {
+    if (fSelections[i] == selection) {
+      fNCacheHits++;
+      return fBackgrounds[i];
+    }
+  }
+  fSelections.push_back(selection);
+  fBackgrounds.push_back(Background());
+  Fill(selection, fBackgrounds.back());
+  fNPasses++;
+  return fBackgrounds.back();
+}
+
+/**
+ * Fill the background quantities of a selection in one pass over the jets.
+ * @param selection background selection
+ * @param background background quantities to fill
+ */
+void AliJetRhoEngine::Fill(const Selection &selection, Background &background)
+{
+  if (!selection.fJets) return;
+  const Int_t njets = TMath::Min<Int_t>(selection.fAccepted.size(), selection.fJets->GetEntriesFast());
+
+  // Leading accepted jets
+  Int_t maxJetIds[]   = {-1, -1};
+  Float_t maxJetPts[] = { 0,  0};
+  if (selection.fNExclLeadJets > 0) {
+    for (Int_t ij = 0; ij < njets; ++ij) {
+      if (!selection.fAccepted[ij]) continue;
+      const AliEmcalJet *jet = static_cast<const AliEmcalJet*>(selection.fJets->At(ij));
+      if (!jet) continue;
+      if (jet->Pt() > maxJetPts[0]) {
+        maxJetPts[1] = maxJetPts[0];
+        maxJetIds[1] = maxJetIds[0];
+        maxJetPts[0] = jet->Pt();
+        maxJetIds[0] = ij;
+      }
+      else if (jet->Pt() > maxJetPts[1]) {
+        maxJetPts[1] = jet->Pt();
+        maxJetIds[1] = ij;
+      }
+    }
+    if (selection.fNExclLeadJets < 2) maxJetIds[1] = -1;
+  }
+
+  // Tracks of the signal jets, such that the overlap is tested once per track
+  std::unordered_set<Int_t> signalTracks;
+  for (auto signalJet : selection.fSignalJets) {
+    for (Int_t i = 0; i < signalJet->GetNumberOfTracks(); i++) signalTracks.insert(signalJet->TrackAt(i));
+  }
+
+  for (Int_t ij = 0; ij < njets; ++ij) {
+    const AliEmcalJet *jet = static_cast<const AliEmcalJet*>(selection.fJets->At(ij));
+    if (!jet) continue;
+
+    const Double_t area = jet->Area();
+    const Bool_t withTracks = jet->GetNumberOfTracks() > 0;
+    background.fAreaTotal[kAreaAllJets] += area;
+    if (withTracks) background.fAreaPhysical[kAreaAllJets] += area;
+
+    if (!selection.fAccepted[ij]) continue;
+
+    const Bool_t nonGhost = !jet->IsGhost();
+    background.fAreaTotal[kAreaAcceptedJets] += area;
+    if (nonGhost) background.fAreaPhysical[kAreaAcceptedJets] += area;
+
+    if (ij == maxJetIds[0] || ij == maxJetIds[1]) continue;
+
+    if (!signalTracks.empty()) {
+      Bool_t overlapping = kFALSE;
+      for (Int_t i = 0; i < jet->GetNumberOfTracks() && !overlapping; i++) overlapping = signalTracks.count(jet->TrackAt(i)) > 0;
+      if (overlapping) continue;
+    }
+
+    background.fAreaTotal[kAreaSelectedJets] += area;
+    if (withTracks) background.fAreaPhysical[kAreaSelectedJets] += area;
+
+    const Double_t rho = jet->Pt() / area;
+    background.fRhoValues[kAllJets].push_back(rho);
+    if (withTracks) background.fRhoValues[kJetsWithTracks].push_back(rho);
+    if (nonGhost) background.fRhoValues[kNonGhostJets].push_back(rho);
+    if (area > 0) background.fMassJets.push_back(jet);
+  }
+}
+
+/**
+ * Get \f$ \rho \f$, the median of \f$ p_{T}/A \f$ of the selected jets.
+ * @param selection background selection
+ * @param jetSelection jets entering the median
+ * @param nJets number of jets entering the median (if not null)
+ * @return \f$ \rho \f$, 0 if there are no jets
+ */
+Double_t AliJetRhoEngine::GetRho(const Selection &selection, EJetSelection_t jetSelection, Int_t *nJets)
+{
+  Background &background = GetBackground(selection);
+  if (!background.fRhoDone[jetSelection]) {
+    background.fRho[jetSelection] = Median(background.fRhoValues[jetSelection]);
+    background.fRhoDone[jetSelection] = kTRUE;
+  }
+  if (nJets) *nJets = background.fRhoValues[jetSelection].size();
+  return background.fRho[jetSelection];
+}
+
+/**
+ * Get the areas of the occupancy correction.
+ * @param selection background selection
+ * @param areaSum jets summed in the areas
+ * @param physical area of the physical jets
+ * @param total area of all jets
+ */
+void AliJetRhoEngine::GetAreas(const Selection &selection, EAreaSum_t areaSum, Double_t &physical, Double_t &total)
+{
+  const Background &background = GetBackground(selection);
+  physical = background.fAreaPhysical[areaSum];
+  total = background.fAreaTotal[areaSum];
+}
+
+/**
+ * Get \f$ \rho_{m} \f$, the median of \f$ m_{\delta}/A \f$ of the selected jets with area > 0.
+ * @param selection background selection
+ * @param settings settings of the \f$ m_{\delta} \f$ calculation
+ * @return \f$ \rho_{m} \f$ and the mean energy and mass of the jets
+ */
+const AliJetRhoEngine::MassResult &AliJetRhoEngine::GetRhoMass(const Selection &selection, const MassSettings &settings)
+{
+  Background &background = GetBackground(selection);
+  for (UInt_t i = 0; i < background.fMassSettings.size(); i++) {
+    if (background.fMassSettings[i] == settings) return background.fMassResults[i];
+  }
+
+  MassResult result;
+  if (!background.fMassJets.empty()) {
+    Double_t sumE = 0;
+    Double_t sumM = 0;
+    for (auto jet : background.fMassJets) {
+      result.fMdArea.push_back(GetMd(jet, settings) / jet->Area());
+      sumE += jet->E();
+      sumM += jet->M();
+    }
+    result.fMeanE = sumE / background.fMassJets.size();
+    result.fMeanM = sumM / background.fMassJets.size();
+    result.fRhoMass = Median(result.fMdArea);
+  }
+
+  background.fMassSettings.push_back(settings);
+  background.fMassResults.push_back(result);
+  return background.fMassResults.back();
+}
+
+/**
+ * Median with partial sorting. For an even number of values the two central values are averaged, as in TMath::Median().
+ * @param values values, reordered on return
+ * @return median, 0 if there are no values
+ */
+Double_t AliJetRhoEngine::Median(std::vector<Double_t> &values)
+{
+  if (values.empty()) return 0;
+  auto middle = values.begin() + values.size() / 2;
+  std::nth_element(values.begin(), middle, values.end());
+  Double_t median = *middle;
+  if (values.size() % 2 == 0) median = 0.5 * (median + *std::max_element(values.begin(), middle));
+  return median;
+}
+
+/**
+ * Get \f$ m_{\delta} \f$ as defined in http://arxiv.org/pdf/1211.2811.pdf
+ * @param jet jet for which \f$ m_{\delta} \f$ is calculated
+ * @param settings settings of the calculation
+ * @return \f$ m_{\delta} \f$
+ */
+Double_t AliJetRhoEngine::GetMd(const AliEmcalJet *jet, const MassSettings &settings)
+{
+  Double_t sum = 0.;
+  Double_t px = 0.;
+  Double_t py = 0.;
+  Double_t pz = 0.;
+  Double_t E = 0.;
+
+  if (settings.fTracks) {
+    for (Int_t icc = 0; icc < jet->GetNumberOfTracks(); icc++) {
+      AliVParticle *vp = static_cast<AliVParticle*>(jet->TrackAt(icc, const_cast<TClonesArray*>(settings.fTracks)));
+      if (!vp) continue;
+      if (settings.fMassType == AliAnalysisTaskRhoMass::kMd) sum += TMath::Sqrt(vp->M()*vp->M() + vp->Pt()*vp->Pt()) - vp->Pt(); //sqrt(E^2-P^2+pt^2)=sqrt(E^2-pz^2)
+      else if (settings.fMassType == AliAnalysisTaskRhoMass::kMdP) sum += TMath::Sqrt(vp->M()*vp->M() + vp->P()*vp->P()) - vp->P();
+      else if (settings.fMassType == AliAnalysisTaskRhoMass::kMd4) {
+        px += vp->Px();
+        py += vp->Py();
+        pz += vp->Pz();
+        E += vp->E();
+      }
+    }
+  }
+
+  if (settings.fClusters) {
+    for (Int_t icc = 0; icc < jet->GetNumberOfClusters(); icc++) {
+      AliVCluster *vp = static_cast<AliVCluster*>(jet->ClusterAt(icc, const_cast<TClonesArray*>(settings.fClusters)));
+      if (!vp) continue;
+      TLorentzVector nPart;
+      vp->GetMomentum(nPart, const_cast<Double_t*>(settings.fVertex));
+      Double_t m = 0.;
+      if (settings.fPionMassClusters) m = 0.13957;
+      if (settings.fMassType == AliAnalysisTaskRhoMass::kMd) sum += TMath::Sqrt(m*m + nPart.Pt()*nPart.Pt()) - nPart.Pt();
+      else if (settings.fMassType == AliAnalysisTaskRhoMass::kMdP) sum += TMath::Sqrt(nPart.M()*nPart.M() + nPart.P()*nPart.P()) - nPart.P();
+      else if (settings.fMassType == AliAnalysisTaskRhoMass::kMd4) {
+        px += nPart.Px();
+        py += nPart.Py();
+        pz += nPart.Pz();
+        E += nPart.E();
+      }
+    }
+  }
+
+  if (settings.fMassType == AliAnalysisTaskRhoMass::kMd4) {
+    Double_t pt = TMath::Sqrt(px*px + py*py);
+    Double_t m2 = E*E - pt*pt - pz*pz;
+    sum = TMath::Sqrt(m2 + pt*pt) - pt;
+  }
+  return sum;
+}
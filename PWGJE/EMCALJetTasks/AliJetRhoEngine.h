@@ -0,0 +1,145 @@
+#ifndef ALIJETRHOENGINE_H
+#define ALIJETRHOENGINE_H
+
+#include <vector>
+
+#include <Rtypes.h>
+
+class TClonesArray;
+class TTree;
+class AliEmcalJet;
+
+/**
+ * @class AliJetRhoEngine
+ * @ingroup PWGJEBASE
+ * @brief Per-event cache of the background density shared by the rho tasks
+ *
+ * AliAnalysisTaskRho, AliAnalysisTaskRhoSparse, AliAnalysisTaskRhoMass and AliAnalysisTaskRhoDev
+ * often run on the same kt jets in the same event, and each of them searched the leading jets,
+ * tested the overlap with the signal jets and took the median of the jet densities on its own.
+ * The engine does this in a single pass over the jets for each background selection (jet array,
+ * accepted jets, number of excluded leading jets and signal jets) and keeps the result for the
+ * other tasks of the event:
+ *  - \f$ \rho \f$, the median of \f$ p_{T}/A \f$ of the selected jets (accepted, not leading,
+ *    not overlapping with a signal jet), for all jets, jets with tracks or non-ghost jets
+ *  - the physical and total jet areas from which the occupancy correction of the sparse
+ *    systems is calculated (https://arxiv.org/abs/1207.2392)
+ *  - \f$ \rho_{m} \f$, the median of \f$ m_{\delta}/A \f$ of the selected jets, for each set of
+ *    mass settings (computed on first request)
+ *
+ * Two jets overlap if they share a track (index in the track array). The medians are computed
+ * with partial sorting and average the two central values for an even number of jets, as
+ * TMath::Median().
+ *
+ * The cache is shared by all tasks (Instance()) and is cleared automatically when the analysis
+ * manager moves to the next entry. Tasks keep publishing their own AliRhoParameter objects.
+ *
+ * ~~~{.cxx}
+ * AliJetRhoEngine::Selection selection;
+ * selection.fJets = fJets;
+ * selection.fAccepted = accepted;     // acceptance of each jet of fJets
+ * selection.fNExclLeadJets = 2;
+ * Double_t rho = AliJetRhoEngine::Instance().GetRho(selection, AliJetRhoEngine::kAllJets);
+ * ~~~
+ *
+ * @date Oct 2026
+ */
+class AliJetRhoEngine {
+ public:
+  /// Jets entering the median of \f$ p_{T}/A \f$, among the selected jets
+  enum EJetSelection_t {
+    kAllJets          = 0,   ///< all selected jets
+    kJetsWithTracks   = 1,   ///< selected jets with at least one track
+    kNonGhostJets     = 2,   ///< selected jets with at least one track or cluster
+    kNJetSelections   = 3
+  };
+
+  /// Jets summed in the areas of the occupancy correction
+  enum EAreaSum_t {
+    kAreaAllJets      = 0,   ///< all jets of the array; physical area: jets with tracks
+    kAreaSelectedJets = 1,   ///< selected jets; physical area: jets with tracks
+    kAreaAcceptedJets = 2,   ///< accepted jets, including the leading and overlapping ones; physical area: non-ghost jets
+    kNAreaSums        = 3
+  };
+
+  /// Background jets: jet array, acceptance and excluded jets
+  struct Selection {
+    Selection() : fJets(0), fAccepted(), fNExclLeadJets(0), fSignalJets() {}
+    bool operator==(const Selection &other) const;
+
+    const TClonesArray              *fJets;           ///< background jets
+    std::vector<Bool_t>              fAccepted;       ///< acceptance of each jet of the array
+    UInt_t                           fNExclLeadJets;  ///< number of leading accepted jets to exclude (at most 2)
+    std::vector<const AliEmcalJet*>  fSignalJets;     ///< jets overlapping with these signal jets are excluded
+  };
+
+  /// Settings of the \f$ m_{\delta} \f$ calculation (see AliAnalysisTaskRhoMass)
+  struct MassSettings {
+    MassSettings() : fMassType(0), fPionMassClusters(kFALSE), fTracks(0), fClusters(0) { fVertex[0] = fVertex[1] = fVertex[2] = 0; }
+    bool operator==(const MassSettings &other) const;
+
+    Int_t                            fMassType;          ///< AliAnalysisTaskRhoMass::JetRhoMassType
+    Bool_t                           fPionMassClusters;  ///< assume the pion mass for the clusters
+    const TClonesArray              *fTracks;            ///< tracks of the jet constituents
+    const TClonesArray              *fClusters;          ///< clusters of the jet constituents
+    Double_t                         fVertex[3];         ///< event vertex, for the cluster momenta
+  };
+
+  /// \f$ \rho_{m} \f$ of a background selection
+  struct MassResult {
+    MassResult() : fRhoMass(0), fMeanE(0), fMeanM(0), fMdArea() {}
+
+    Double_t                         fRhoMass;        ///< median of \f$ m_{\delta}/A \f$
+    Double_t                         fMeanE;          ///< mean energy of the jets
+    Double_t                         fMeanM;          ///< mean mass of the jets
+    std::vector<Double_t>            fMdArea;         ///< \f$ m_{\delta}/A \f$ of the selected jets with area > 0 (not ordered)
+  };
+
+  static AliJetRhoEngine &Instance();
+
+  Double_t          GetRho(const Selection &selection, EJetSelection_t jetSelection, Int_t *nJets = 0);
+  void              GetAreas(const Selection &selection, EAreaSum_t areaSum, Double_t &physical, Double_t &total);
+  const MassResult &GetRhoMass(const Selection &selection, const MassSettings &settings);
+  void              Reset();
+
+  ULong64_t         GetNPasses()                    const { return fNPasses; }
+  ULong64_t         GetNCacheHits()                 const { return fNCacheHits; }
+
+  static Double_t   Median(std::vector<Double_t> &values);
+  static Double_t   GetMd(const AliEmcalJet *jet, const MassSettings &settings);
+
+ protected:
+  /// Background quantities of a selection, filled in one pass over the jets
+  struct Background {
+    Background();
+
+    std::vector<Double_t>            fRhoValues[kNJetSelections];     ///< \f$ p_{T}/A \f$ of the selected jets
+    Double_t                         fRho[kNJetSelections];           ///< median of fRhoValues
+    Bool_t                           fRhoDone[kNJetSelections];       ///< whether the median was computed
+    Double_t                         fAreaPhysical[kNAreaSums];       ///< area of the physical jets
+    Double_t                         fAreaTotal[kNAreaSums];          ///< area of all jets
+    std::vector<const AliEmcalJet*>  fMassJets;                       ///< selected jets with area > 0
+    std::vector<MassSettings>        fMassSettings;                   ///< settings of the computed \f$ \rho_{m} \f$
+    std::vector<MassResult>          fMassResults;                    ///< computed \f$ \rho_{m} \f$ for each settings
+  };
+
+  AliJetRhoEngine();
+  virtual ~AliJetRhoEngine() {}
+
+  void              CheckEvent();
+  Background       &GetBackground(const Selection &selection);
+  static void       Fill(const Selection &selection, Background &background);
+
+  std::vector<Selection>   fSelections;     ///< background selections of the event
+  std::vector<Background>  fBackgrounds;    ///< background quantities for each selection
+  Long64_t                 fEntry;          ///< analysis manager entry of the cached event
+  const TTree             *fTree;           ///< analysis manager tree of the cached event
+  ULong64_t                fNPasses;        ///< number of passes over the jets
+  ULong64_t                fNCacheHits;     ///< number of requests served from the cache
+
+ private:
+  AliJetRhoEngine(const AliJetRhoEngine &);            // not implemented
+  AliJetRhoEngine &operator=(const AliJetRhoEngine &); // not implemented
+};
+
+#endif
@@ -262,6 +262,8 @@
 #pragma link C++ class AliEmcalJetUtilityEventSubtractor+;
 #pragma link C++ class AliEmcalJetUtilitySoftDrop+;
 #pragma link C++ class AliEmcalJetTask+;
+#pragma link C++ class AliEmcalJetTask::AliEmcalJetDefinition+;
+#pragma link C++ class std::vector<AliEmcalJetTask::AliEmcalJetDefinition>+;
 #pragma link C++ class AliEmcalJetFinder+;
 #pragma link C++ class AliJetEmbeddingFromAODTask+;
 #pragma link C++ class AliJetEmbeddingFromPYTHIATask+;